@@ -0,0 +1,578 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+#include <reflect/ReflectionStats.hpp>
+#include <reflect/ShaderCode.hpp>
+#include <reflect/ShaderReflection.hpp>
+#include <reflect/ShaderReflectionCache.hpp>
+#include "SpirvBuilder.hpp"
+
+#if defined(__unix__) && !defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define NBL_REFLECT_BENCH_EVICT
+#endif
+
+using nbl::test::SpirvBuilder;
+
+/**
+ * nblReflectBench [--shaders N] [--stages-per-pipeline N] [--sets N] [--bindings N] [--push-constant-members N]
+ *                 [--vertex-inputs N] [--iterations N] [--fast-scan] [--corpus <dir>] [--json <file>] [--trace <file>]
+ * Generates a synthetic SPIR-V corpus into the corpus directory and benchmarks file loading, reflection,
+ * merging and startup of whole pipeline sets, results are printed as a table and optionally written as JSON.
+ * Cold startups evict the corpus from the page cache before each sample, where posix_fadvise is unavailable they are
+ * reported as startup/warm instead.
+ * --trace records a cold startup with ReflectionStats (requires NBL_REFLECT_ENABLE_STATS) and writes a Chrome trace,
+ * the shader and pipeline summary is written next to it.
+ */
+namespace
+{
+    // Allocation counting, every global operator new goes through these
+    std::atomic<uint64_t> g_allocationCount = 0;
+    std::atomic<uint64_t> g_allocationBytes = 0;
+
+    auto countedAllocate(const size_t size) -> void*
+    {
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+        g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+        if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    auto countedAllocateAligned(const size_t size, const std::align_val_t alignment) -> void*
+    {
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+        g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+        const size_t align = std::max(static_cast<size_t>(alignment), sizeof(void*));
+        if (void* ptr = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align))
+        {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+auto operator new  (const size_t size) -> void*                                { return countedAllocate(size); }
+auto operator new[](const size_t size) -> void*                                { return countedAllocate(size); }
+auto operator new  (const size_t size, const std::align_val_t alignment) -> void* { return countedAllocateAligned(size, alignment); }
+auto operator new[](const size_t size, const std::align_val_t alignment) -> void* { return countedAllocateAligned(size, alignment); }
+void operator delete  (void* ptr) noexcept                              { std::free(ptr); }
+void operator delete[](void* ptr) noexcept                              { std::free(ptr); }
+void operator delete  (void* ptr, size_t) noexcept                      { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept                      { std::free(ptr); }
+void operator delete  (void* ptr, std::align_val_t) noexcept            { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept            { std::free(ptr); }
+void operator delete  (void* ptr, size_t, std::align_val_t) noexcept    { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept    { std::free(ptr); }
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct BenchConfig
+    {
+        uint32_t                shaders             = 256;
+        uint32_t                stagesPerPipeline   = 2;
+        uint32_t                sets                = 4;
+        uint32_t                bindingsPerSet      = 16;
+        uint32_t                pushConstantMembers = 8;
+        uint32_t                vertexInputs        = 12;
+        uint32_t                iterations          = 10;
+        nbl::ReflectionBackend  backend             = nbl::ReflectionBackend::eSpirvReflect;
+        std::filesystem::path   corpusDirectory     = std::filesystem::temp_directory_path() / "nblReflectBench";
+        std::string             jsonPath;
+        std::string             tracePath;
+    };
+
+    struct BenchResult
+    {
+        std::string         name;
+        // Seconds per sample, one sample covers opsPerSample operations
+        std::vector<double> samples;
+        uint64_t            opsPerSample    = 1;
+        uint64_t            bytes           = 0;
+        uint64_t            allocations     = 0;
+        uint64_t            allocatedBytes  = 0;
+    };
+
+    struct Stage
+    {
+        uint32_t    model;
+        const char* name;
+        uint32_t    capability;
+    };
+
+    constexpr Stage kStages[] = {
+        { SpirvBuilder::Vertex,                 "vert",  1 },
+        { SpirvBuilder::Fragment,               "frag",  1 },
+        { SpirvBuilder::GLCompute,              "comp",  1 },
+        { SpirvBuilder::Geometry,               "geom",  2 },
+        { SpirvBuilder::TessellationControl,    "tesc",  3 },
+        { SpirvBuilder::TessellationEvaluation, "tese",  3 },
+        { SpirvBuilder::TaskEXT,                "task",  5283 },
+        { SpirvBuilder::MeshEXT,                "mesh",  5283 },
+        { SpirvBuilder::RayGenerationKHR,       "rgen",  4479 },
+        { SpirvBuilder::ClosestHitKHR,          "rchit", 4479 },
+        { SpirvBuilder::MissKHR,                "rmiss", 4479 },
+    };
+
+    /**
+     * @note Descriptor types only depend on (set, binding) so the stages of a pipeline merge without conflicts.
+     */
+    auto buildShader(const Stage& stage, const BenchConfig& config) -> std::vector<uint32_t>
+    {
+        SpirvBuilder b;
+        b.capability(1);
+        if (stage.capability != 1)
+        {
+            b.capability(stage.capability);
+        }
+        b.memoryModel(0, 1);
+
+        const uint32_t voidType     = b.typeVoid();
+        const uint32_t functionType = b.typeFunction(voidType);
+        const uint32_t uintType     = b.typeInt(32, 0);
+        const uint32_t floatType    = b.typeFloat(32);
+        const uint32_t vec2         = b.typeVector(floatType, 2);
+        const uint32_t vec3         = b.typeVector(floatType, 3);
+        const uint32_t vec4         = b.typeVector(floatType, 4);
+        const uint32_t mat4         = b.typeMatrix(vec4, 4);
+        const uint32_t image2D      = b.typeImage(floatType, SpirvBuilder::Dim2D, 1);
+        const uint32_t storage2D    = b.typeImage(floatType, SpirvBuilder::Dim2D, 2, 1);
+        const uint32_t sampled2D    = b.typeSampledImage(image2D);
+
+        const uint32_t uniformBlock = b.typeStruct({ mat4, vec4 });
+        b.decorate(uniformBlock, SpirvBuilder::Block);
+        b.memberDecorate(uniformBlock, 0, SpirvBuilder::Offset, { 0 });
+        b.memberDecorate(uniformBlock, 0, SpirvBuilder::ColMajor);
+        b.memberDecorate(uniformBlock, 0, SpirvBuilder::MatrixStride, { 16 });
+        b.memberDecorate(uniformBlock, 1, SpirvBuilder::Offset, { 64 });
+
+        const uint32_t storageArray = b.typeRuntimeArray(vec4);
+        b.decorate(storageArray, SpirvBuilder::ArrayStride, { 16 });
+        const uint32_t storageBlock = b.typeStruct({ uintType, storageArray });
+        b.decorate(storageBlock, SpirvBuilder::Block);
+        b.memberDecorate(storageBlock, 0, SpirvBuilder::Offset, { 0 });
+        b.memberDecorate(storageBlock, 1, SpirvBuilder::Offset, { 16 });
+
+        std::vector<uint32_t> interface;
+
+        for (uint32_t set = 0; set < config.sets; ++set)
+        {
+            for (uint32_t binding = 0; binding < config.bindingsPerSet; ++binding)
+            {
+                uint32_t variable = 0;
+                switch ((set + binding) % 4)
+                {
+                    case 0:  variable = b.variable(b.typePointer(SpirvBuilder::Uniform, uniformBlock), SpirvBuilder::Uniform); break;
+                    case 1:  variable = b.variable(b.typePointer(SpirvBuilder::StorageBuffer, storageBlock), SpirvBuilder::StorageBuffer); break;
+                    case 2:  variable = b.variable(b.typePointer(SpirvBuilder::UniformConstant, sampled2D), SpirvBuilder::UniformConstant); break;
+                    default: variable = b.variable(b.typePointer(SpirvBuilder::UniformConstant, storage2D), SpirvBuilder::UniformConstant); break;
+                }
+                b.decorate(variable, SpirvBuilder::DescriptorSet, { set });
+                b.decorate(variable, SpirvBuilder::Binding, { binding });
+                b.name(variable, "resource_" + std::to_string(set) + "_" + std::to_string(binding));
+                interface.push_back(variable);
+            }
+        }
+
+        if (config.pushConstantMembers > 0)
+        {
+            const uint32_t pushBlock = b.typeStruct(std::vector<uint32_t>(config.pushConstantMembers, vec4));
+            b.decorate(pushBlock, SpirvBuilder::Block);
+            for (uint32_t member = 0; member < config.pushConstantMembers; ++member)
+            {
+                b.memberDecorate(pushBlock, member, SpirvBuilder::Offset, { member * 16 });
+            }
+            interface.push_back(b.variable(b.typePointer(SpirvBuilder::PushConstant, pushBlock), SpirvBuilder::PushConstant));
+        }
+
+        if (stage.model == SpirvBuilder::Vertex)
+        {
+            const uint32_t attributeTypes[] = { vec4, vec3, vec2, floatType };
+            for (uint32_t location = 0; location < config.vertexInputs; ++location)
+            {
+                const uint32_t type = attributeTypes[location % std::size(attributeTypes)];
+                const uint32_t input = b.variable(b.typePointer(SpirvBuilder::Input, type), SpirvBuilder::Input);
+                b.decorate(input, SpirvBuilder::Location, { location });
+                b.name(input, "inAttribute" + std::to_string(location));
+                interface.push_back(input);
+            }
+        }
+
+        const uint32_t main = b.id();
+        b.entryPoint(stage.model, main, "main", interface);
+        if (stage.model == SpirvBuilder::GLCompute)
+        {
+            b.executionMode(main, 17, { 64, 1, 1 });
+        }
+        b.emptyFunction(main, voidType, functionType);
+
+        return b.build();
+    }
+
+    /**
+     * @return Shader file paths, stage kinds cycle so every pipeline mixes several of them.
+     */
+    auto generateCorpus(const BenchConfig& config) -> std::vector<std::string>
+    {
+        std::filesystem::create_directories(config.corpusDirectory);
+
+        std::vector<std::string> files;
+        for (uint32_t i = 0; i < config.shaders; ++i)
+        {
+            const Stage& stage = kStages[i % std::size(kStages)];
+            const auto words = buildShader(stage, config);
+
+            const auto path = config.corpusDirectory / ("shader" + std::to_string(i) + "." + stage.name + ".spv");
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+            files.push_back(path.string());
+        }
+        return files;
+    }
+
+    auto groupPipelines(const std::vector<std::string>& files, const uint32_t stagesPerPipeline) -> std::vector<std::vector<std::string>>
+    {
+        std::vector<std::vector<std::string>> pipelines;
+        for (size_t i = 0; i < files.size(); i += stagesPerPipeline)
+        {
+            const size_t end = std::min(files.size(), i + stagesPerPipeline);
+            pipelines.emplace_back(std::begin(files) + i, std::begin(files) + end);
+        }
+        return pipelines;
+    }
+
+    /**
+     * @param run Runs one sample and returns the number of SPIR-V bytes it processed.
+     * @param prepare Runs before each sample and is excluded from timing and allocation counts.
+     */
+    auto measure(const std::string& name, const size_t samples, const uint64_t opsPerSample,
+                 const std::function<uint64_t(size_t)>& run, const std::function<void()>& prepare = {}) -> BenchResult
+    {
+        BenchResult result { name, {}, opsPerSample };
+        result.samples.reserve(samples);
+
+        for (size_t i = 0; i < samples; ++i)
+        {
+            if (prepare)
+            {
+                prepare();
+            }
+
+            const uint64_t allocations = g_allocationCount.load(std::memory_order_relaxed);
+            const uint64_t bytes = g_allocationBytes.load(std::memory_order_relaxed);
+            const auto start = Clock::now();
+            result.bytes += run(i);
+            const auto end = Clock::now();
+            result.allocations += g_allocationCount.load(std::memory_order_relaxed) - allocations;
+            result.allocatedBytes += g_allocationBytes.load(std::memory_order_relaxed) - bytes;
+            result.samples.push_back(std::chrono::duration<double>(end - start).count());
+        }
+        return result;
+    }
+
+    /**
+     * @note Flushes and drops the cached pages of every file, clean pages are only dropped by the kernel on a best effort basis.
+     * @return False when the platform has no way to evict files, the page cache then stays warm.
+     */
+    auto evictPageCache(const std::vector<std::string>& files) -> bool
+    {
+#if defined(NBL_REFLECT_BENCH_EVICT)
+        for (const auto& file : files)
+        {
+            const int fd = open(file.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw std::runtime_error("Failed to open file: " + file);
+            }
+            // Dirty pages are not dropped, the corpus was just written
+            fdatasync(fd);
+            const int result = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+            if (result != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+#else
+        (void) files;
+        return false;
+#endif
+    }
+
+    auto percentile(std::vector<double> samples, const double p) -> double
+    {
+        if (samples.empty())
+        {
+            return 0.0;
+        }
+        std::ranges::sort(samples);
+        const size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[std::min(rank, samples.size() - 1)];
+    }
+
+    struct Summary
+    {
+        double opsPerSecond        = 0.0;
+        double megabytesPerSecond  = 0.0;
+        double p50                 = 0.0;
+        double p90                 = 0.0;
+        double p99                 = 0.0;
+        double max                 = 0.0;
+        double allocationsPerOp    = 0.0;
+        double allocatedBytesPerOp = 0.0;
+    };
+
+    /**
+     * @note Percentiles are per sample, throughput and allocation counts are per operation.
+     */
+    auto summarize(const BenchResult& result) -> Summary
+    {
+        double total = 0.0;
+        for (const double sample : result.samples)
+        {
+            total += sample;
+        }
+        const double ops = static_cast<double>(result.samples.size() * result.opsPerSample);
+
+        Summary summary {};
+        summary.opsPerSecond        = total > 0.0 ? ops / total : 0.0;
+        summary.megabytesPerSecond  = total > 0.0 ? static_cast<double>(result.bytes) / total / (1024.0 * 1024.0) : 0.0;
+        summary.p50                 = percentile(result.samples, 50.0);
+        summary.p90                 = percentile(result.samples, 90.0);
+        summary.p99                 = percentile(result.samples, 99.0);
+        summary.max                 = percentile(result.samples, 100.0);
+        summary.allocationsPerOp    = ops > 0.0 ? static_cast<double>(result.allocations) / ops : 0.0;
+        summary.allocatedBytesPerOp = ops > 0.0 ? static_cast<double>(result.allocatedBytes) / ops : 0.0;
+        return summary;
+    }
+
+    void printTable(const std::vector<BenchResult>& results)
+    {
+        std::cout << std::left << std::setw(34) << "benchmark"
+                  << std::right << std::setw(12) << "ops/s" << std::setw(10) << "MiB/s"
+                  << std::setw(12) << "p50 us" << std::setw(12) << "p90 us" << std::setw(12) << "p99 us"
+                  << std::setw(12) << "allocs/op" << std::setw(12) << "bytes/op" << std::endl;
+
+        for (const auto& result : results)
+        {
+            const Summary s = summarize(result);
+            std::cout << std::left << std::setw(34) << result.name << std::right << std::fixed
+                      << std::setprecision(0) << std::setw(12) << s.opsPerSecond
+                      << std::setprecision(1) << std::setw(10) << s.megabytesPerSecond
+                      << std::setw(12) << s.p50 * 1e6 << std::setw(12) << s.p90 * 1e6 << std::setw(12) << s.p99 * 1e6
+                      << std::setw(12) << s.allocationsPerOp << std::setprecision(0) << std::setw(12) << s.allocatedBytesPerOp << std::endl;
+        }
+    }
+
+    void writeJson(std::ostream& out, const BenchConfig& config, const std::vector<BenchResult>& results)
+    {
+        out << std::setprecision(9) << "{\n"
+            << "  \"config\": {\n"
+            << "    \"shaders\": " << config.shaders << ",\n"
+            << "    \"stagesPerPipeline\": " << config.stagesPerPipeline << ",\n"
+            << "    \"sets\": " << config.sets << ",\n"
+            << "    \"bindingsPerSet\": " << config.bindingsPerSet << ",\n"
+            << "    \"pushConstantMembers\": " << config.pushConstantMembers << ",\n"
+            << "    \"vertexInputs\": " << config.vertexInputs << ",\n"
+            << "    \"iterations\": " << config.iterations << ",\n"
+            << "    \"backend\": \"" << (config.backend == nbl::ReflectionBackend::eFastScan ? "fastScan" : "spirvReflect") << "\"\n"
+            << "  },\n"
+            << "  \"results\": [\n";
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& result = results[i];
+            const Summary s = summarize(result);
+            out << "    {\n"
+                << "      \"name\": \"" << result.name << "\",\n"
+                << "      \"samples\": " << result.samples.size() << ",\n"
+                << "      \"opsPerSample\": " << result.opsPerSample << ",\n"
+                << "      \"opsPerSecond\": " << s.opsPerSecond << ",\n"
+                << "      \"megabytesPerSecond\": " << s.megabytesPerSecond << ",\n"
+                << "      \"p50Seconds\": " << s.p50 << ",\n"
+                << "      \"p90Seconds\": " << s.p90 << ",\n"
+                << "      \"p99Seconds\": " << s.p99 << ",\n"
+                << "      \"maxSeconds\": " << s.max << ",\n"
+                << "      \"allocationsPerOp\": " << s.allocationsPerOp << ",\n"
+                << "      \"allocatedBytesPerOp\": " << s.allocatedBytesPerOp << "\n"
+                << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    auto parseConfig(const int argc, const char** argv) -> BenchConfig
+    {
+        BenchConfig config;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const auto next = [&]() -> std::string {
+                if (i + 1 >= argc)
+                {
+                    throw std::runtime_error("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+            const auto nextCount = [&]() -> uint32_t { return static_cast<uint32_t>(std::stoul(next())); };
+
+            if (arg == "--shaders")                     config.shaders             = std::max(1u, nextCount());
+            else if (arg == "--stages-per-pipeline")    config.stagesPerPipeline   = std::max(1u, nextCount());
+            else if (arg == "--sets")                   config.sets                = nextCount();
+            else if (arg == "--bindings")               config.bindingsPerSet      = nextCount();
+            else if (arg == "--push-constant-members")  config.pushConstantMembers = nextCount();
+            else if (arg == "--vertex-inputs")          config.vertexInputs        = nextCount();
+            else if (arg == "--iterations")             config.iterations          = std::max(1u, nextCount());
+            else if (arg == "--fast-scan")              config.backend             = nbl::ReflectionBackend::eFastScan;
+            else if (arg == "--corpus")                 config.corpusDirectory     = next();
+            else if (arg == "--json")                   config.jsonPath            = next();
+            else if (arg == "--trace")                  config.tracePath           = next();
+            else
+            {
+                throw std::runtime_error("Unknown argument: " + arg);
+            }
+        }
+        return config;
+    }
+}
+
+int main(const int argc, const char** argv)
+{
+    try
+    {
+        const BenchConfig config = parseConfig(argc, argv);
+        const auto files = generateCorpus(config);
+        const auto pipelines = groupPipelines(files, config.stagesPerPipeline);
+
+        uint64_t corpusBytes = 0;
+        std::vector<nbl::ShaderCode> corpus;
+        for (const auto& file : files)
+        {
+            corpus.push_back(nbl::ShaderCode::readFile(file));
+            corpusBytes += corpus.back().sizeInBytes();
+        }
+
+        const size_t shaderSamples = files.size() * config.iterations;
+        std::vector<BenchResult> results;
+
+        // Per shader benchmarks, one sample per shader so percentiles are per shader latencies
+        results.push_back(measure("load/readFile", shaderSamples, 1, [&](const size_t i) {
+            return nbl::ShaderCode::readFile(files[i % files.size()]).sizeInBytes();
+        }));
+        results.push_back(measure("load/mapFile", shaderSamples, 1, [&](const size_t i) {
+            return nbl::ShaderCode::mapFile(files[i % files.size()]).sizeInBytes();
+        }));
+
+        // Reflection of in-memory code, excludes file I/O
+        results.push_back(measure("reflect/shader", shaderSamples, 1, [&](const size_t i) {
+            const auto& shaderCode = corpus[i % corpus.size()];
+            (void) nbl::ShaderReflection::reflectShader(shaderCode, files[i % files.size()], config.backend);
+            return static_cast<uint64_t>(shaderCode.sizeInBytes());
+        }));
+
+        // Merging, one sample per pipeline, reflected stages are copied outside of the timed region
+        std::vector<std::vector<nbl::ShaderReflectionData>> reflected;
+        for (const auto& pipeline : pipelines)
+        {
+            auto& stages = reflected.emplace_back();
+            for (const auto& file : pipeline)
+            {
+                stages.push_back(nbl::ShaderReflection::reflectShader(file, config.backend));
+            }
+        }
+
+        std::vector<nbl::ShaderReflectionData> mergeInput;
+        size_t mergeIndex = 0;
+        results.push_back(measure("merge/pipeline", pipelines.size() * config.iterations, 1, [&](size_t) {
+            (void) nbl::ShaderReflection::mergePipelineShaders(std::move(mergeInput));
+            return uint64_t { 0 };
+        }, [&] { mergeInput = reflected[mergeIndex++ % reflected.size()]; }));
+
+        // Startup of every pipeline, one sample per batch, only the uncached startup evicts the corpus from the page cache
+        const uint64_t shaderCount = files.size();
+        const bool evicts = evictPageCache(files);
+        for (const auto mode : { nbl::ReflectionExecutionMode::eSerial, nbl::ReflectionExecutionMode::eParallel })
+        {
+            const std::string suffix = mode == nbl::ReflectionExecutionMode::eSerial ? "/serial" : "/parallel";
+
+            results.push_back(measure((evicts ? "startup/cold" : "startup/warm") + suffix, config.iterations, shaderCount, [&](size_t) {
+                (void) nbl::ShaderReflection::reflectPipelineBatch(pipelines, mode, nullptr, config.backend);
+                return corpusBytes;
+            }, [&] { evictPageCache(files); }));
+
+            nbl::ShaderReflectionCache memoryCache;
+            (void) nbl::ShaderReflection::reflectPipelineBatch(pipelines, mode, &memoryCache, config.backend);
+            results.push_back(measure("startup/warmMemoryCache" + suffix, config.iterations, shaderCount, [&](size_t) {
+                (void) nbl::ShaderReflection::reflectPipelineBatch(pipelines, mode, &memoryCache, config.backend);
+                return corpusBytes;
+            }));
+
+            // A fresh cache instance per sample so entries come from disk rather than memory
+            const auto cacheDirectory = config.corpusDirectory / "cache";
+            {
+                nbl::ShaderReflectionCache diskCache(cacheDirectory);
+                (void) nbl::ShaderReflection::reflectPipelineBatch(pipelines, mode, &diskCache, config.backend);
+            }
+            std::optional<nbl::ShaderReflectionCache> diskCache;
+            results.push_back(measure("startup/warmDiskCache" + suffix, config.iterations, shaderCount, [&](size_t) {
+                (void) nbl::ShaderReflection::reflectPipelineBatch(pipelines, mode, &*diskCache, config.backend);
+                return corpusBytes;
+            }, [&] { diskCache.emplace(cacheDirectory); }));
+        }
+
+        printTable(results);
+
+        if (!config.tracePath.empty())
+        {
+            nbl::ReflectionStats::setAllocationCounter([] { return g_allocationCount.load(std::memory_order_relaxed); });
+            nbl::ReflectionStats::reset();
+            nbl::ReflectionStats::setEnabled(true);
+            if (!nbl::ReflectionStats::isEnabled())
+            {
+                throw std::runtime_error("--trace requires nblReflect to be built with NBL_REFLECT_ENABLE_STATS");
+            }
+            if (!evictPageCache(files))
+            {
+                std::cerr << "warning: the page cache could not be evicted, the trace records a warm startup" << std::endl;
+            }
+
+            (void) nbl::ShaderReflection::reflectPipelineBatch(pipelines, nbl::ReflectionExecutionMode::eParallel, nullptr, config.backend);
+            nbl::ReflectionStats::setEnabled(false);
+
+            nbl::ReflectionStats::writeChromeTrace(std::filesystem::path(config.tracePath));
+            nbl::ReflectionStats::writeSummary(std::filesystem::path(config.tracePath + ".summary.json"));
+        }
+
+        if (!config.jsonPath.empty())
+        {
+            std::ofstream json(config.jsonPath, std::ios::trunc);
+            if (!json.is_open())
+            {
+                throw std::runtime_error("Failed to open file: " + config.jsonPath);
+            }
+            writeJson(json, config, results);
+        }
+    }
+    catch (std::exception const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "ShaderReflection.hpp"
+
+namespace nbl
+{
+    /**
+     * Byte range of a single member (or array element) of a block, independent of any BlockWriter instance.
+     */
+    struct BlockMemberHandle
+    {
+        uint32_t offset = ~0u;
+        uint32_t size   = 0;
+
+        auto isValid() const -> bool { return offset != ~0u; }
+        auto operator<=>(const BlockMemberHandle&) const = default;
+    };
+
+    struct BlockRange
+    {
+        uint32_t offset = 0;
+        uint32_t size   = 0;
+
+        auto operator<=>(const BlockRange&) const = default;
+    };
+
+    struct PushConstantUpdate
+    {
+        vk::ShaderStageFlags stageFlags = {};
+        uint32_t             offset     = 0;
+        uint32_t             size       = 0;
+        // Points into the writer's storage, valid until the writer is destroyed
+        const void*          pValues    = nullptr;
+    };
+
+    /**
+     * Host copy of a uniform buffer, storage buffer or push constant block that records which bytes were written.
+     * Members are addressed by path (e.g. "lights[2].color") or by a handle resolved once with findMember.
+     * @note Offsets are block offsets, they can be used directly as the vkCmdPushConstants offset or relative to the buffer's bound offset.
+     * The writer does not record any Vulkan commands.
+     */
+    class BlockWriter
+    {
+    public:
+        /**
+         * @note runtimeArrayLength sizes a trailing runtime array of a storage buffer, it is ignored for other blocks.
+         */
+        explicit BlockWriter(const ShaderReflectionBlock& block, uint32_t runtimeArrayLength = 0);
+
+        /**
+         * @note Paths are dot separated member names with optional indices for every array dimension, e.g. "bones[3]" or "grid[1][2].value".
+         * Without indices the handle covers the whole array. Runtime array indices are not bounds-checked here but when writing.
+         * @return Invalid handle if the path does not name a member of the block.
+         */
+        static auto findMember(const ShaderReflectionBlock& block, std::string_view path) -> BlockMemberHandle;
+
+        auto findMember(std::string_view path) const -> BlockMemberHandle { return findMember(m_block, path); }
+
+        /**
+         * @note Throws if the handle is invalid, the data is larger than the member or the member lies outside of the storage.
+         */
+        void write(BlockMemberHandle handle, const void* data, uint32_t size);
+        void read (BlockMemberHandle handle, void* data, uint32_t size) const;
+
+        template <typename T>
+        void set(const BlockMemberHandle handle, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            write(handle, &value, sizeof(T));
+        }
+
+        template <typename T>
+        void set(const std::string_view path, const T& value)
+        {
+            set(checkedMember(path), value);
+        }
+
+        template <typename T>
+        auto get(const BlockMemberHandle handle) const -> T
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value {};
+            read(handle, &value, sizeof(T));
+            return value;
+        }
+
+        /**
+         * @note Ranges are aligned to the alignment and clamped to the storage, ranges closer than mergeGap bytes are joined,
+         * trading uploading unchanged bytes for fewer commands.
+         * @return Sorted, non-overlapping ranges written since the last clearDirty().
+         */
+        auto getDirtyRanges(uint32_t alignment = 4, uint32_t mergeGap = 0) const -> std::vector<BlockRange>;
+
+        /**
+         * Splits the dirty ranges along the pipeline layout's push constant ranges, one vkCmdPushConstants call per update.
+         * @note Expects non-overlapping ranges such as PipelineReflectionData::pushConstants, bytes outside of every range are skipped.
+         */
+        auto getPushConstantUpdates(std::span<const vk::PushConstantRange> ranges) const -> std::vector<PushConstantUpdate>;
+
+        auto isDirty() const -> bool { return !m_dirty.empty(); }
+        void clearDirty() { m_dirty.clear(); }
+        void markDirty(BlockRange range);
+        void markAllDirty() { markDirty({ 0, size() }); }
+
+        auto data() const -> const std::byte* { return m_data.data(); }
+        auto size() const -> uint32_t         { return static_cast<uint32_t>(m_data.size()); }
+        auto getBlock() const -> const ShaderReflectionBlock& { return m_block; }
+
+    private:
+        auto checkedMember(std::string_view path) const -> BlockMemberHandle;
+        void checkRange(BlockMemberHandle handle, uint32_t size) const;
+
+        ShaderReflectionBlock   m_block;
+        std::vector<std::byte>  m_data;
+        // Sorted and coalesced, exact bytes without alignment
+        std::vector<BlockRange> m_dirty;
+    };
+}
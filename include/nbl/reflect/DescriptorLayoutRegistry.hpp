@@ -0,0 +1,80 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include "ShaderReflection.hpp"
+
+namespace nbl
+{
+    struct DescriptorSetLayoutHandle
+    {
+        uint32_t index = ~0u;
+
+        auto isValid() const -> bool { return index != ~0u; }
+        auto operator<=>(const DescriptorSetLayoutHandle&) const = default;
+    };
+
+    struct PipelineLayoutHandle
+    {
+        uint32_t index = ~0u;
+
+        auto isValid() const -> bool { return index != ~0u; }
+        auto operator<=>(const PipelineLayoutHandle&) const = default;
+    };
+
+    struct InternedDescriptorSetLayout
+    {
+        // Sorted by binding number
+        std::vector<vk::DescriptorSetLayoutBinding> bindings = {};
+        uint64_t                                    hash     = 0;
+    };
+
+    struct InternedPipelineLayout
+    {
+        // Indexed by set number, sets not used by the pipeline refer to the empty layout
+        std::vector<DescriptorSetLayoutHandle>  setLayouts    = {};
+        // Sorted by offset, size and stage flags
+        std::vector<vk::PushConstantRange>      pushConstants = {};
+        uint64_t                                hash          = 0;
+    };
+
+    /**
+     * Hash-consing registry for descriptor set layouts and pipeline layouts.
+     * Structurally identical layouts resolve to the same handle, so each layout only has to be created once.
+     * @note Hashes only depend on the layout contents and are stable across runs. All methods are thread safe,
+     * references returned by the getters stay valid for the lifetime of the registry.
+     */
+    class DescriptorLayoutRegistry
+    {
+    public:
+        /**
+         * @note The set number is not part of the key, the same layout used at different set indices is interned once.
+         */
+        auto internSetLayout     (const ShaderReflectionDescriptorSet& descriptorSet) -> DescriptorSetLayoutHandle;
+        auto internPipelineLayout(const PipelineReflectionData& pipelineData)         -> PipelineLayoutHandle;
+
+        auto getSetLayout       (DescriptorSetLayoutHandle handle) const -> const InternedDescriptorSetLayout&;
+        auto getPipelineLayout  (PipelineLayoutHandle handle)      const -> const InternedPipelineLayout&;
+        auto getSetLayoutCount     () const -> size_t;
+        auto getPipelineLayoutCount() const -> size_t;
+
+        /**
+         * @return True if descriptor sets bound with one layout remain valid for the other at the specified set (vkCmdBindDescriptorSets compatibility).
+         */
+        auto isCompatibleForSet(PipelineLayoutHandle a, PipelineLayoutHandle b, uint32_t set) const -> bool;
+
+        static auto hashSetLayout     (std::span<const vk::DescriptorSetLayoutBinding> bindings) -> uint64_t;
+        static auto hashPipelineLayout(std::span<const uint64_t> setLayoutHashes, std::span<const vk::PushConstantRange> pushConstants) -> uint64_t;
+
+    private:
+        auto internSortedSetLayout(std::vector<vk::DescriptorSetLayoutBinding>&& bindings) -> DescriptorSetLayoutHandle;
+
+        std::deque<InternedDescriptorSetLayout>             m_setLayouts;
+        std::deque<InternedPipelineLayout>                  m_pipelineLayouts;
+        std::unordered_multimap<uint64_t, uint32_t>         m_setLayoutLookup;
+        std::unordered_multimap<uint64_t, uint32_t>         m_pipelineLayoutLookup;
+        mutable std::mutex                                  m_mutex;
+    };
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <span>
+#include "DescriptorLayoutRegistry.hpp"
+
+namespace nbl
+{
+    /**
+     * Descriptor requirements of a single interned set layout.
+     */
+    struct DescriptorLayoutBudget
+    {
+        DescriptorSetLayoutHandle           layout              = {};
+        uint64_t                            hash                = 0;
+        // Total number of descriptors in one set allocated with this layout
+        uint32_t                            descriptorCount     = 0;
+        // Descriptor index of every binding, in the order of InternedDescriptorSetLayout::bindings
+        std::vector<uint32_t>               bindingOffsets      = {};
+        // Descriptor counts aggregated by type
+        std::vector<vk::DescriptorPoolSize> descriptorsByType   = {};
+        // Runtime sized arrays (count 0) can not be budgeted and have to be sized by the caller
+        bool                                hasUnboundedArrays  = false;
+    };
+
+    /**
+     * Pool sizing for all layouts used at one set index. Set indices are used as update frequency buckets
+     * (e.g. per-frame, per-pass, per-material, per-draw), so each bucket can be backed by its own pool.
+     */
+    struct DescriptorPoolBucket
+    {
+        uint32_t                                set         = 0;
+        uint32_t                                maxSets     = 0;
+        std::vector<vk::DescriptorPoolSize>     poolSizes   = {};
+        std::vector<DescriptorSetLayoutHandle>  layouts     = {};
+    };
+
+    struct DescriptorPoolPlan
+    {
+        // Sorted by set index, empty buckets are omitted
+        std::vector<DescriptorPoolBucket>       buckets         = {};
+        // One entry per distinct layout, in handle order
+        std::vector<DescriptorLayoutBudget>     layouts         = {};
+        // Totals across all buckets, for a single shared pool
+        uint32_t                                maxSets         = 0;
+        std::vector<vk::DescriptorPoolSize>     poolSizes       = {};
+    };
+
+    class DescriptorPoolPlanner
+    {
+    public:
+        /**
+         * @param instancesPerSet Expected number of simultaneously allocated descriptor sets per distinct layout, indexed by set.
+         * Sets past the end of the list use the last value, an empty list means one instance per layout.
+         * @note Layouts are interned through the registry, so each distinct layout is budgeted once no matter how many pipelines use it.
+         * Empty set layouts are not budgeted.
+         */
+        static auto plan(std::span<const PipelineReflectionData> pipelines,
+                         std::span<const uint32_t> instancesPerSet,
+                         DescriptorLayoutRegistry& registry) -> DescriptorPoolPlan;
+
+        static auto budgetLayout(const InternedDescriptorSetLayout& layout, DescriptorSetLayoutHandle handle) -> DescriptorLayoutBudget;
+
+        /**
+         * @param descriptorSize Size in bytes of a single descriptor of a type, e.g. from VkPhysicalDeviceDescriptorBufferPropertiesEXT.
+         * @return Byte offset of every binding for descriptor buffer layouts, followed by the total size of the set.
+         */
+        static auto computeByteOffsets(const InternedDescriptorSetLayout& layout,
+                                       const std::function<vk::DeviceSize(vk::DescriptorType)>& descriptorSize) -> std::vector<vk::DeviceSize>;
+
+    private:
+        static void addPoolSizes(std::vector<vk::DescriptorPoolSize>& poolSizes, const std::vector<vk::DescriptorPoolSize>& sizes, uint32_t instances);
+    };
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ShaderReflection.hpp"
+
+namespace nbl
+{
+    struct FlatShaderHandle
+    {
+        uint32_t index = ~0u;
+
+        auto isValid() const -> bool { return index != ~0u; }
+        auto operator<=>(const FlatShaderHandle&) const = default;
+    };
+
+    struct FlatPipelineHandle
+    {
+        uint32_t index = ~0u;
+
+        auto isValid() const -> bool { return index != ~0u; }
+        auto operator<=>(const FlatPipelineHandle&) const = default;
+    };
+
+    // Range of elements in one of the database's arrays
+    struct FlatRange
+    {
+        uint32_t offset = 0;
+        uint32_t count  = 0;
+    };
+
+    struct FlatDescriptorSet
+    {
+        uint32_t    set      = 0;
+        FlatRange   bindings = {};
+    };
+
+    struct FlatConflict
+    {
+        uint32_t    set     = 0;
+        uint32_t    binding = 0;
+        FlatRange   message = {};
+    };
+
+    struct FlatBlockMember
+    {
+        FlatRange               name             = {};
+        uint32_t                offset           = 0;
+        uint32_t                size             = 0;
+        uint32_t                arrayStride      = 0;
+        uint32_t                matrixStride     = 0;
+        bool                    rowMajor         = false;
+        FlatRange               arrayDims        = {};
+        // Children are stored contiguously
+        FlatRange               members          = {};
+    };
+
+    struct FlatBlock
+    {
+        ShaderBlockType         type             = ShaderBlockType::eUniformBuffer;
+        FlatRange               name             = {};
+        FlatRange               typeName         = {};
+        uint32_t                set              = 0;
+        uint32_t                binding          = 0;
+        uint32_t                size             = 0;
+        FlatRange               members          = {};
+    };
+
+    struct FlatSpecConstant
+    {
+        uint32_t                    constantId   = 0;
+        FlatRange                   name         = {};
+        SpecializationConstantType  type         = SpecializationConstantType::eUint;
+        uint32_t                    width        = 32;
+        uint64_t                    defaultValue = 0;
+    };
+
+    struct FlatSharedVariable
+    {
+        FlatRange                   name             = {};
+        uint32_t                    size             = 0;
+        uint32_t                    lengthConstantId = ~0u;
+        uint32_t                    elementSize      = 0;
+    };
+
+    struct FlatWorkgroup
+    {
+        std::array<uint32_t, 3>     localSize            = { 1, 1, 1 };
+        std::array<uint32_t, 3>     localSizeConstantIds = { ~0u, ~0u, ~0u };
+        uint32_t                    sharedMemorySize     = 0;
+        FlatRange                   sharedVariables      = {};
+    };
+
+    struct FlatShaderRecord
+    {
+        FlatRange               shaderName       = {};
+        FlatRange               sourceFile       = {};
+        FlatRange               entryPoint       = {};
+        vk::ShaderStageFlagBits shaderStage      = vk::ShaderStageFlagBits::eVertex;
+        bool                    hasVertexInput   = false;
+        FlatRange               descriptorSets   = {};
+        FlatRange               pushConstants    = {};
+        // Attribute names are parallel to the attributes
+        FlatRange               vertexAttributes = {};
+        FlatRange               vertexBindings   = {};
+        FlatRange               blocks           = {};
+        FlatRange               specConstants    = {};
+        // One workgroup for compute, task and mesh stages, none otherwise
+        FlatRange               workgroup        = {};
+    };
+
+    struct FlatPipelineRecord
+    {
+        FlatRange               shaders          = {};
+        FlatRange               descriptorSets   = {};
+        FlatRange               pushConstants    = {};
+        FlatRange               conflicts        = {};
+    };
+
+    /**
+     * Struct-of-arrays storage of reflection data for large pipeline databases.
+     * Records only hold offsets and counts into shared arrays of bindings, ranges, attributes and a string pool,
+     * lookups return spans and string views into those arrays.
+     * All arrays are allocated from a monotonic arena on top of the upstream resource, clear() releases everything at once.
+     * @note reserve() sizes every array up front, otherwise growing arrays leave their previous buffers in the arena until clear().
+     * Spans and string views are invalidated by adding records, handles only by clear(). Not thread-safe.
+     */
+    class FlatReflectionDatabase
+    {
+    public:
+        explicit FlatReflectionDatabase(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+        // The arrays keep pointing at the moved arena, a moved-from database may only be destroyed
+        FlatReflectionDatabase(FlatReflectionDatabase&&) noexcept = default;
+        auto operator=(FlatReflectionDatabase&&) -> FlatReflectionDatabase& = delete;
+
+        /**
+         * @note Sizes all arrays for the given pipelines, including their shaders.
+         */
+        void reserve(std::span<const PipelineReflectionData> pipelines);
+
+        auto addShader  (const ShaderReflectionData& shaderData)     -> FlatShaderHandle;
+
+        /**
+         * @note A stage identical to an already added shader, e.g. a vertex shader shared by several pipelines, reuses its handle.
+         * Candidates are found by the address of their code, stages loaded separately from the same file are added again.
+         */
+        auto addPipeline(const PipelineReflectionData& pipelineData) -> FlatPipelineHandle;
+
+        /**
+         * @note Destroys all records and returns the arena's memory to the upstream resource in one step.
+         */
+        void clear();
+
+        auto getShaderCount()   const -> size_t { return m_shaders.size(); }
+        auto getPipelineCount() const -> size_t { return m_pipelines.size(); }
+
+        auto getShader  (FlatShaderHandle handle)   const -> const FlatShaderRecord&;
+        auto getPipeline(FlatPipelineHandle handle) const -> const FlatPipelineRecord&;
+
+        auto getShaderName      (FlatShaderHandle handle) const -> std::string_view { return getString(getShader(handle).shaderName); }
+        auto getSourceFile      (FlatShaderHandle handle) const -> std::string_view { return getString(getShader(handle).sourceFile); }
+        auto getEntryPoint      (FlatShaderHandle handle) const -> std::string_view { return getString(getShader(handle).entryPoint); }
+        auto getShaderCode      (FlatShaderHandle handle) const -> const ShaderCode&;
+        auto getDescriptorSets  (FlatShaderHandle handle) const -> std::span<const FlatDescriptorSet>;
+        auto getPushConstants   (FlatShaderHandle handle) const -> std::span<const vk::PushConstantRange>;
+        auto getVertexAttributes(FlatShaderHandle handle) const -> std::span<const vk::VertexInputAttributeDescription>;
+        auto getVertexBindings  (FlatShaderHandle handle) const -> std::span<const vk::VertexInputBindingDescription>;
+        auto getAttributeName   (FlatShaderHandle handle, uint32_t attribute) const -> std::string_view;
+        auto getBlocks          (FlatShaderHandle handle) const -> std::span<const FlatBlock>;
+        auto getSpecConstants   (FlatShaderHandle handle) const -> std::span<const FlatSpecConstant>;
+        auto getWorkgroup       (FlatShaderHandle handle) const -> const FlatWorkgroup*;
+
+        auto getShaders         (FlatPipelineHandle handle) const -> std::span<const FlatShaderHandle>;
+        auto getDescriptorSets  (FlatPipelineHandle handle) const -> std::span<const FlatDescriptorSet>;
+        auto getPushConstants   (FlatPipelineHandle handle) const -> std::span<const vk::PushConstantRange>;
+        auto getConflicts       (FlatPipelineHandle handle) const -> std::span<const FlatConflict>;
+
+        auto getBindings(const FlatDescriptorSet& descriptorSet) const -> std::span<const vk::DescriptorSetLayoutBinding>;
+        auto getString  (FlatRange range)                        const -> std::string_view;
+        auto getMembers (const FlatBlock& block)                 const -> std::span<const FlatBlockMember>;
+        auto getMembers (const FlatBlockMember& member)          const -> std::span<const FlatBlockMember>;
+        auto getArrayDims(const FlatBlockMember& member)         const -> std::span<const uint32_t>;
+        auto getSharedVariables(const FlatWorkgroup& workgroup)  const -> std::span<const FlatSharedVariable>;
+
+        /**
+         * @note Every binding of every record, e.g. for batched layout creation.
+         */
+        auto getAllBindings() const -> std::span<const vk::DescriptorSetLayoutBinding> { return m_bindings; }
+
+        auto toShaderReflectionData  (FlatShaderHandle handle)   const -> ShaderReflectionData;
+        auto toPipelineReflectionData(FlatPipelineHandle handle) const -> PipelineReflectionData;
+
+        auto getMemoryResource() const -> std::pmr::memory_resource* { return m_arena.get(); }
+
+    private:
+        auto addString(std::string_view string) -> FlatRange;
+        auto addDescriptorSets(const std::vector<ShaderReflectionDescriptorSet>& descriptorSets) -> FlatRange;
+        auto addPushConstants (const std::vector<vk::PushConstantRange>& pushConstants) -> FlatRange;
+        auto addBlocks        (const std::vector<ShaderReflectionBlock>& blocks) -> FlatRange;
+        auto addBlockMembers  (const std::vector<ShaderReflectionBlockMember>& members) -> FlatRange;
+        auto toBlockMembers   (std::span<const FlatBlockMember> members) const -> std::vector<ShaderReflectionBlockMember>;
+
+        auto findShader  (const ShaderReflectionData& shaderData) const -> FlatShaderHandle;
+        auto equalShader (FlatShaderHandle handle, const ShaderReflectionData& shaderData) const -> bool;
+        auto equalMembers(std::span<const FlatBlockMember> members, const std::vector<ShaderReflectionBlockMember>& other) const -> bool;
+
+        template <typename T>
+        static auto slice(const std::pmr::vector<T>& array, FlatRange range) -> std::span<const T>;
+
+        // Declared first, so the arrays are destroyed before their arena
+        std::unique_ptr<std::pmr::monotonic_buffer_resource>    m_arena;
+
+        std::pmr::vector<FlatShaderRecord>                      m_shaders;
+        std::pmr::vector<FlatPipelineRecord>                    m_pipelines;
+        std::pmr::vector<ShaderCode>                            m_shaderCode;
+        std::pmr::vector<FlatShaderHandle>                      m_pipelineShaders;
+        std::pmr::vector<FlatDescriptorSet>                     m_descriptorSets;
+        std::pmr::vector<vk::DescriptorSetLayoutBinding>        m_bindings;
+        std::pmr::vector<vk::PushConstantRange>                 m_pushConstants;
+        std::pmr::vector<vk::VertexInputAttributeDescription>   m_vertexAttributes;
+        std::pmr::vector<FlatRange>                             m_attributeNames;
+        std::pmr::vector<vk::VertexInputBindingDescription>     m_vertexBindings;
+        std::pmr::vector<FlatConflict>                          m_conflicts;
+        std::pmr::vector<FlatBlock>                             m_blocks;
+        std::pmr::vector<FlatBlockMember>                       m_blockMembers;
+        std::pmr::vector<uint32_t>                              m_arrayDims;
+        std::pmr::vector<FlatSpecConstant>                      m_specConstants;
+        std::pmr::vector<FlatWorkgroup>                         m_workgroups;
+        std::pmr::vector<FlatSharedVariable>                    m_sharedVariables;
+        std::pmr::vector<char>                                  m_strings;
+
+        // Shaders by the address of their code, to find the shaders shared by several pipelines
+        std::pmr::unordered_multimap<const uint32_t*, FlatShaderHandle> m_shaderIndex;
+    };
+}
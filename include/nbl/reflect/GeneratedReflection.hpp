@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vulkan/vulkan.hpp>
+
+/**
+ * Types referenced by headers emitted by nblReflectGen.
+ * @note Header-only and independent of spirv-reflect, so shipping builds can use generated tables without linking nblReflect.
+ */
+namespace nbl::gen
+{
+    struct ShaderStage
+    {
+        vk::ShaderStageFlagBits         stage       = vk::ShaderStageFlagBits::eVertex;
+        const char*                     entryPoint  = "main";
+        // Empty unless the SPIR-V was embedded, load sourceFile instead
+        std::span<const uint32_t>       code        = {};
+        const char*                     sourceFile  = "";
+
+        auto getShaderModuleCreateInfo() const -> vk::ShaderModuleCreateInfo
+        {
+            return vk::ShaderModuleCreateInfo()
+                .setPCode(code.data())
+                .setCodeSize(code.size_bytes());
+        }
+
+        auto getPipelineStageCreateInfo() const -> vk::PipelineShaderStageCreateInfo
+        {
+            return vk::PipelineShaderStageCreateInfo()
+                .setStage(stage)
+                .setPName(entryPoint);
+        }
+    };
+
+    struct DescriptorSet
+    {
+        uint32_t                                        set      = 0;
+        std::span<const vk::DescriptorSetLayoutBinding> bindings = {};
+    };
+
+    struct Pipeline
+    {
+        std::span<const ShaderStage>                        stages           = {};
+        std::span<const DescriptorSet>                      descriptorSets   = {};
+        std::span<const vk::PushConstantRange>              pushConstants    = {};
+        std::span<const vk::VertexInputAttributeDescription> vertexAttributes = {};
+        std::span<const vk::VertexInputBindingDescription>   vertexBindings   = {};
+
+        constexpr auto findBinding(const uint32_t set, const uint32_t binding) const -> const vk::DescriptorSetLayoutBinding*
+        {
+            for (const auto& descriptorSet : descriptorSets)
+            {
+                if (descriptorSet.set != set)
+                {
+                    continue;
+                }
+                for (const auto& layoutBinding : descriptorSet.bindings)
+                {
+                    if (layoutBinding.binding == binding)
+                    {
+                        return &layoutBinding;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @note Intended for static_assert checks of host side set and binding indices against the shaders.
+         */
+        constexpr auto hasBinding(const uint32_t set, const uint32_t binding, const vk::DescriptorType type) const -> bool
+        {
+            const auto* layoutBinding = findBinding(set, binding);
+            return layoutBinding != nullptr && layoutBinding->descriptorType == type;
+        }
+
+        constexpr auto hasVertexAttribute(const uint32_t location, const vk::Format format) const -> bool
+        {
+            for (const auto& attribute : vertexAttributes)
+            {
+                if (attribute.location == location)
+                {
+                    return attribute.format == format;
+                }
+            }
+            return false;
+        }
+    };
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace nbl
+{
+    /**
+     * @note 64-bit hash over a byte range (xxHash64 round structure). The result only depends on the bytes,
+     * so it is stable across runs and can be persisted.
+     */
+    class ReflectionHash
+    {
+    public:
+        static auto hashBytes(const void* data, size_t size, uint64_t seed = 0) -> uint64_t
+        {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            const uint8_t* const end = bytes + size;
+            uint64_t h;
+
+            if (size >= 32)
+            {
+                uint64_t lanes[4] = { seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1 };
+                for (; bytes + 32 <= end; bytes += 32)
+                {
+                    for (uint32_t i = 0; i < 4; ++i)
+                    {
+                        lanes[i] = round(lanes[i], read64(bytes + 8 * i));
+                    }
+                }
+
+                h = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+                for (const uint64_t lane : lanes)
+                {
+                    h = (h ^ round(0, lane)) * kPrime1 + kPrime4;
+                }
+            }
+            else
+            {
+                h = seed + kPrime5;
+            }
+
+            h += static_cast<uint64_t>(size);
+
+            for (; bytes + 8 <= end; bytes += 8)
+            {
+                h = std::rotl(h ^ round(0, read64(bytes)), 27) * kPrime1 + kPrime4;
+            }
+            for (; bytes < end; ++bytes)
+            {
+                h = std::rotl(h ^ (*bytes * kPrime5), 11) * kPrime1;
+            }
+
+            return avalanche(h);
+        }
+
+        static constexpr auto hashCombine(const uint64_t seed, const uint64_t value) -> uint64_t
+        {
+            return avalanche(seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2)));
+        }
+
+    private:
+        static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+        static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+        static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+        static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+        static auto read64(const uint8_t* bytes) -> uint64_t
+        {
+            uint64_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                value = std::byteswap(value);
+            }
+            return value;
+        }
+
+        static constexpr auto round(const uint64_t acc, const uint64_t input) -> uint64_t
+        {
+            return std::rotl(acc + input * kPrime2, 31) * kPrime1;
+        }
+
+        static constexpr auto avalanche(uint64_t h) -> uint64_t
+        {
+            h ^= h >> 33;
+            h *= kPrime2;
+            h ^= h >> 29;
+            h *= 0x165667B19E3779F9ull;
+            h ^= h >> 32;
+            return h;
+        }
+    };
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nbl
+{
+    struct PipelineReflectionData;
+
+    enum class ReflectionPhase : uint32_t
+    {
+        // Mapping or reading a shader file
+        eFileIO,
+        // Hashing the code and looking it up in a ShaderReflectionCache
+        eCacheLookup,
+        // Whole reflection of a single shader, contains the phases below
+        eReflectShader,
+        // spirv-reflect module creation or the SpirvScanner pass
+        eModuleCreate,
+        eResolveDescriptorSets,
+        eResolvePushConstants,
+        eResolveVertexInput,
+        eResolveBlocks,
+        eResolveSpecConstants,
+        eResolveWorkgroup,
+        // SpirvScanner::reflect, resolves everything in one go
+        eFastScanResolve,
+        eMerge,
+        eCount,
+    };
+
+    struct ReflectionEvent
+    {
+        ReflectionPhase phase       = ReflectionPhase::eReflectShader;
+        // Shader file or pipeline label
+        std::string     source;
+        // Nanoseconds since the first recorded event of the process
+        uint64_t        startNs     = 0;
+        uint64_t        durationNs  = 0;
+        uint32_t        threadIndex = 0;
+        uint64_t        bytes       = 0;
+        // Only counted when an allocation counter is installed
+        uint64_t        allocations = 0;
+    };
+
+    struct ShaderReflectionStats
+    {
+        std::string                                                         sourceFile;
+        uint64_t                                                            bytes       = 0;
+        uint32_t                                                            reflections = 0;
+        // File I/O, cache lookup and reflection, nested phases are not counted twice
+        uint64_t                                                            totalNs     = 0;
+        uint64_t                                                            allocations = 0;
+        std::array<uint64_t, static_cast<size_t>(ReflectionPhase::eCount)>  phaseNs     = {};
+    };
+
+    struct PipelineReflectionStats
+    {
+        std::vector<std::string>    shaderFiles;
+        uint64_t                    bytes              = 0;
+        // Sum of the totals of every stage, stages reflected in parallel overlap
+        uint64_t                    reflectNs          = 0;
+        uint64_t                    mergeNs            = 0;
+        size_t                      descriptorSets     = 0;
+        size_t                      descriptorBindings = 0;
+        size_t                      pushConstantRanges = 0;
+        size_t                      conflicts          = 0;
+    };
+
+    /**
+     * Process wide timing and allocation statistics of ShaderReflection.
+     * @note Compiled in with NBL_REFLECT_ENABLE_STATS, otherwise the NBL_REFLECT_STATS_* macros expand to nothing
+     * and isEnabled() is always false. When compiled in, recording additionally has to be switched on with setEnabled().
+     */
+    class ReflectionStats
+    {
+    public:
+        using Callback          = std::function<void(const ReflectionEvent&)>;
+        // Returns a monotonic allocation count, e.g. maintained by the application's operator new
+        using AllocationCounter = uint64_t(*)();
+
+        static auto isEnabled() -> bool
+        {
+#ifdef NBL_REFLECT_ENABLE_STATS
+            return s_enabled.load(std::memory_order_relaxed);
+#else
+            return false;
+#endif
+        }
+
+        static void setEnabled(bool enabled);
+
+        /**
+         * @note Invoked for every event on the recording thread, without any lock held.
+         */
+        static void setCallback(Callback callback);
+
+        static void setAllocationCounter(AllocationCounter counter);
+
+        /**
+         * @note Events beyond the capacity are only passed to the callback and counted as dropped.
+         */
+        static void setEventCapacity(size_t capacity);
+
+        static void reset();
+
+        static auto getEvents()         -> std::vector<ReflectionEvent>;
+        static auto getDroppedEvents()  -> uint64_t;
+
+        /**
+         * @return Per shader summaries, the most expensive shaders first.
+         */
+        static auto getShaderStats()    -> std::vector<ShaderReflectionStats>;
+        static auto getPipelineStats()  -> std::vector<PipelineReflectionStats>;
+
+        /**
+         * @note Chrome trace event format, can be opened in chrome://tracing or Perfetto.
+         */
+        static void writeChromeTrace(std::ostream& out);
+        static void writeChromeTrace(const std::filesystem::path& filePath);
+
+        /**
+         * @note Shader and pipeline summaries as JSON.
+         */
+        static void writeSummary(std::ostream& out);
+        static void writeSummary(const std::filesystem::path& filePath);
+
+        static auto getPhaseName(ReflectionPhase phase) -> const char*;
+
+        static void recordEvent(ReflectionEvent&& event);
+        static void recordPipeline(const PipelineReflectionData& pipeline, uint64_t mergeNs);
+
+        static auto now()               -> uint64_t;
+        static auto allocationCount()   -> uint64_t;
+        static auto threadIndex()       -> uint32_t;
+
+    private:
+        static inline std::atomic<bool> s_enabled = false;
+    };
+
+    /**
+     * Records a ReflectionEvent covering its lifetime, inert when stats are disabled at construction.
+     */
+    class ScopedReflectionTimer
+    {
+    public:
+        ScopedReflectionTimer(ReflectionPhase phase, std::string_view source, uint64_t bytes = 0);
+        ~ScopedReflectionTimer();
+
+        ScopedReflectionTimer(const ScopedReflectionTimer&) = delete;
+        auto operator=(const ScopedReflectionTimer&) -> ScopedReflectionTimer& = delete;
+
+        void setBytes(const uint64_t bytes) { m_bytes = bytes; }
+
+        auto elapsed() const -> uint64_t { return m_active ? ReflectionStats::now() - m_startNs : 0; }
+
+    private:
+        ReflectionPhase     m_phase;
+        std::string_view    m_source;
+        uint64_t            m_bytes       = 0;
+        uint64_t            m_startNs     = 0;
+        uint64_t            m_allocations = 0;
+        bool                m_active      = false;
+    };
+}
+
+#ifdef NBL_REFLECT_ENABLE_STATS
+    #define NBL_REFLECT_STATS_SCOPE(timer, phase, source, bytes) ::nbl::ScopedReflectionTimer timer(phase, source, bytes)
+    #define NBL_REFLECT_STATS_SET_BYTES(timer, bytes) timer.setBytes(bytes)
+    #define NBL_REFLECT_STATS_PIPELINE(pipeline, timer)                                          \
+        do                                                                                      \
+        {                                                                                       \
+            if (::nbl::ReflectionStats::isEnabled())                                            \
+            {                                                                                   \
+                ::nbl::ReflectionStats::recordPipeline(pipeline, timer.elapsed());              \
+            }                                                                                   \
+        } while (0)
+#else
+    #define NBL_REFLECT_STATS_SCOPE(timer, phase, source, bytes)
+    #define NBL_REFLECT_STATS_SET_BYTES(timer, bytes)
+    #define NBL_REFLECT_STATS_PIPELINE(pipeline, timer)
+#endif
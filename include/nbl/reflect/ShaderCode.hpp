@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace nbl
+{
+    /**
+     * View of SPIR-V words with optional shared ownership of the memory backing them.
+     * The words are either owned, memory mapped from a file, or provided by the caller, copying a ShaderCode never copies the words.
+     */
+    class ShaderCode
+    {
+    public:
+        ShaderCode() = default;
+
+        static auto fromWords(std::vector<uint32_t>&& words) -> ShaderCode;
+
+        /**
+         * @note Copies the bytes into 4-byte aligned storage, the size must be a multiple of 4.
+         */
+        static auto fromBytes(std::span<const char> bytes) -> ShaderCode;
+
+        /**
+         * @note Does not copy, the words must outlive every ShaderCode referencing them unless an owner keeps them alive.
+         */
+        static auto fromView(std::span<const uint32_t> words, std::shared_ptr<const void> owner = nullptr) -> ShaderCode;
+
+        /**
+         * @note Reads the whole file into owned, aligned storage.
+         */
+        static auto readFile(const std::string& filePath) -> ShaderCode;
+
+        /**
+         * @note Maps the file read-only, the mapping is released with the last ShaderCode referencing it.
+         * Falls back to readFile on platforms without memory mapping support.
+         */
+        static auto mapFile(const std::string& filePath) -> ShaderCode;
+
+        /**
+         * @note Offset and count are in words, the result shares ownership with this object.
+         */
+        auto subspan(size_t offset, size_t count) const -> ShaderCode { return fromView(m_words.subspan(offset, count), m_owner); }
+
+        auto words()       const -> std::span<const uint32_t> { return m_words; }
+        auto data()        const -> const uint32_t*           { return m_words.data(); }
+        auto sizeInBytes() const -> size_t                    { return m_words.size_bytes(); }
+        auto empty()       const -> bool                      { return m_words.empty(); }
+
+        /**
+         * @return True if the words are kept alive by this object (owned or mapped), false for caller-provided views.
+         */
+        auto ownsMemory()  const -> bool                      { return m_owner != nullptr; }
+
+    private:
+        std::span<const uint32_t>   m_words = {};
+        std::shared_ptr<const void> m_owner = nullptr;
+    };
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ShaderReflection.hpp"
+
+namespace nbl
+{
+    /**
+     * Read-only archive of many shaders in a single file: a name index, deduplicated SPIR-V blobs and serialized reflection records.
+     * The pack is mapped once, shader code is referenced in place and reflection data is only decoded for the entries that are requested.
+     * @note Opening only validates the header, entries are bounds-checked when they are looked up. All methods are safe to call from multiple threads.
+     */
+    class ShaderPack
+    {
+    public:
+        static constexpr uint32_t kMagic         = 0x504C424E; // "NBLP"
+        static constexpr uint32_t kFormatVersion = 1;
+        // Blobs are aligned for direct use as vk::ShaderModuleCreateInfo::pCode
+        static constexpr uint32_t kBlobAlignment = 16;
+
+        /**
+         * @note Takes shared ownership of the pack's memory, every ShaderCode returned by the pack keeps it alive.
+         */
+        explicit ShaderPack(ShaderCode pack);
+
+        /**
+         * @note Memory maps the file.
+         */
+        static auto open(const std::string& filePath) -> ShaderPack;
+
+        auto getEntryCount() const -> size_t { return m_entryCount; }
+        auto getBlobCount()  const -> size_t { return m_blobCount; }
+
+        /**
+         * @note Entries are sorted by name.
+         */
+        auto getEntryName(size_t index) const -> std::string_view;
+        auto contains(std::string_view name) const -> bool;
+
+        /**
+         * @note Does not copy, the code references the pack's memory.
+         */
+        auto getShaderCode(std::string_view name) const -> ShaderCode;
+        auto getCodeHash  (std::string_view name) const -> uint64_t;
+
+        /**
+         * @note Decodes the entry's reflection record, sourceFile is set to the entry name.
+         */
+        auto reflectShader(std::string_view name) const -> ShaderReflectionData;
+
+        /**
+         * @note Only the named entries are decoded, stages are merged like ShaderReflection::reflectPipelineShaders.
+         */
+        auto reflectPipeline(const std::vector<std::string>& names) const -> PipelineReflectionData;
+
+        /**
+         * @note Like reflectPipeline, filePath is the entry name of the module and entry points are looked up by makeEntryName.
+         */
+        auto reflectPipelineStages(const std::vector<ShaderStageSource>& stages) const -> PipelineReflectionData;
+
+        /**
+         * @return Entry name of an entry point of a packed module, "<name>#<entryPoint>". The empty entry point selects the plain name,
+         * which nblReflectPack gives to the module's first entry point.
+         */
+        static auto makeEntryName(std::string_view name, std::string_view entryPoint) -> std::string;
+
+    private:
+        struct Blob
+        {
+            uint64_t codeOffset   = 0;
+            uint64_t codeSize     = 0;
+            uint64_t recordOffset = 0;
+            uint64_t recordSize   = 0;
+            uint64_t codeHash     = 0;
+        };
+
+        auto bytes() const -> const char* { return reinterpret_cast<const char*>(m_pack.data()); }
+        // Index of the entry, the entry count if there is none
+        auto findEntry(std::string_view name) const -> size_t;
+        auto findBlob (std::string_view name) const -> Blob;
+        auto readBlob(uint32_t index) const -> Blob;
+
+        ShaderCode  m_pack;
+        uint32_t    m_entryCount    = 0;
+        uint32_t    m_blobCount     = 0;
+        uint64_t    m_entriesOffset = 0;
+        uint64_t    m_blobsOffset   = 0;
+        uint64_t    m_stringsOffset = 0;
+        uint64_t    m_stringsSize   = 0;
+    };
+
+    /**
+     * Builds a ShaderPack, shaders with identical code share the code, each entry point of it gets its own reflection record.
+     */
+    class ShaderPackWriter
+    {
+    public:
+        /**
+         * @note Serializes the reflected data, shaderName and sourceFile are replaced by the entry name when the pack is read.
+         * Throws if an entry with the same name already exists.
+         */
+        void add(const std::string& name, const ShaderReflectionData& shaderData);
+
+        auto getEntryCount() const -> size_t { return m_entries.size(); }
+        auto getBlobCount()  const -> size_t { return m_blobs.size(); }
+        auto getCodeCount()  const -> size_t { return m_codes.size(); }
+
+        auto build() const -> std::vector<char>;
+        void write(const std::string& filePath) const;
+
+    private:
+        struct Code
+        {
+            ShaderCode  code;
+            uint64_t    codeHash;
+        };
+
+        struct Blob
+        {
+            uint32_t            code;
+            std::string         entryPoint;
+            std::vector<char>   record;
+        };
+
+        // Entry name to blob index
+        std::unordered_map<std::string, uint32_t>            m_entries;
+        // Code hash to the codes with that hash
+        std::unordered_multimap<uint64_t, uint32_t>          m_codesByHash;
+        // Code index and entry point to blob index
+        std::map<std::pair<uint32_t, std::string>, uint32_t> m_blobsByEntryPoint;
+        std::vector<Code>                                    m_codes;
+        std::vector<Blob>                                    m_blobs;
+    };
+}
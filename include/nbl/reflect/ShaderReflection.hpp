@@ -1,10 +1,15 @@
 #pragma once
 
+#include <array>
+#include <functional>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <spirv_reflect.h>
 #include <vulkan/vulkan.hpp>
+#include "ShaderCode.hpp"
 
 namespace nbl
 {
@@ -14,9 +19,209 @@ namespace nbl
         std::vector<vk::DescriptorSetLayoutBinding> bindings = {};
     };
 
+    enum class VertexInputLayout
+    {
+        // All attributes in binding 0, in location order
+        eInterleaved,
+        // Binding N holds only the attribute at the N-th lowest location
+        eBindingPerAttribute,
+        // Bindings and input rates are taken from a caller-supplied list of VertexInputStreams
+        eCustom,
+    };
+
+    struct VertexInputStream
+    {
+        uint32_t                                    location  = 0;
+        uint32_t                                    binding   = 0;
+        vk::VertexInputRate                         inputRate = vk::VertexInputRate::eVertex;
+    };
+
+    struct VertexAttributePackingSuggestion
+    {
+        uint32_t                                    location        = 0;
+        std::string                                 name            = {};
+        vk::Format                                  currentFormat   = vk::Format::eUndefined;
+        vk::Format                                  suggestedFormat = vk::Format::eUndefined;
+        std::string                                 reason          = {};
+    };
+
+    struct VertexInputPackingReport
+    {
+        // Only attributes for which a narrower format is suggested
+        std::vector<VertexAttributePackingSuggestion>   suggestions     = {};
+        // Locations in the suggested interleaved order
+        std::vector<uint32_t>                           suggestedOrder  = {};
+        uint32_t                                        currentStride   = 0;
+        uint32_t                                        suggestedStride = 0;
+    };
+
     struct ShaderReflectionVertexInput
     {
-        std::vector<vk::VertexInputAttributeDescription> attributeDescriptions;
+        // Sorted by location, built-in inputs are not included
+        std::vector<vk::VertexInputAttributeDescription> attributeDescriptions = {};
+        std::vector<vk::VertexInputBindingDescription>   bindingDescriptions   = {};
+        // Parallel to attributeDescriptions, empty for inputs without a debug name
+        std::vector<std::string>                         attributeNames        = {};
+
+        /**
+         * Assigns bindings, offsets and strides for the specified layout, replacing the current binding descriptions.
+         * @note Attributes are naturally aligned within a binding, strides are padded to the largest component size.
+         * For eCustom every location has to be mapped by exactly one stream, and all streams of a binding have to use the same input rate.
+         */
+        void applyLayout(VertexInputLayout layout, std::span<const VertexInputStream> streams = {});
+
+        /**
+         * @return Suggested narrower formats (based on attribute names) and an attribute order that avoids padding in an interleaved layout.
+         * @note Narrower formats are converted back by the vertex fetch, the shader does not have to change. Precision has to be validated by the caller.
+         */
+        auto suggestPacking() const -> VertexInputPackingReport;
+
+        static auto getFormatSize(vk::Format format) -> uint32_t;
+    };
+
+    enum class ShaderBlockType
+    {
+        eUniformBuffer,
+        eStorageBuffer,
+        ePushConstant,
+    };
+
+    struct ShaderReflectionBlockMember
+    {
+        std::string                                 name            = {};
+        // Byte offset from the start of the block, for members of struct arrays the offset within the first element
+        uint32_t                                    offset          = 0;
+        // Unpadded size including all array elements, 0 for runtime arrays
+        uint32_t                                    size            = 0;
+        // Stride between elements of the innermost array dimension, 0 if not an array
+        uint32_t                                    arrayStride     = 0;
+        // Stride between matrix columns (or rows if rowMajor), 0 if not a matrix
+        uint32_t                                    matrixStride    = 0;
+        bool                                        rowMajor        = false;
+        // Outermost dimension first, 0 for a runtime array
+        std::vector<uint32_t>                       arrayDims       = {};
+        // Struct members, empty for scalars, vectors and matrices
+        std::vector<ShaderReflectionBlockMember>    members         = {};
+
+        auto operator==(const ShaderReflectionBlockMember&) const -> bool = default;
+    };
+
+    /**
+     * Member layout of a uniform buffer, storage buffer or push constant block as declared by the shader (std140, std430 or scalar).
+     */
+    struct ShaderReflectionBlock
+    {
+        ShaderBlockType                             type            = ShaderBlockType::eUniformBuffer;
+        // Variable name, empty for anonymous blocks
+        std::string                                 name            = {};
+        // Name of the block's struct type
+        std::string                                 typeName        = {};
+        // Unused for push constants
+        uint32_t                                    set             = 0;
+        uint32_t                                    binding         = 0;
+        // End of the last member, a trailing runtime array is not included
+        uint32_t                                    size            = 0;
+        std::vector<ShaderReflectionBlockMember>    members         = {};
+
+        /**
+         * @note Paths are dot separated member names, e.g. "material.albedo". Array indices are not part of the path.
+         * @return Member at the path, nullptr if there is none.
+         */
+        auto findMember(std::string_view path) const -> const ShaderReflectionBlockMember*;
+
+        auto operator==(const ShaderReflectionBlock&) const -> bool = default;
+    };
+
+    enum class SpecializationConstantType
+    {
+        eBool,
+        eInt,
+        eUint,
+        eFloat,
+    };
+
+    struct ShaderSpecializationConstant
+    {
+        // SpecId decoration, the vk::SpecializationMapEntry::constantID
+        uint32_t                                    constantId      = 0;
+        std::string                                 name            = {};
+        SpecializationConstantType                  type            = SpecializationConstantType::eUint;
+        // Bit width of the scalar, 32 for booleans since they are specialized as VkBool32
+        uint32_t                                    width           = 32;
+        // Bits of the default value in the low-order bits, booleans are 0 or 1
+        uint64_t                                    defaultValue    = 0;
+
+        auto getSize() const -> uint32_t { return width / 8; }
+
+        auto operator==(const ShaderSpecializationConstant&) const -> bool = default;
+    };
+
+    class ShaderSpecialization;
+
+    /**
+     * Workgroup limits of a device, the defaults are the minimum limits guaranteed by Vulkan for compute shaders.
+     */
+    struct WorkgroupLimits
+    {
+        std::array<uint32_t, 3>                     maxWorkgroupSize    = { 128, 128, 64 };
+        uint32_t                                    maxInvocations      = 128;
+        std::array<uint32_t, 3>                     maxWorkgroupCount   = { 65535, 65535, 65535 };
+        uint32_t                                    maxSharedMemorySize = 16384;
+
+        static auto fromDeviceLimits(const vk::PhysicalDeviceLimits& limits) -> WorkgroupLimits;
+
+        /**
+         * @note For eTaskEXT and eMeshEXT stages, the compute limits do not apply to them.
+         */
+        static auto fromMeshShaderProperties(const vk::PhysicalDeviceMeshShaderPropertiesEXT& properties, vk::ShaderStageFlagBits stage) -> WorkgroupLimits;
+    };
+
+    struct ShaderWorkgroupVariable
+    {
+        std::string                                 name                = {};
+        // std430 size with the default values of all specialization constants
+        uint32_t                                    size                = 0;
+        // Set if the outermost array length is a specialization constant, the size is elementSize times its value
+        uint32_t                                    lengthConstantId    = ~0u;
+        uint32_t                                    elementSize         = 0;
+
+        auto operator==(const ShaderWorkgroupVariable&) const -> bool = default;
+    };
+
+    /**
+     * Local workgroup size and workgroup shared memory of a compute, task or mesh shader.
+     */
+    struct ShaderReflectionWorkgroup
+    {
+        // From the WorkgroupSize built-in, LocalSizeId or LocalSize, in that order of precedence
+        std::array<uint32_t, 3>                     localSize            = { 1, 1, 1 };
+        // Constant id of every dimension set by a specialization constant, ~0u for fixed dimensions
+        std::array<uint32_t, 3>                     localSizeConstantIds = { ~0u, ~0u, ~0u };
+        std::vector<ShaderWorkgroupVariable>        sharedVariables      = {};
+        // Sum of the shared variable sizes, the footprint checked against maxComputeSharedMemorySize
+        uint32_t                                    sharedMemorySize     = 0;
+
+        /**
+         * @note Array lengths computed from specialization constants (e.g. N * N) keep their default size.
+         * @return Copy with the local size and shared memory resolved for the specialization's constant values.
+         */
+        auto specialize(const ShaderSpecialization& specialization) const -> ShaderReflectionWorkgroup;
+
+        auto getInvocationCount() const -> uint32_t { return localSize[0] * localSize[1] * localSize[2]; }
+
+        /**
+         * @return Workgroup counts covering the problem size (in invocations), rounded up per dimension.
+         */
+        auto getDispatchSize(const std::array<uint32_t, 3>& problemSize) const -> std::array<uint32_t, 3>;
+
+        /**
+         * @note With a problem size, the workgroup counts of its dispatch are checked as well.
+         * @return One message per exceeded limit, empty if the workgroup fits the device.
+         */
+        auto checkLimits(const WorkgroupLimits& limits, const std::optional<std::array<uint32_t, 3>>& problemSize = std::nullopt) const
+            -> std::vector<std::string>;
+
+        auto operator==(const ShaderReflectionWorkgroup&) const -> bool = default;
     };
 
     struct ShaderReflectionData
@@ -28,27 +233,206 @@ namespace nbl
         std::vector<ShaderReflectionDescriptorSet>  descriptorSets      = {};
         std::vector<vk::PushConstantRange>          pushConstants       = {};
         std::optional<ShaderReflectionVertexInput>  vertexInput         = std::nullopt;
-        std::vector<char>                           shaderCode          = {};
+        // Uniform and storage buffers sorted by set and binding, followed by push constant blocks
+        std::vector<ShaderReflectionBlock>          blocks              = {};
+        // Sorted by constant id
+        std::vector<ShaderSpecializationConstant>   specConstants       = {};
+        // Compute, task and mesh stages only
+        std::optional<ShaderReflectionWorkgroup>    workgroup           = std::nullopt;
+        ShaderCode                                  shaderCode          = {};
+
+        /**
+         * @return Block whose variable or type name matches, nullptr if there is none.
+         */
+        auto findBlock(std::string_view name) const -> const ShaderReflectionBlock*;
 
         auto getShaderModuleCreateInfo()  const -> vk::ShaderModuleCreateInfo;
         auto getPipelineStageCreateInfo() const -> vk::PipelineShaderStageCreateInfo;
     };
 
+    struct ShaderReflectionConflict
+    {
+        uint32_t                                    set             = 0;
+        uint32_t                                    binding         = 0;
+        std::string                                 message         = {};
+    };
+
     struct PipelineReflectionData
     {
         std::vector<ShaderReflectionDescriptorSet>  descriptorSets  = {};
         std::vector<vk::PushConstantRange>          pushConstants   = {};
         std::vector<ShaderReflectionData>           shaderData      = {};
+        // Bindings declared with a different type or descriptor count by different stages
+        std::vector<ShaderReflectionConflict>       conflicts       = {};
+
+        /**
+         * @note Blocks are not merged, the first stage declaring a matching block is used.
+         */
+        auto findBlock(std::string_view name) const -> const ShaderReflectionBlock*;
+    };
+
+    /**
+     * Shader stage of a pipeline, a module with several entry points can back several stages.
+     */
+    struct ShaderStageSource
+    {
+        std::string                                 filePath        = {};
+        // Empty selects the module's first entry point
+        std::string                                 entryPoint      = {};
+    };
+
+    /**
+     * Distinct shader code referenced by a set of pipelines, so every vk::ShaderModule is only created once.
+     */
+    struct ShaderModuleSet
+    {
+        std::vector<ShaderCode>                     modules         = {};
+        // Per pipeline and stage, index into modules or ~0u for stages without code
+        std::vector<std::vector<uint32_t>>          stageModules    = {};
+    };
+
+    class ShaderReflectionCache;
+    class SpirvScanner;
+
+    enum class ReflectionExecutionMode
+    {
+        eSerial,
+        eParallel,
+    };
+
+    enum class ReflectionBackend
+    {
+        // Full module construction through spirv-reflect
+        eSpirvReflect,
+        // Single linear pass over the module's global declarations, function bodies are only scanned
+        // to tell apart the resources of several entry points in modules older than SPIR-V 1.4
+        eFastScan,
     };
 
     class ShaderReflection
     {
     public:
-        static ShaderReflectionData reflectShader(const std::string& filePath);
+        /**
+         * @note The file is memory mapped, shaderCode references the mapping instead of owning a copy.
+         */
+        static ShaderReflectionData reflectShader(const std::string& filePath,
+                                                  ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        /**
+         * @note Reflects already loaded code without copying it, shaderCode shares ownership (or the lack thereof) with the input.
+         */
+        static ShaderReflectionData reflectShader(const ShaderCode& shaderCode, const std::string& sourceName = "Unknown Shader File",
+                                                  ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        /**
+         * @note Non-owning, the caller must keep the words alive for as long as the returned shaderCode is used.
+         */
+        static ShaderReflectionData reflectShader(std::span<const uint32_t> shaderCode, const std::string& sourceName = "Unknown Shader File",
+                                                  ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        /**
+         * @note Looks the module up in the cache first, the backend is only invoked on a miss.
+         */
+        static ShaderReflectionData reflectShader(const std::string& filePath, ShaderReflectionCache& cache,
+                                                  ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        /**
+         * Reflects every entry point of a module, each with its own stage, descriptor usage and push constants.
+         * @note All results share the module's code. With a single entry point the result is the same as reflectShader's,
+         * with several only the resources an entry point statically uses are reported for it.
+         * @return One result per entry point, in declaration order.
+         */
+        static std::vector<ShaderReflectionData> reflectModule(const std::string& filePath,
+                                                               ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        static std::vector<ShaderReflectionData> reflectModule(const ShaderCode& shaderCode, const std::string& sourceName = "Unknown Shader File",
+                                                               ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        /**
+         * @note Reflects every file like reflectModule, in parallel mode every file is reflected on a worker thread.
+         * @return The entry points of every file, in the same order as the input files.
+         */
+        static std::vector<std::vector<ShaderReflectionData>> reflectModuleBatch(const std::vector<std::string>& filePaths,
+                                                                                 ReflectionExecutionMode mode = ReflectionExecutionMode::eParallel,
+                                                                                 ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        /**
+         * @note In parallel mode every module is reflected on a worker thread, the merged result is identical to the serial one.
+         * Stages referencing the same file share a single load and reflection of the module.
+         */
+        static PipelineReflectionData reflectPipelineShaders(const std::vector<std::string>& filePaths,
+                                                             ReflectionExecutionMode mode = ReflectionExecutionMode::eSerial,
+                                                             ShaderReflectionCache* cache = nullptr,
+                                                             ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        static PipelineReflectionData reflectPipelineShaders(const std::vector<ShaderStageSource>& stages,
+                                                             ReflectionExecutionMode mode = ReflectionExecutionMode::eSerial,
+                                                             ShaderReflectionCache* cache = nullptr,
+                                                             ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        /**
+         * @note All modules of all pipelines are scheduled together, results are in the same order as the input pipelines.
+         * Every distinct file is loaded and reflected once, however many stages and pipelines reference it.
+         * A pipeline is merged by the worker finishing its last module, so a slow module only delays the pipelines using it.
+         */
+        static std::vector<PipelineReflectionData> reflectPipelineBatch(const std::vector<std::vector<std::string>>& pipelines,
+                                                                        ReflectionExecutionMode mode = ReflectionExecutionMode::eParallel,
+                                                                        ShaderReflectionCache* cache = nullptr,
+                                                                        ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        static std::vector<PipelineReflectionData> reflectPipelineBatch(const std::vector<std::vector<ShaderStageSource>>& pipelines,
+                                                                        ReflectionExecutionMode mode = ReflectionExecutionMode::eParallel,
+                                                                        ShaderReflectionCache* cache = nullptr,
+                                                                        ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
 
-        static PipelineReflectionData reflectPipelineShaders(const std::vector<std::string>& filePaths);
+        /**
+         * Merges reflected stages into pipeline wide descriptor sets and push constant ranges.
+         * @note Sets and bindings are sorted by number, stage flags are combined per (set, binding) and overlapping push constant ranges are coalesced.
+         * Conflicting declarations are reported in PipelineReflectionData::conflicts, the first declaration's type and the largest count are kept.
+         */
+        static auto mergePipelineShaders(std::vector<ShaderReflectionData>&& shaderData) -> PipelineReflectionData;
+
+        /**
+         * @note Stages are matched by their code's address first, identical code loaded from different files is found by content.
+         * @return Distinct modules of the pipelines and the module of every stage.
+         */
+        static auto collectShaderModules(std::span<const PipelineReflectionData> pipelines) -> ShaderModuleSet;
 
     private:
+        friend class ShaderReflectionCache;
+        friend class ShaderReflectionDatabase;
+        friend class ShaderPack;
+
+        static auto mergeDescriptorSets(const std::vector<ShaderReflectionData>& shaderData,
+                                        std::vector<ShaderReflectionConflict>& conflicts) -> std::vector<ShaderReflectionDescriptorSet>;
+        static auto mergePushConstants (const std::vector<ShaderReflectionData>& shaderData) -> std::vector<vk::PushConstantRange>;
+
+        /**
+         * @note Only the first entry point is reflected unless allEntryPoints is set.
+         */
+        static auto reflectEntryPoints(const ShaderCode& shaderCode, const std::string& sourceName, ReflectionBackend backend,
+                                       bool allEntryPoints) -> std::vector<ShaderReflectionData>;
+
+        /**
+         * @note Throws if the module has no entry point of a requested name.
+         * @return The requested entry points in order, an empty name selects the first entry point.
+         */
+        static auto selectEntryPoints(const std::vector<ShaderReflectionData>& entryPoints, std::span<const std::string> names,
+                                      const std::string& filePath) -> std::vector<ShaderReflectionData>;
+
+        /**
+         * Resources of a single entry point, or of the whole module if it has only one.
+         */
+        struct SpvEntryPointResources
+        {
+            vk::ShaderStageFlagBits                       shaderStage    = vk::ShaderStageFlagBits::eVertex;
+            std::span<const SpvReflectDescriptorSet>      descriptorSets = {};
+            std::vector<const SpvReflectBlockVariable*>   pushConstants  = {};
+            std::span<SpvReflectInterfaceVariable* const> inputVariables = {};
+        };
+
+        static auto getEntryPointResources(const SpvReflectShaderModule& shaderModule, uint32_t entryPoint) -> SpvEntryPointResources;
+
         // ==============================
         // Resolve Shader data types
         // ==============================
@@ -57,19 +441,33 @@ namespace nbl
          * @note When constructing a pipeline from multiple shaders the shader stages need to be correctly merged across descriptors.
          * @return List of Descriptor Sets found in the specified Shader.
          */
-        static auto resolveDescriptorSets(const SpvReflectShaderModule& shaderModule) -> std::vector<ShaderReflectionDescriptorSet>;
+        static auto resolveDescriptorSets(const SpvEntryPointResources& resources) -> std::vector<ShaderReflectionDescriptorSet>;
 
         /**
          * @note When constructing a pipeline from multiple shaders the shader stages need to be correctly merged across push constants.
          * @return List of Push Constants found in the specified Shader.
          */
-        static auto resolvePushConstants (const SpvReflectShaderModule& shaderModule) -> std::vector<vk::PushConstantRange>;
+        static auto resolvePushConstants (const SpvEntryPointResources& resources) -> std::vector<vk::PushConstantRange>;
 
         /**
-         * @note This method does NOT resolve binding descriptions and must be manually set.
-         * @return List of VertexInputAttributeDescriptions found in the specified Shader.
+         * @note Binding descriptions are resolved for an interleaved layout, use ShaderReflectionVertexInput::applyLayout for other layouts.
+         * @return Vertex input attributes found in the specified Shader, sorted by location.
          */
-        static auto resolveVertexInput   (const SpvReflectShaderModule& shaderModule) -> ShaderReflectionVertexInput;
+        static auto resolveVertexInput   (const SpvEntryPointResources& resources) -> ShaderReflectionVertexInput;
+
+        /**
+         * @note Member sizes are computed from the member types, not taken from spirv-reflect's padded sizes.
+         * @return Member layouts of the uniform buffers, storage buffers and push constant blocks found in the specified Shader.
+         */
+        static auto resolveBlocks        (const SpvEntryPointResources& resources) -> std::vector<ShaderReflectionBlock>;
+        static auto resolveBlockMembers  (const SpvReflectBlockVariable& block, uint32_t baseOffset) -> std::vector<ShaderReflectionBlockMember>;
+
+        /**
+         * @note spirv-reflect only reports constant ids and names, types and default values are read from the code by the scanner.
+         * @return Specialization constants found in the specified Shader, sorted by constant id.
+         */
+        static auto resolveSpecializationConstants(const SpvReflectShaderModule& shaderModule, const SpirvScanner& scanner)
+            -> std::vector<ShaderSpecializationConstant>;
 
         // ==============================
         // Conversion Methods
@@ -82,6 +480,12 @@ namespace nbl
         // Utilities
         // ==============================
         static auto getShaderNameFromFilePath(const std::string& filePath) -> std::string;
-        static auto loadShaderBytes          (const std::string& filePath) -> std::vector<char>;
+
+        /**
+         * @note Invokes the task once for every index, in parallel mode the largest files are picked up first.
+         * The first exception thrown by a task is rethrown on the calling thread after all workers have finished.
+         */
+        static void forEachShaderFile(const std::vector<const std::string*>& filePaths, ReflectionExecutionMode mode,
+                                      const std::function<void(size_t)>& task);
     };
 }
\ No newline at end of file
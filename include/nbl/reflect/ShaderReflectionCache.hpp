@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include "ShaderReflection.hpp"
+
+namespace nbl
+{
+    /**
+     * Content-addressed cache of reflection results, keyed by a hash of the SPIR-V bytes.
+     * Entries are kept in memory and, if a directory is specified, also persisted as one binary record per module.
+     * @note All methods are safe to call from multiple threads.
+     */
+    class ShaderReflectionCache
+    {
+    public:
+        explicit ShaderReflectionCache(std::optional<std::filesystem::path> directory = std::nullopt);
+
+        /**
+         * @note On a hit spirv-reflect is not invoked, the record is combined with the freshly mapped shader code.
+         */
+        auto reflectShader(const std::string& filePath, ReflectionBackend backend = ReflectionBackend::eSpirvReflect) -> ShaderReflectionData;
+
+        /**
+         * @note The module is mapped and hashed once for all entry points, a miss reflects and stores every entry point of the module.
+         * @return One result per requested entry point, an empty name selects the module's first entry point.
+         */
+        auto reflectEntryPoints(const std::string& filePath, std::span<const std::string> entryPoints,
+                                ReflectionBackend backend = ReflectionBackend::eSpirvReflect) -> std::vector<ShaderReflectionData>;
+
+        /**
+         * @note Same as the file overload for code the caller already loaded, codeHash has to be hashCode(shaderCode).
+         */
+        auto reflectEntryPoints(const ShaderCode& shaderCode, uint64_t codeHash, const std::string& sourceName, std::span<const std::string> entryPoints,
+                                ReflectionBackend backend = ReflectionBackend::eSpirvReflect) -> std::vector<ShaderReflectionData>;
+
+        /**
+         * @note Entries are stored per entry point name and backend, the empty name stands for the module's first entry point.
+         * The backends are not guaranteed to produce identical results, an entry is only found for the backend it was stored with.
+         */
+        auto find (uint64_t codeHash, size_t codeSize, std::string_view entryPoint = {},
+                   ReflectionBackend backend = ReflectionBackend::eSpirvReflect) -> std::optional<ShaderReflectionData>;
+        void store(uint64_t codeHash, size_t codeSize, const ShaderReflectionData& shaderData, std::string_view entryPoint = {},
+                   ReflectionBackend backend = ReflectionBackend::eSpirvReflect);
+
+        /**
+         * @note Removes all in-memory entries, persisted entries are kept.
+         */
+        void clear();
+
+        auto getHitCount()  const -> uint64_t { return m_hits.load(std::memory_order_relaxed); }
+        auto getMissCount() const -> uint64_t { return m_misses.load(std::memory_order_relaxed); }
+
+        static auto hashCode(const ShaderCode& shaderCode) -> uint64_t;
+
+    private:
+        struct CacheKey
+        {
+            uint64_t codeHash   = 0;
+            uint64_t codeSize   = 0;
+            // Hash of the entry point name, 0 for the first entry point
+            uint64_t entryPoint = 0;
+            // ReflectionBackend the entry was reflected with
+            uint64_t backend    = 0;
+
+            auto operator==(const CacheKey&) const -> bool = default;
+        };
+
+        struct CacheKeyHash
+        {
+            auto operator()(const CacheKey& key) const -> size_t { return key.codeHash ^ key.codeSize ^ key.entryPoint ^ key.backend; }
+        };
+
+        static auto getKey(uint64_t codeHash, size_t codeSize, std::string_view entryPoint, ReflectionBackend backend) -> CacheKey;
+
+        auto getEntryPath(const CacheKey& key) const -> std::filesystem::path;
+        auto loadEntry   (const CacheKey& key) const -> std::optional<ShaderReflectionData>;
+        void saveEntry   (const CacheKey& key, const ShaderReflectionData& shaderData) const;
+
+        std::optional<std::filesystem::path>                           m_directory;
+        std::unordered_map<CacheKey, ShaderReflectionData, CacheKeyHash> m_entries;
+        mutable std::shared_mutex                                      m_mutex;
+        std::atomic<uint64_t>                                          m_hits   = 0;
+        std::atomic<uint64_t>                                          m_misses = 0;
+    };
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "ShaderReflection.hpp"
+
+namespace nbl
+{
+    class ShaderReflectionCache;
+
+    /**
+     * What changed in a shader or pipeline on reload, decides which Vulkan objects have to be recreated.
+     */
+    enum class ReflectionChangeFlags : uint32_t
+    {
+        eNone               = 0,
+        // SPIR-V changed, shader modules and pipelines have to be recreated
+        eCode               = 1 << 0,
+        // Shader stage or entry point name changed
+        eStage              = 1 << 1,
+        // Descriptor set layouts and therefore the pipeline layout changed
+        eDescriptorLayout   = 1 << 2,
+        // Push constant ranges and therefore the pipeline layout changed
+        ePushConstants      = 1 << 3,
+        // Vertex input state of the pipeline changed
+        eVertexInput        = 1 << 4,
+        // Member layout of a uniform, storage or push constant block changed, BlockWriter handles have to be resolved again
+        eBlockLayout        = 1 << 5,
+        // Specialization constant ids, types or default values changed, specialization infos have to be rebuilt
+        eSpecialization     = 1 << 6,
+        // Workgroup size or shared memory footprint changed, dispatch sizes and limit checks have to be redone
+        eWorkgroup          = 1 << 7,
+    };
+
+    constexpr auto operator|(const ReflectionChangeFlags lhs, const ReflectionChangeFlags rhs) -> ReflectionChangeFlags
+    {
+        return static_cast<ReflectionChangeFlags>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+    }
+
+    constexpr auto operator&(const ReflectionChangeFlags lhs, const ReflectionChangeFlags rhs) -> ReflectionChangeFlags
+    {
+        return static_cast<ReflectionChangeFlags>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+    }
+
+    constexpr auto operator|=(ReflectionChangeFlags& lhs, const ReflectionChangeFlags rhs) -> ReflectionChangeFlags&
+    {
+        return lhs = lhs | rhs;
+    }
+
+    constexpr auto hasChange(const ReflectionChangeFlags flags, const ReflectionChangeFlags change) -> bool
+    {
+        return (flags & change) != ReflectionChangeFlags::eNone;
+    }
+
+    using PipelineId = uint32_t;
+
+    struct ShaderReflectionChange
+    {
+        std::string             filePath;
+        // Entry point as requested by the pipelines, empty for the module's first entry point
+        std::string             entryPoint;
+        ReflectionChangeFlags   changes = ReflectionChangeFlags::eNone;
+    };
+
+    struct PipelineReflectionChange
+    {
+        PipelineId              pipeline = 0;
+        ReflectionChangeFlags   changes  = ReflectionChangeFlags::eNone;
+    };
+
+    struct ShaderReflectionError
+    {
+        std::string filePath;
+        std::string message;
+    };
+
+    struct ReflectionDatabaseUpdate
+    {
+        std::vector<ShaderReflectionChange>     shaders;
+        std::vector<PipelineReflectionChange>   pipelines;
+        // Files that failed to reflect keep their previous data and are retried on the next poll
+        std::vector<ShaderReflectionError>      errors;
+
+        auto empty() const -> bool { return shaders.empty() && pipelines.empty() && errors.empty(); }
+    };
+
+    /**
+     * Reflection results of a set of pipelines that are kept up to date as their shader files change.
+     * Each file is reflected once no matter how many pipelines use it, on change only that module is
+     * reflected again and only the pipelines using it are merged again.
+     * Modules with several entry points are diffed per entry point used by the pipelines.
+     * Changes are detected with inotify on Linux and by polling modification times elsewhere.
+     * @note Not thread-safe, poll() and the accessors are meant to be called from a single thread.
+     */
+    class ShaderReflectionDatabase
+    {
+    public:
+        explicit ShaderReflectionDatabase(ReflectionBackend backend = ReflectionBackend::eSpirvReflect, ShaderReflectionCache* cache = nullptr);
+        ~ShaderReflectionDatabase();
+
+        ShaderReflectionDatabase(const ShaderReflectionDatabase&) = delete;
+        auto operator=(const ShaderReflectionDatabase&) -> ShaderReflectionDatabase& = delete;
+
+        auto addPipeline(const std::vector<std::string>& filePaths) -> PipelineId;
+        auto addPipeline(const std::vector<ShaderStageSource>& stages) -> PipelineId;
+
+        auto getPipeline(PipelineId pipeline) const -> const PipelineReflectionData&;
+
+        /**
+         * @note An empty entry point selects the module's first entry point, other entry points must be used by a pipeline.
+         */
+        auto getShader(const std::string& filePath, const std::string& entryPoint = {}) const -> const ShaderReflectionData&;
+        auto getPipelineCount() const -> size_t { return m_pipelines.size(); }
+
+        /**
+         * Non-blocking, picks up every file change since the last call.
+         */
+        auto poll() -> ReflectionDatabaseUpdate;
+
+        /**
+         * Reloads the given files regardless of whether a change was observed, files with identical contents are skipped.
+         */
+        auto reload(const std::vector<std::string>& filePaths) -> ReflectionDatabaseUpdate;
+
+        auto isUsingInotify() const -> bool { return m_inotify >= 0; }
+
+        static auto diffShader(const ShaderReflectionData& previous, const ShaderReflectionData& current) -> ReflectionChangeFlags;
+        static auto diffPipeline(const PipelineReflectionData& previous, const PipelineReflectionData& current) -> ReflectionChangeFlags;
+
+    private:
+        struct ShaderEntry
+        {
+            std::string                         filePath;
+            // Entry points used by the pipelines and their reflection results, in the same order
+            std::vector<std::string>            entryPoints;
+            std::vector<ShaderReflectionData>   data;
+            uint64_t                            codeHash   = 0;
+            std::filesystem::file_time_type     writeTime  = {};
+            uintmax_t                           fileSize   = 0;
+            std::vector<PipelineId>             pipelines;
+        };
+
+        struct PipelineEntry
+        {
+            // File paths are replaced by their keys
+            std::vector<ShaderStageSource>  stages;
+            PipelineReflectionData          data;
+        };
+
+        static auto getKey(const std::string& filePath) -> std::string;
+        static auto findEntryPoint(const ShaderEntry& shader, const std::string& entryPoint) -> const ShaderReflectionData*;
+
+        auto loadShader(const std::string& filePath, std::span<const std::string> entryPoints, uint64_t& codeHash) const -> std::vector<ShaderReflectionData>;
+        auto mergePipeline(const PipelineEntry& pipeline) const -> PipelineReflectionData;
+        void watch(const std::string& key);
+        auto collectChanges() -> std::vector<std::string>;
+        auto reloadKeys(const std::vector<std::string>& keys) -> ReflectionDatabaseUpdate;
+
+        ReflectionBackend                               m_backend;
+        ShaderReflectionCache*                          m_cache;
+        std::unordered_map<std::string, ShaderEntry>    m_shaders;
+        std::vector<PipelineEntry>                      m_pipelines;
+        std::unordered_set<std::string>                 m_retry;
+
+        // inotify descriptor and watched directories, -1 when polling modification times
+        int                                             m_inotify = -1;
+        std::unordered_map<int, std::string>            m_watchedDirectories;
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include "ShaderReflection.hpp"
+
+namespace nbl
+{
+    /**
+     * Compact binary encoding of the reflected parts of ShaderReflectionData.
+     * @note shaderName, sourceFile and shaderCode are not part of the record, they belong to the file the record was created from.
+     */
+    class ShaderReflectionSerializer
+    {
+    public:
+        static constexpr uint32_t kMagic         = 0x524C424E; // "NBLR"
+        static constexpr uint32_t kFormatVersion = 5;
+
+        static auto serialize(const ShaderReflectionData& shaderData) -> std::vector<char>;
+
+        /**
+         * @return False if the record is truncated, corrupt or was written by a different format version.
+         */
+        static auto deserialize(std::span<const char> record, ShaderReflectionData& shaderData) -> bool;
+    };
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ShaderReflection.hpp"
+
+namespace nbl
+{
+    /**
+     * Identifies a specialization by its effective constant values. Constants set to their default value
+     * and names the shader does not declare do not change the key, so equal keys can share a pipeline.
+     */
+    struct SpecializationKey
+    {
+        // (stage index, constant id) and value bits of every constant that differs from its default, sorted
+        std::vector<std::pair<uint64_t, uint64_t>> values = {};
+        uint64_t                                   hash   = 0;
+
+        auto operator==(const SpecializationKey& other) const -> bool { return hash == other.hash && values == other.values; }
+    };
+
+    struct SpecializationKeyHash
+    {
+        auto operator()(const SpecializationKey& key) const -> size_t { return static_cast<size_t>(key.hash); }
+    };
+
+    /**
+     * Builds the vk::SpecializationInfo of a single shader stage from named or numbered constant values.
+     * @note Values are converted to the reflected type of the constant, integers are range checked.
+     * Only constants that differ from their default value are specialized.
+     */
+    class ShaderSpecialization
+    {
+    public:
+        explicit ShaderSpecialization(std::span<const ShaderSpecializationConstant> constants);
+        explicit ShaderSpecialization(const ShaderReflectionData& shaderData) : ShaderSpecialization(shaderData.specConstants) {}
+
+        template <typename T> requires std::is_arithmetic_v<T>
+        auto set(const std::string_view name, const T value) -> ShaderSpecialization&
+        {
+            const size_t index = getIndex(name);
+            return setBits(index, convert(index, value));
+        }
+
+        template <typename T> requires std::is_arithmetic_v<T>
+        auto set(const uint32_t constantId, const T value) -> ShaderSpecialization&
+        {
+            const size_t index = getIndex(constantId);
+            return setBits(index, convert(index, value));
+        }
+
+        /**
+         * @note Restores the default values of all constants.
+         */
+        void reset();
+
+        auto hasConstant(std::string_view name) const -> bool;
+        auto hasConstant(uint32_t constantId)   const -> bool;
+
+        /**
+         * @return Value bits of the constant, in the low-order bits.
+         */
+        auto getValue(std::string_view name) const -> uint64_t { return m_values[getIndex(name)]; }
+        auto getValue(uint32_t constantId)   const -> uint64_t { return m_values[getIndex(constantId)]; }
+
+        /**
+         * @note Points into this object, it has to outlive the pipeline creation and must not be modified until then.
+         * @return Map entries and data of the constants that differ from their default value.
+         */
+        auto getSpecializationInfo() const -> vk::SpecializationInfo;
+
+        /**
+         * @param stage Distinguishes stages when the keys of several stages are combined.
+         */
+        auto getKey(uint32_t stage = 0) const -> SpecializationKey;
+
+        auto getConstants() const -> std::span<const ShaderSpecializationConstant> { return m_constants; }
+
+    private:
+        auto getIndex(std::string_view name) const -> size_t;
+        auto getIndex(uint32_t constantId)   const -> size_t;
+        auto setBits(size_t index, uint64_t bits) -> ShaderSpecialization&;
+        void update();
+
+        template <typename T>
+        auto convert(const size_t index, const T value) const -> uint64_t
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return convertBool(index, value);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                return convertFloat(index, static_cast<double>(value));
+            }
+            else if constexpr (std::is_signed_v<T>)
+            {
+                return convertInt(index, static_cast<int64_t>(value));
+            }
+            else
+            {
+                return convertUint(index, static_cast<uint64_t>(value));
+            }
+        }
+
+        auto convertBool (size_t index, bool value)     const -> uint64_t;
+        auto convertInt  (size_t index, int64_t value)  const -> uint64_t;
+        auto convertUint (size_t index, uint64_t value) const -> uint64_t;
+        auto convertFloat(size_t index, double value)   const -> uint64_t;
+
+        std::vector<ShaderSpecializationConstant>   m_constants;
+        std::vector<uint64_t>                       m_values;
+        std::vector<vk::SpecializationMapEntry>     m_entries;
+        std::vector<std::byte>                      m_data;
+    };
+
+    /**
+     * Specializations of every stage of a pipeline, a named value is applied to each stage declaring the constant.
+     * @note Throws if no stage declares the constant. Keys are only comparable between specializations of the same pipeline.
+     */
+    class PipelineSpecialization
+    {
+    public:
+        explicit PipelineSpecialization(const PipelineReflectionData& pipelineData);
+
+        template <typename T> requires std::is_arithmetic_v<T>
+        auto set(const std::string_view name, const T value) -> PipelineSpecialization&
+        {
+            bool found = false;
+            for (auto& stage : m_stages)
+            {
+                if (stage.hasConstant(name))
+                {
+                    stage.set(name, value);
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                throwUnknownConstant(name);
+            }
+            return *this;
+        }
+
+        void reset();
+
+        auto getStageCount() const -> size_t { return m_stages.size(); }
+        auto getStage(size_t stage) -> ShaderSpecialization& { return m_stages.at(stage); }
+        auto getStage(size_t stage) const -> const ShaderSpecialization& { return m_stages.at(stage); }
+
+        /**
+         * @note In the order of PipelineReflectionData::shaderData.
+         */
+        auto getSpecializationInfo(size_t stage) const -> vk::SpecializationInfo { return m_stages.at(stage).getSpecializationInfo(); }
+
+        auto getKey() const -> SpecializationKey;
+
+    private:
+        [[noreturn]] static void throwUnknownConstant(std::string_view name);
+
+        std::vector<ShaderSpecialization> m_stages;
+    };
+}
@@ -0,0 +1,222 @@
+#include "reflect/BlockWriter.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace nbl
+{
+    namespace
+    {
+        // Stride of the given array dimension, the reflected stride is the one of the innermost dimension
+        auto getDimensionStride(const ShaderReflectionBlockMember& member, const size_t dimension) -> uint32_t
+        {
+            uint32_t stride = member.arrayStride;
+            for (size_t d = dimension + 1; d < member.arrayDims.size(); ++d)
+            {
+                stride *= member.arrayDims[d];
+            }
+            return stride;
+        }
+    }
+
+    BlockWriter::BlockWriter(const ShaderReflectionBlock& block, const uint32_t runtimeArrayLength)
+        : m_block(block)
+    {
+        uint32_t size = block.size;
+        if (block.type != ShaderBlockType::ePushConstant && runtimeArrayLength > 0)
+        {
+            // Only the last member of a storage buffer may be a runtime array
+            const auto it = std::ranges::find_if(block.members, [](const ShaderReflectionBlockMember& member) {
+                return !member.arrayDims.empty() && member.arrayDims.front() == 0;
+            });
+            if (it != std::end(block.members))
+            {
+                size = std::max(size, it->offset + runtimeArrayLength * getDimensionStride(*it, 0));
+            }
+        }
+
+        // Dirty ranges are aligned to 4 bytes, the storage has to cover the aligned end
+        m_data.resize((size + 3) & ~3u);
+    }
+
+    auto BlockWriter::findMember(const ShaderReflectionBlock& block, const std::string_view path) -> BlockMemberHandle
+    {
+        const std::vector<ShaderReflectionBlockMember>* scope = &block.members;
+        // Offset added by the indices of enclosing arrays, member offsets refer to their first element
+        uint32_t elementOffset = 0;
+        BlockMemberHandle handle;
+
+        size_t pos = 0;
+        while (true)
+        {
+            const size_t nameEnd = std::min(path.find_first_of(".[", pos), path.size());
+            const std::string_view name = path.substr(pos, nameEnd - pos);
+
+            const auto it = std::ranges::find(*scope, name, &ShaderReflectionBlockMember::name);
+            if (name.empty() || it == std::end(*scope))
+            {
+                return {};
+            }
+            const ShaderReflectionBlockMember& member = *it;
+
+            handle.offset = member.offset + elementOffset;
+            handle.size   = member.size;
+            pos = nameEnd;
+
+            size_t dimension = 0;
+            while (pos < path.size() && path[pos] == '[')
+            {
+                uint32_t index = 0;
+                const char* first = path.data() + pos + 1;
+                const char* last  = path.data() + path.size();
+                const auto [ptr, ec] = std::from_chars(first, last, index);
+                if (ec != std::errc() || ptr == last || *ptr != ']' || dimension >= member.arrayDims.size() || member.arrayStride == 0)
+                {
+                    return {};
+                }
+
+                const uint32_t length = member.arrayDims[dimension];
+                if (length != 0 && index >= length)
+                {
+                    return {};
+                }
+
+                const uint32_t stride = getDimensionStride(member, dimension);
+                handle.offset += index * stride;
+                elementOffset += index * stride;
+                handle.size    = stride;
+                pos = static_cast<size_t>(ptr - path.data()) + 1;
+                ++dimension;
+            }
+
+            if (pos == path.size())
+            {
+                return handle;
+            }
+
+            // Members of struct arrays can only be reached through an element
+            if (path[pos] != '.' || dimension != member.arrayDims.size())
+            {
+                return {};
+            }
+            scope = &member.members;
+            ++pos;
+        }
+    }
+
+    void BlockWriter::write(const BlockMemberHandle handle, const void* data, const uint32_t size)
+    {
+        checkRange(handle, size);
+
+        // Writing unchanged values does not cause an upload
+        std::byte* destination = m_data.data() + handle.offset;
+        if (std::memcmp(destination, data, size) == 0)
+        {
+            return;
+        }
+        std::memcpy(destination, data, size);
+        markDirty({ handle.offset, size });
+    }
+
+    void BlockWriter::read(const BlockMemberHandle handle, void* data, const uint32_t size) const
+    {
+        checkRange(handle, size);
+        std::memcpy(data, m_data.data() + handle.offset, size);
+    }
+
+    void BlockWriter::markDirty(const BlockRange range)
+    {
+        uint32_t begin = std::min(range.offset, size());
+        uint32_t end   = std::min(range.offset + range.size, size());
+        if (begin >= end)
+        {
+            return;
+        }
+
+        // Ranges are kept sorted, overlapping and adjacent ranges are joined
+        auto first = std::ranges::find_if(m_dirty, [&](const BlockRange& dirty) { return dirty.offset + dirty.size >= begin; });
+        auto last  = first;
+        for (; last != std::end(m_dirty) && last->offset <= end; ++last)
+        {
+            begin = std::min(begin, last->offset);
+            end   = std::max(end, last->offset + last->size);
+        }
+
+        first = m_dirty.erase(first, last);
+        m_dirty.insert(first, { begin, end - begin });
+    }
+
+    auto BlockWriter::getDirtyRanges(uint32_t alignment, const uint32_t mergeGap) const -> std::vector<BlockRange>
+    {
+        alignment = std::max(alignment, 1u);
+
+        std::vector<BlockRange> result;
+        for (const BlockRange& dirty : m_dirty)
+        {
+            const uint32_t begin = dirty.offset / alignment * alignment;
+            const uint32_t end   = std::min((dirty.offset + dirty.size + alignment - 1) / alignment * alignment, size());
+
+            if (!result.empty() && begin <= result.back().offset + result.back().size + mergeGap)
+            {
+                result.back().size = std::max(result.back().offset + result.back().size, end) - result.back().offset;
+            }
+            else
+            {
+                result.push_back({ begin, end - begin });
+            }
+        }
+
+        return result;
+    }
+
+    auto BlockWriter::getPushConstantUpdates(const std::span<const vk::PushConstantRange> ranges) const -> std::vector<PushConstantUpdate>
+    {
+        // vkCmdPushConstants requires offsets and sizes to be multiples of 4
+        std::vector<PushConstantUpdate> result;
+        for (const BlockRange& dirty : getDirtyRanges(4))
+        {
+            for (const auto& range : ranges)
+            {
+                const uint32_t begin = std::max(dirty.offset, range.offset);
+                const uint32_t end   = std::min(dirty.offset + dirty.size, range.offset + range.size);
+                if (begin < end)
+                {
+                    result.push_back({
+                        .stageFlags = range.stageFlags,
+                        .offset     = begin,
+                        .size       = end - begin,
+                        .pValues    = m_data.data() + begin,
+                    });
+                }
+            }
+        }
+
+        return result;
+    }
+
+    auto BlockWriter::checkedMember(const std::string_view path) const -> BlockMemberHandle
+    {
+        const BlockMemberHandle handle = findMember(path);
+        if (!handle.isValid())
+        {
+            throw std::runtime_error("Block " + (m_block.name.empty() ? m_block.typeName : m_block.name) + " has no member " + std::string(path));
+        }
+        return handle;
+    }
+
+    void BlockWriter::checkRange(const BlockMemberHandle handle, const uint32_t size) const
+    {
+        if (!handle.isValid())
+        {
+            throw std::runtime_error("Invalid block member handle.");
+        }
+        if (size > handle.size || static_cast<size_t>(handle.offset) + size > m_data.size())
+        {
+            throw std::runtime_error("Block member access of " + std::to_string(size) + " bytes at offset "
+                                     + std::to_string(handle.offset) + " is out of bounds.");
+        }
+    }
+}
@@ -0,0 +1,181 @@
+#include "reflect/DescriptorLayoutRegistry.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include "reflect/ReflectionHash.hpp"
+
+namespace nbl
+{
+    namespace
+    {
+        auto bindingKey(const vk::DescriptorSetLayoutBinding& b)
+        {
+            return std::make_tuple(b.binding, static_cast<uint32_t>(b.descriptorType), b.descriptorCount, static_cast<uint32_t>(b.stageFlags));
+        }
+
+        auto pushConstantKey(const vk::PushConstantRange& pc)
+        {
+            return std::make_tuple(pc.offset, pc.size, static_cast<uint32_t>(pc.stageFlags));
+        }
+    }
+
+    auto DescriptorLayoutRegistry::internSetLayout(const ShaderReflectionDescriptorSet& descriptorSet) -> DescriptorSetLayoutHandle
+    {
+        auto bindings = descriptorSet.bindings;
+        std::ranges::sort(bindings, {}, bindingKey);
+
+        std::scoped_lock lock(m_mutex);
+        return internSortedSetLayout(std::move(bindings));
+    }
+
+    auto DescriptorLayoutRegistry::internPipelineLayout(const PipelineReflectionData& pipelineData) -> PipelineLayoutHandle
+    {
+        InternedPipelineLayout layout;
+
+        uint32_t nSets = 0;
+        for (const auto& descriptorSet : pipelineData.descriptorSets)
+        {
+            nSets = std::max(nSets, descriptorSet.set + 1);
+        }
+
+        std::vector<std::vector<vk::DescriptorSetLayoutBinding>> setBindings(nSets);
+        for (const auto& descriptorSet : pipelineData.descriptorSets)
+        {
+            auto& bindings = setBindings[descriptorSet.set];
+            bindings.insert(std::end(bindings), std::begin(descriptorSet.bindings), std::end(descriptorSet.bindings));
+        }
+
+        layout.pushConstants = pipelineData.pushConstants;
+        std::ranges::sort(layout.pushConstants, {}, pushConstantKey);
+
+        std::scoped_lock lock(m_mutex);
+
+        std::vector<uint64_t> setLayoutHashes;
+        setLayoutHashes.reserve(nSets);
+        for (auto& bindings : setBindings)
+        {
+            std::ranges::sort(bindings, {}, bindingKey);
+            const auto handle = internSortedSetLayout(std::move(bindings));
+            layout.setLayouts.push_back(handle);
+            setLayoutHashes.push_back(m_setLayouts[handle.index].hash);
+        }
+        layout.hash = hashPipelineLayout(setLayoutHashes, layout.pushConstants);
+
+        const auto [first, last] = m_pipelineLayoutLookup.equal_range(layout.hash);
+        for (auto it = first; it != last; ++it)
+        {
+            const auto& existing = m_pipelineLayouts[it->second];
+            if (existing.setLayouts == layout.setLayouts
+                && std::ranges::equal(existing.pushConstants, layout.pushConstants, {}, pushConstantKey, pushConstantKey))
+            {
+                return { it->second };
+            }
+        }
+
+        const auto index = static_cast<uint32_t>(m_pipelineLayouts.size());
+        m_pipelineLayoutLookup.emplace(layout.hash, index);
+        m_pipelineLayouts.push_back(std::move(layout));
+        return { index };
+    }
+
+    auto DescriptorLayoutRegistry::getSetLayout(const DescriptorSetLayoutHandle handle) const -> const InternedDescriptorSetLayout&
+    {
+        std::scoped_lock lock(m_mutex);
+        if (handle.index >= m_setLayouts.size())
+        {
+            throw std::runtime_error("Invalid descriptor set layout handle: " + std::to_string(handle.index));
+        }
+        return m_setLayouts[handle.index];
+    }
+
+    auto DescriptorLayoutRegistry::getPipelineLayout(const PipelineLayoutHandle handle) const -> const InternedPipelineLayout&
+    {
+        std::scoped_lock lock(m_mutex);
+        if (handle.index >= m_pipelineLayouts.size())
+        {
+            throw std::runtime_error("Invalid pipeline layout handle: " + std::to_string(handle.index));
+        }
+        return m_pipelineLayouts[handle.index];
+    }
+
+    auto DescriptorLayoutRegistry::getSetLayoutCount() const -> size_t
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_setLayouts.size();
+    }
+
+    auto DescriptorLayoutRegistry::getPipelineLayoutCount() const -> size_t
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_pipelineLayouts.size();
+    }
+
+    auto DescriptorLayoutRegistry::isCompatibleForSet(const PipelineLayoutHandle a, const PipelineLayoutHandle b, const uint32_t set) const -> bool
+    {
+        if (a == b)
+        {
+            return true;
+        }
+
+        const auto& layoutA = getPipelineLayout(a);
+        const auto& layoutB = getPipelineLayout(b);
+        if (set >= layoutA.setLayouts.size() || set >= layoutB.setLayouts.size())
+        {
+            return false;
+        }
+
+        // Identical push constant ranges and identical set layouts for every set up to and including the requested one
+        return std::ranges::equal(layoutA.pushConstants, layoutB.pushConstants, {}, pushConstantKey, pushConstantKey)
+            && std::equal(std::begin(layoutA.setLayouts), std::begin(layoutA.setLayouts) + set + 1, std::begin(layoutB.setLayouts));
+    }
+
+    auto DescriptorLayoutRegistry::hashSetLayout(const std::span<const vk::DescriptorSetLayoutBinding> bindings) -> uint64_t
+    {
+        uint64_t hash = ReflectionHash::hashCombine(0, bindings.size());
+        for (const auto& binding : bindings)
+        {
+            const auto [index, type, count, stages] = bindingKey(binding);
+            hash = ReflectionHash::hashCombine(hash, static_cast<uint64_t>(index) << 32 | type);
+            hash = ReflectionHash::hashCombine(hash, static_cast<uint64_t>(count) << 32 | stages);
+        }
+        return hash;
+    }
+
+    auto DescriptorLayoutRegistry::hashPipelineLayout(const std::span<const uint64_t> setLayoutHashes, const std::span<const vk::PushConstantRange> pushConstants) -> uint64_t
+    {
+        uint64_t hash = ReflectionHash::hashCombine(0, setLayoutHashes.size());
+        for (const uint64_t setLayoutHash : setLayoutHashes)
+        {
+            hash = ReflectionHash::hashCombine(hash, setLayoutHash);
+        }
+
+        hash = ReflectionHash::hashCombine(hash, pushConstants.size());
+        for (const auto& pushConstant : pushConstants)
+        {
+            const auto [offset, size, stages] = pushConstantKey(pushConstant);
+            hash = ReflectionHash::hashCombine(hash, static_cast<uint64_t>(offset) << 32 | size);
+            hash = ReflectionHash::hashCombine(hash, stages);
+        }
+        return hash;
+    }
+
+    auto DescriptorLayoutRegistry::internSortedSetLayout(std::vector<vk::DescriptorSetLayoutBinding>&& bindings) -> DescriptorSetLayoutHandle
+    {
+        const uint64_t hash = hashSetLayout(bindings);
+
+        const auto [first, last] = m_setLayoutLookup.equal_range(hash);
+        for (auto it = first; it != last; ++it)
+        {
+            if (std::ranges::equal(m_setLayouts[it->second].bindings, bindings, {}, bindingKey, bindingKey))
+            {
+                return { it->second };
+            }
+        }
+
+        const auto index = static_cast<uint32_t>(m_setLayouts.size());
+        m_setLayoutLookup.emplace(hash, index);
+        m_setLayouts.push_back({ std::move(bindings), hash });
+        return { index };
+    }
+}
@@ -0,0 +1,131 @@
+#include "reflect/DescriptorPoolPlanner.hpp"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace nbl
+{
+    auto DescriptorPoolPlanner::plan(const std::span<const PipelineReflectionData> pipelines,
+                                     const std::span<const uint32_t> instancesPerSet,
+                                     DescriptorLayoutRegistry& registry) -> DescriptorPoolPlan
+    {
+        const auto getInstances = [&](const uint32_t set) -> uint32_t {
+            if (instancesPerSet.empty())
+            {
+                return 1;
+            }
+            return set < instancesPerSet.size() ? instancesPerSet[set] : instancesPerSet.back();
+        };
+
+        // Distinct layouts per set index
+        std::map<uint32_t, std::set<DescriptorSetLayoutHandle>> layoutsBySet;
+        for (const auto& pipeline : pipelines)
+        {
+            const auto& pipelineLayout = registry.getPipelineLayout(registry.internPipelineLayout(pipeline));
+            for (uint32_t set = 0; set < pipelineLayout.setLayouts.size(); ++set)
+            {
+                const auto handle = pipelineLayout.setLayouts[set];
+                if (!registry.getSetLayout(handle).bindings.empty())
+                {
+                    layoutsBySet[set].insert(handle);
+                }
+            }
+        }
+
+        DescriptorPoolPlan result;
+        std::map<DescriptorSetLayoutHandle, size_t> budgetIndex;
+        for (const auto& [set, handles] : layoutsBySet)
+        {
+            for (const auto handle : handles)
+            {
+                budgetIndex.try_emplace(handle, 0);
+            }
+        }
+        for (auto& [handle, index] : budgetIndex)
+        {
+            index = result.layouts.size();
+            result.layouts.push_back(budgetLayout(registry.getSetLayout(handle), handle));
+        }
+
+        for (const auto& [set, handles] : layoutsBySet)
+        {
+            const uint32_t instances = getInstances(set);
+
+            DescriptorPoolBucket bucket { .set = set };
+            for (const auto handle : handles)
+            {
+                const auto& budget = result.layouts[budgetIndex[handle]];
+                bucket.layouts.push_back(handle);
+                bucket.maxSets += instances;
+                addPoolSizes(bucket.poolSizes, budget.descriptorsByType, instances);
+            }
+
+            result.maxSets += bucket.maxSets;
+            addPoolSizes(result.poolSizes, bucket.poolSizes, 1);
+            result.buckets.push_back(std::move(bucket));
+        }
+
+        return result;
+    }
+
+    auto DescriptorPoolPlanner::budgetLayout(const InternedDescriptorSetLayout& layout, const DescriptorSetLayoutHandle handle) -> DescriptorLayoutBudget
+    {
+        DescriptorLayoutBudget result;
+        result.layout = handle;
+        result.hash   = layout.hash;
+        result.bindingOffsets.reserve(layout.bindings.size());
+
+        for (const auto& binding : layout.bindings)
+        {
+            result.bindingOffsets.push_back(result.descriptorCount);
+            result.descriptorCount   += binding.descriptorCount;
+            result.hasUnboundedArrays = result.hasUnboundedArrays || binding.descriptorCount == 0;
+            addPoolSizes(result.descriptorsByType, { vk::DescriptorPoolSize(binding.descriptorType, binding.descriptorCount) }, 1);
+        }
+
+        return result;
+    }
+
+    auto DescriptorPoolPlanner::computeByteOffsets(const InternedDescriptorSetLayout& layout,
+                                                   const std::function<vk::DeviceSize(vk::DescriptorType)>& descriptorSize) -> std::vector<vk::DeviceSize>
+    {
+        std::vector<vk::DeviceSize> result;
+        result.reserve(layout.bindings.size() + 1);
+
+        vk::DeviceSize offset = 0;
+        for (const auto& binding : layout.bindings)
+        {
+            const vk::DeviceSize size = descriptorSize(binding.descriptorType);
+            // Descriptors are aligned to their own size inside the set
+            if (size != 0)
+            {
+                offset = (offset + size - 1) / size * size;
+            }
+            result.push_back(offset);
+            offset += size * binding.descriptorCount;
+        }
+        result.push_back(offset);
+
+        return result;
+    }
+
+    void DescriptorPoolPlanner::addPoolSizes(std::vector<vk::DescriptorPoolSize>& poolSizes, const std::vector<vk::DescriptorPoolSize>& sizes, const uint32_t instances)
+    {
+        for (const auto& size : sizes)
+        {
+            if (size.descriptorCount == 0)
+            {
+                continue;
+            }
+
+            auto it = std::ranges::find(poolSizes, size.type, &vk::DescriptorPoolSize::type);
+            if (it == std::end(poolSizes))
+            {
+                poolSizes.push_back(vk::DescriptorPoolSize(size.type, 0));
+                it = std::prev(std::end(poolSizes));
+            }
+            it->descriptorCount += size.descriptorCount * instances;
+        }
+    }
+}
@@ -0,0 +1,666 @@
+#include "reflect/FlatReflectionDatabase.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace nbl
+{
+    namespace
+    {
+        template <typename T>
+        void releaseArray(T& array)
+        {
+            T(array.get_allocator()).swap(array);
+        }
+
+        auto toRange(const size_t offset, const size_t count) -> FlatRange
+        {
+            return { static_cast<uint32_t>(offset), static_cast<uint32_t>(count) };
+        }
+    }
+
+    FlatReflectionDatabase::FlatReflectionDatabase(std::pmr::memory_resource* upstream)
+        : m_arena(std::make_unique<std::pmr::monotonic_buffer_resource>(upstream))
+        , m_shaders(m_arena.get())
+        , m_pipelines(m_arena.get())
+        , m_shaderCode(m_arena.get())
+        , m_pipelineShaders(m_arena.get())
+        , m_descriptorSets(m_arena.get())
+        , m_bindings(m_arena.get())
+        , m_pushConstants(m_arena.get())
+        , m_vertexAttributes(m_arena.get())
+        , m_attributeNames(m_arena.get())
+        , m_vertexBindings(m_arena.get())
+        , m_conflicts(m_arena.get())
+        , m_blocks(m_arena.get())
+        , m_blockMembers(m_arena.get())
+        , m_arrayDims(m_arena.get())
+        , m_specConstants(m_arena.get())
+        , m_workgroups(m_arena.get())
+        , m_sharedVariables(m_arena.get())
+        , m_strings(m_arena.get())
+        , m_shaderIndex(m_arena.get())
+    {
+    }
+
+    void FlatReflectionDatabase::reserve(const std::span<const PipelineReflectionData> pipelines)
+    {
+        size_t nShaders = 0, nDescriptorSets = 0, nBindings = 0, nPushConstants = 0;
+        size_t nAttributes = 0, nVertexBindings = 0, nConflicts = 0, nChars = 0;
+        size_t nBlocks = 0, nBlockMembers = 0, nArrayDims = 0, nSpecConstants = 0;
+        size_t nWorkgroups = 0, nSharedVariables = 0;
+
+        const auto countSets = [&](const std::vector<ShaderReflectionDescriptorSet>& descriptorSets) {
+            nDescriptorSets += descriptorSets.size();
+            for (const auto& descriptorSet : descriptorSets)
+            {
+                nBindings += descriptorSet.bindings.size();
+            }
+        };
+
+        const auto countMembers = [&](const auto& self, const std::vector<ShaderReflectionBlockMember>& members) -> void {
+            nBlockMembers += members.size();
+            for (const auto& member : members)
+            {
+                nChars += member.name.size();
+                nArrayDims += member.arrayDims.size();
+                self(self, member.members);
+            }
+        };
+
+        for (const auto& pipeline : pipelines)
+        {
+            countSets(pipeline.descriptorSets);
+            nPushConstants += pipeline.pushConstants.size();
+            nConflicts += pipeline.conflicts.size();
+            for (const auto& conflict : pipeline.conflicts)
+            {
+                nChars += conflict.message.size();
+            }
+
+            nShaders += pipeline.shaderData.size();
+            for (const auto& shader : pipeline.shaderData)
+            {
+                countSets(shader.descriptorSets);
+                nPushConstants += shader.pushConstants.size();
+                nChars += shader.shaderName.size() + shader.sourceFile.size() + shader.entryPoint.size();
+                if (shader.vertexInput.has_value())
+                {
+                    nAttributes += shader.vertexInput->attributeDescriptions.size();
+                    nVertexBindings += shader.vertexInput->bindingDescriptions.size();
+                    for (const auto& name : shader.vertexInput->attributeNames)
+                    {
+                        nChars += name.size();
+                    }
+                }
+
+                nBlocks += shader.blocks.size();
+                for (const auto& block : shader.blocks)
+                {
+                    nChars += block.name.size() + block.typeName.size();
+                    countMembers(countMembers, block.members);
+                }
+
+                nSpecConstants += shader.specConstants.size();
+                for (const auto& constant : shader.specConstants)
+                {
+                    nChars += constant.name.size();
+                }
+
+                if (shader.workgroup.has_value())
+                {
+                    ++nWorkgroups;
+                    nSharedVariables += shader.workgroup->sharedVariables.size();
+                    for (const auto& variable : shader.workgroup->sharedVariables)
+                    {
+                        nChars += variable.name.size();
+                    }
+                }
+            }
+        }
+
+        m_shaders.reserve(m_shaders.size() + nShaders);
+        m_shaderCode.reserve(m_shaderCode.size() + nShaders);
+        m_pipelineShaders.reserve(m_pipelineShaders.size() + nShaders);
+        m_pipelines.reserve(m_pipelines.size() + pipelines.size());
+        m_descriptorSets.reserve(m_descriptorSets.size() + nDescriptorSets);
+        m_bindings.reserve(m_bindings.size() + nBindings);
+        m_pushConstants.reserve(m_pushConstants.size() + nPushConstants);
+        m_vertexAttributes.reserve(m_vertexAttributes.size() + nAttributes);
+        m_attributeNames.reserve(m_attributeNames.size() + nAttributes);
+        m_vertexBindings.reserve(m_vertexBindings.size() + nVertexBindings);
+        m_conflicts.reserve(m_conflicts.size() + nConflicts);
+        m_blocks.reserve(m_blocks.size() + nBlocks);
+        m_blockMembers.reserve(m_blockMembers.size() + nBlockMembers);
+        m_arrayDims.reserve(m_arrayDims.size() + nArrayDims);
+        m_specConstants.reserve(m_specConstants.size() + nSpecConstants);
+        m_workgroups.reserve(m_workgroups.size() + nWorkgroups);
+        m_sharedVariables.reserve(m_sharedVariables.size() + nSharedVariables);
+        m_strings.reserve(m_strings.size() + nChars);
+        m_shaderIndex.reserve(m_shaderIndex.size() + nShaders);
+    }
+
+    auto FlatReflectionDatabase::addShader(const ShaderReflectionData& shaderData) -> FlatShaderHandle
+    {
+        FlatShaderRecord record;
+        record.shaderName     = addString(shaderData.shaderName);
+        record.sourceFile     = addString(shaderData.sourceFile);
+        record.entryPoint     = addString(shaderData.entryPoint);
+        record.shaderStage    = shaderData.shaderStage;
+        record.descriptorSets = addDescriptorSets(shaderData.descriptorSets);
+        record.pushConstants  = addPushConstants(shaderData.pushConstants);
+
+        if (shaderData.vertexInput.has_value())
+        {
+            const auto& vertexInput = *shaderData.vertexInput;
+            record.hasVertexInput = true;
+
+            record.vertexAttributes = toRange(m_vertexAttributes.size(), vertexInput.attributeDescriptions.size());
+            m_vertexAttributes.insert(std::end(m_vertexAttributes), std::begin(vertexInput.attributeDescriptions), std::end(vertexInput.attributeDescriptions));
+            for (size_t i = 0; i < vertexInput.attributeDescriptions.size(); ++i)
+            {
+                m_attributeNames.push_back(i < vertexInput.attributeNames.size() ? addString(vertexInput.attributeNames[i]) : FlatRange {});
+            }
+
+            record.vertexBindings = toRange(m_vertexBindings.size(), vertexInput.bindingDescriptions.size());
+            m_vertexBindings.insert(std::end(m_vertexBindings), std::begin(vertexInput.bindingDescriptions), std::end(vertexInput.bindingDescriptions));
+        }
+
+        record.blocks = addBlocks(shaderData.blocks);
+
+        record.specConstants = toRange(m_specConstants.size(), shaderData.specConstants.size());
+        for (const auto& constant : shaderData.specConstants)
+        {
+            m_specConstants.push_back({ constant.constantId, addString(constant.name), constant.type, constant.width, constant.defaultValue });
+        }
+
+        if (shaderData.workgroup.has_value())
+        {
+            const auto& workgroup = *shaderData.workgroup;
+            const FlatRange sharedVariables = toRange(m_sharedVariables.size(), workgroup.sharedVariables.size());
+            for (const auto& variable : workgroup.sharedVariables)
+            {
+                m_sharedVariables.push_back({ addString(variable.name), variable.size, variable.lengthConstantId, variable.elementSize });
+            }
+
+            record.workgroup = toRange(m_workgroups.size(), 1);
+            m_workgroups.push_back({ workgroup.localSize, workgroup.localSizeConstantIds, workgroup.sharedMemorySize, sharedVariables });
+        }
+
+        const FlatShaderHandle handle { static_cast<uint32_t>(m_shaders.size()) };
+        m_shaders.push_back(record);
+        m_shaderCode.push_back(shaderData.shaderCode);
+        if (shaderData.shaderCode.data() != nullptr)
+        {
+            m_shaderIndex.emplace(shaderData.shaderCode.data(), handle);
+        }
+        return handle;
+    }
+
+    auto FlatReflectionDatabase::addPipeline(const PipelineReflectionData& pipelineData) -> FlatPipelineHandle
+    {
+        // Shaders first, their handles are stored contiguously per pipeline
+        std::vector<FlatShaderHandle> shaders;
+        shaders.reserve(pipelineData.shaderData.size());
+        for (const auto& shader : pipelineData.shaderData)
+        {
+            const FlatShaderHandle existing = findShader(shader);
+            shaders.push_back(existing.isValid() ? existing : addShader(shader));
+        }
+
+        FlatPipelineRecord record;
+        record.shaders = toRange(m_pipelineShaders.size(), shaders.size());
+        m_pipelineShaders.insert(std::end(m_pipelineShaders), std::begin(shaders), std::end(shaders));
+
+        record.descriptorSets = addDescriptorSets(pipelineData.descriptorSets);
+        record.pushConstants  = addPushConstants(pipelineData.pushConstants);
+
+        record.conflicts = toRange(m_conflicts.size(), pipelineData.conflicts.size());
+        for (const auto& conflict : pipelineData.conflicts)
+        {
+            m_conflicts.push_back({ conflict.set, conflict.binding, addString(conflict.message) });
+        }
+
+        m_pipelines.push_back(record);
+        return { static_cast<uint32_t>(m_pipelines.size() - 1) };
+    }
+
+    void FlatReflectionDatabase::clear()
+    {
+        releaseArray(m_shaders);
+        releaseArray(m_pipelines);
+        releaseArray(m_shaderCode);
+        releaseArray(m_pipelineShaders);
+        releaseArray(m_descriptorSets);
+        releaseArray(m_bindings);
+        releaseArray(m_pushConstants);
+        releaseArray(m_vertexAttributes);
+        releaseArray(m_attributeNames);
+        releaseArray(m_vertexBindings);
+        releaseArray(m_conflicts);
+        releaseArray(m_blocks);
+        releaseArray(m_blockMembers);
+        releaseArray(m_arrayDims);
+        releaseArray(m_specConstants);
+        releaseArray(m_workgroups);
+        releaseArray(m_sharedVariables);
+        releaseArray(m_strings);
+        releaseArray(m_shaderIndex);
+        m_arena->release();
+    }
+
+    auto FlatReflectionDatabase::getShader(const FlatShaderHandle handle) const -> const FlatShaderRecord&
+    {
+        if (handle.index >= m_shaders.size())
+        {
+            throw std::runtime_error("Invalid shader handle: " + std::to_string(handle.index));
+        }
+        return m_shaders[handle.index];
+    }
+
+    auto FlatReflectionDatabase::getPipeline(const FlatPipelineHandle handle) const -> const FlatPipelineRecord&
+    {
+        if (handle.index >= m_pipelines.size())
+        {
+            throw std::runtime_error("Invalid pipeline handle: " + std::to_string(handle.index));
+        }
+        return m_pipelines[handle.index];
+    }
+
+    auto FlatReflectionDatabase::getShaderCode(const FlatShaderHandle handle) const -> const ShaderCode&
+    {
+        getShader(handle);
+        return m_shaderCode[handle.index];
+    }
+
+    auto FlatReflectionDatabase::getDescriptorSets(const FlatShaderHandle handle) const -> std::span<const FlatDescriptorSet>
+    {
+        return slice(m_descriptorSets, getShader(handle).descriptorSets);
+    }
+
+    auto FlatReflectionDatabase::getPushConstants(const FlatShaderHandle handle) const -> std::span<const vk::PushConstantRange>
+    {
+        return slice(m_pushConstants, getShader(handle).pushConstants);
+    }
+
+    auto FlatReflectionDatabase::getVertexAttributes(const FlatShaderHandle handle) const -> std::span<const vk::VertexInputAttributeDescription>
+    {
+        return slice(m_vertexAttributes, getShader(handle).vertexAttributes);
+    }
+
+    auto FlatReflectionDatabase::getVertexBindings(const FlatShaderHandle handle) const -> std::span<const vk::VertexInputBindingDescription>
+    {
+        return slice(m_vertexBindings, getShader(handle).vertexBindings);
+    }
+
+    auto FlatReflectionDatabase::getAttributeName(const FlatShaderHandle handle, const uint32_t attribute) const -> std::string_view
+    {
+        const auto names = slice(m_attributeNames, getShader(handle).vertexAttributes);
+        return attribute < names.size() ? getString(names[attribute]) : std::string_view();
+    }
+
+    auto FlatReflectionDatabase::getBlocks(const FlatShaderHandle handle) const -> std::span<const FlatBlock>
+    {
+        return slice(m_blocks, getShader(handle).blocks);
+    }
+
+    auto FlatReflectionDatabase::getSpecConstants(const FlatShaderHandle handle) const -> std::span<const FlatSpecConstant>
+    {
+        return slice(m_specConstants, getShader(handle).specConstants);
+    }
+
+    auto FlatReflectionDatabase::getWorkgroup(const FlatShaderHandle handle) const -> const FlatWorkgroup*
+    {
+        const auto workgroup = slice(m_workgroups, getShader(handle).workgroup);
+        return workgroup.empty() ? nullptr : workgroup.data();
+    }
+
+    auto FlatReflectionDatabase::getShaders(const FlatPipelineHandle handle) const -> std::span<const FlatShaderHandle>
+    {
+        return slice(m_pipelineShaders, getPipeline(handle).shaders);
+    }
+
+    auto FlatReflectionDatabase::getDescriptorSets(const FlatPipelineHandle handle) const -> std::span<const FlatDescriptorSet>
+    {
+        return slice(m_descriptorSets, getPipeline(handle).descriptorSets);
+    }
+
+    auto FlatReflectionDatabase::getPushConstants(const FlatPipelineHandle handle) const -> std::span<const vk::PushConstantRange>
+    {
+        return slice(m_pushConstants, getPipeline(handle).pushConstants);
+    }
+
+    auto FlatReflectionDatabase::getConflicts(const FlatPipelineHandle handle) const -> std::span<const FlatConflict>
+    {
+        return slice(m_conflicts, getPipeline(handle).conflicts);
+    }
+
+    auto FlatReflectionDatabase::getBindings(const FlatDescriptorSet& descriptorSet) const -> std::span<const vk::DescriptorSetLayoutBinding>
+    {
+        return slice(m_bindings, descriptorSet.bindings);
+    }
+
+    auto FlatReflectionDatabase::getMembers(const FlatBlock& block) const -> std::span<const FlatBlockMember>
+    {
+        return slice(m_blockMembers, block.members);
+    }
+
+    auto FlatReflectionDatabase::getMembers(const FlatBlockMember& member) const -> std::span<const FlatBlockMember>
+    {
+        return slice(m_blockMembers, member.members);
+    }
+
+    auto FlatReflectionDatabase::getArrayDims(const FlatBlockMember& member) const -> std::span<const uint32_t>
+    {
+        return slice(m_arrayDims, member.arrayDims);
+    }
+
+    auto FlatReflectionDatabase::getSharedVariables(const FlatWorkgroup& workgroup) const -> std::span<const FlatSharedVariable>
+    {
+        return slice(m_sharedVariables, workgroup.sharedVariables);
+    }
+
+    auto FlatReflectionDatabase::getString(const FlatRange range) const -> std::string_view
+    {
+        const auto chars = slice(m_strings, range);
+        return { chars.data(), chars.size() };
+    }
+
+    auto FlatReflectionDatabase::toShaderReflectionData(const FlatShaderHandle handle) const -> ShaderReflectionData
+    {
+        const FlatShaderRecord& record = getShader(handle);
+
+        ShaderReflectionData result;
+        result.shaderName    = getString(record.shaderName);
+        result.sourceFile    = getString(record.sourceFile);
+        result.entryPoint    = getString(record.entryPoint);
+        result.shaderStage   = record.shaderStage;
+        result.shaderCode    = m_shaderCode[handle.index];
+
+        const auto pushConstants = getPushConstants(handle);
+        result.pushConstants.assign(std::begin(pushConstants), std::end(pushConstants));
+
+        for (const auto& descriptorSet : getDescriptorSets(handle))
+        {
+            const auto bindings = getBindings(descriptorSet);
+            result.descriptorSets.push_back({ descriptorSet.set, { std::begin(bindings), std::end(bindings) } });
+        }
+
+        if (record.hasVertexInput)
+        {
+            auto& vertexInput = result.vertexInput.emplace();
+            const auto attributes = getVertexAttributes(handle);
+            const auto bindings = getVertexBindings(handle);
+            vertexInput.attributeDescriptions.assign(std::begin(attributes), std::end(attributes));
+            vertexInput.bindingDescriptions.assign(std::begin(bindings), std::end(bindings));
+            for (uint32_t i = 0; i < attributes.size(); ++i)
+            {
+                vertexInput.attributeNames.emplace_back(getAttributeName(handle, i));
+            }
+        }
+
+        for (const auto& block : getBlocks(handle))
+        {
+            result.blocks.push_back({
+                .type     = block.type,
+                .name     = std::string(getString(block.name)),
+                .typeName = std::string(getString(block.typeName)),
+                .set      = block.set,
+                .binding  = block.binding,
+                .size     = block.size,
+                .members  = toBlockMembers(getMembers(block)),
+            });
+        }
+
+        for (const auto& constant : getSpecConstants(handle))
+        {
+            result.specConstants.push_back({
+                .constantId   = constant.constantId,
+                .name         = std::string(getString(constant.name)),
+                .type         = constant.type,
+                .width        = constant.width,
+                .defaultValue = constant.defaultValue,
+            });
+        }
+
+        if (const FlatWorkgroup* workgroup = getWorkgroup(handle))
+        {
+            auto& resultWorkgroup = result.workgroup.emplace();
+            resultWorkgroup.localSize            = workgroup->localSize;
+            resultWorkgroup.localSizeConstantIds = workgroup->localSizeConstantIds;
+            resultWorkgroup.sharedMemorySize     = workgroup->sharedMemorySize;
+            for (const auto& variable : getSharedVariables(*workgroup))
+            {
+                resultWorkgroup.sharedVariables.push_back({
+                    .name             = std::string(getString(variable.name)),
+                    .size             = variable.size,
+                    .lengthConstantId = variable.lengthConstantId,
+                    .elementSize      = variable.elementSize,
+                });
+            }
+        }
+
+        return result;
+    }
+
+    auto FlatReflectionDatabase::toPipelineReflectionData(const FlatPipelineHandle handle) const -> PipelineReflectionData
+    {
+        PipelineReflectionData result;
+        for (const FlatShaderHandle shader : getShaders(handle))
+        {
+            result.shaderData.push_back(toShaderReflectionData(shader));
+        }
+
+        for (const auto& descriptorSet : getDescriptorSets(handle))
+        {
+            const auto bindings = getBindings(descriptorSet);
+            result.descriptorSets.push_back({ descriptorSet.set, { std::begin(bindings), std::end(bindings) } });
+        }
+
+        const auto pushConstants = getPushConstants(handle);
+        result.pushConstants.assign(std::begin(pushConstants), std::end(pushConstants));
+
+        for (const auto& conflict : getConflicts(handle))
+        {
+            result.conflicts.push_back({ conflict.set, conflict.binding, std::string(getString(conflict.message)) });
+        }
+
+        return result;
+    }
+
+    auto FlatReflectionDatabase::addString(const std::string_view string) -> FlatRange
+    {
+        const FlatRange range = toRange(m_strings.size(), string.size());
+        m_strings.insert(std::end(m_strings), std::begin(string), std::end(string));
+        return range;
+    }
+
+    auto FlatReflectionDatabase::addDescriptorSets(const std::vector<ShaderReflectionDescriptorSet>& descriptorSets) -> FlatRange
+    {
+        const FlatRange range = toRange(m_descriptorSets.size(), descriptorSets.size());
+        for (const auto& descriptorSet : descriptorSets)
+        {
+            m_descriptorSets.push_back({ descriptorSet.set, toRange(m_bindings.size(), descriptorSet.bindings.size()) });
+            m_bindings.insert(std::end(m_bindings), std::begin(descriptorSet.bindings), std::end(descriptorSet.bindings));
+        }
+        return range;
+    }
+
+    auto FlatReflectionDatabase::addPushConstants(const std::vector<vk::PushConstantRange>& pushConstants) -> FlatRange
+    {
+        const FlatRange range = toRange(m_pushConstants.size(), pushConstants.size());
+        m_pushConstants.insert(std::end(m_pushConstants), std::begin(pushConstants), std::end(pushConstants));
+        return range;
+    }
+
+    auto FlatReflectionDatabase::addBlocks(const std::vector<ShaderReflectionBlock>& blocks) -> FlatRange
+    {
+        const FlatRange range = toRange(m_blocks.size(), blocks.size());
+        for (const auto& block : blocks)
+        {
+            FlatBlock flatBlock;
+            flatBlock.type     = block.type;
+            flatBlock.name     = addString(block.name);
+            flatBlock.typeName = addString(block.typeName);
+            flatBlock.set      = block.set;
+            flatBlock.binding  = block.binding;
+            flatBlock.size     = block.size;
+            flatBlock.members  = addBlockMembers(block.members);
+            m_blocks.push_back(flatBlock);
+        }
+        return range;
+    }
+
+    auto FlatReflectionDatabase::addBlockMembers(const std::vector<ShaderReflectionBlockMember>& members) -> FlatRange
+    {
+        // Siblings are allocated before their children so they stay contiguous
+        const FlatRange range = toRange(m_blockMembers.size(), members.size());
+        m_blockMembers.resize(m_blockMembers.size() + members.size());
+        for (uint32_t i = 0; i < members.size(); ++i)
+        {
+            const auto& member = members[i];
+
+            FlatBlockMember flatMember;
+            flatMember.name         = addString(member.name);
+            flatMember.offset       = member.offset;
+            flatMember.size         = member.size;
+            flatMember.arrayStride  = member.arrayStride;
+            flatMember.matrixStride = member.matrixStride;
+            flatMember.rowMajor     = member.rowMajor;
+            flatMember.arrayDims    = toRange(m_arrayDims.size(), member.arrayDims.size());
+            m_arrayDims.insert(std::end(m_arrayDims), std::begin(member.arrayDims), std::end(member.arrayDims));
+            flatMember.members      = addBlockMembers(member.members);
+            m_blockMembers[range.offset + i] = flatMember;
+        }
+        return range;
+    }
+
+    auto FlatReflectionDatabase::toBlockMembers(const std::span<const FlatBlockMember> members) const -> std::vector<ShaderReflectionBlockMember>
+    {
+        std::vector<ShaderReflectionBlockMember> result;
+        result.reserve(members.size());
+        for (const auto& member : members)
+        {
+            const auto arrayDims = getArrayDims(member);
+            result.push_back({
+                .name         = std::string(getString(member.name)),
+                .offset       = member.offset,
+                .size         = member.size,
+                .arrayStride  = member.arrayStride,
+                .matrixStride = member.matrixStride,
+                .rowMajor     = member.rowMajor,
+                .arrayDims    = { std::begin(arrayDims), std::end(arrayDims) },
+                .members      = toBlockMembers(getMembers(member)),
+            });
+        }
+        return result;
+    }
+
+    auto FlatReflectionDatabase::findShader(const ShaderReflectionData& shaderData) const -> FlatShaderHandle
+    {
+        // Shaders without code are never shared
+        if (shaderData.shaderCode.data() == nullptr)
+        {
+            return {};
+        }
+
+        const auto [first, last] = m_shaderIndex.equal_range(shaderData.shaderCode.data());
+        for (auto it = first; it != last; ++it)
+        {
+            if (equalShader(it->second, shaderData))
+            {
+                return it->second;
+            }
+        }
+        return {};
+    }
+
+    auto FlatReflectionDatabase::equalShader(const FlatShaderHandle handle, const ShaderReflectionData& shaderData) const -> bool
+    {
+        const FlatShaderRecord& record = m_shaders[handle.index];
+        const ShaderCode& shaderCode   = m_shaderCode[handle.index];
+        if (shaderCode.data() != shaderData.shaderCode.data() || shaderCode.sizeInBytes() != shaderData.shaderCode.sizeInBytes()
+            || record.shaderStage != shaderData.shaderStage
+            || getString(record.entryPoint) != shaderData.entryPoint
+            || getString(record.shaderName) != shaderData.shaderName
+            || getString(record.sourceFile) != shaderData.sourceFile)
+        {
+            return false;
+        }
+
+        const auto descriptorSets = getDescriptorSets(handle);
+        const bool equalSets = std::ranges::equal(descriptorSets, shaderData.descriptorSets, [&](const FlatDescriptorSet& lhs, const ShaderReflectionDescriptorSet& rhs) {
+            return lhs.set == rhs.set && std::ranges::equal(getBindings(lhs), rhs.bindings);
+        });
+        if (!equalSets || !std::ranges::equal(getPushConstants(handle), shaderData.pushConstants))
+        {
+            return false;
+        }
+
+        // Vertex input layouts are chosen per pipeline, stages of the same module can differ here
+        if (record.hasVertexInput != shaderData.vertexInput.has_value())
+        {
+            return false;
+        }
+        if (record.hasVertexInput)
+        {
+            const auto& vertexInput = *shaderData.vertexInput;
+            if (!std::ranges::equal(getVertexAttributes(handle), vertexInput.attributeDescriptions)
+                || !std::ranges::equal(getVertexBindings(handle), vertexInput.bindingDescriptions))
+            {
+                return false;
+            }
+            for (uint32_t i = 0; i < vertexInput.attributeDescriptions.size(); ++i)
+            {
+                if (getAttributeName(handle, i) != (i < vertexInput.attributeNames.size() ? std::string_view(vertexInput.attributeNames[i]) : std::string_view()))
+                {
+                    return false;
+                }
+            }
+        }
+
+        const bool equalBlocks = std::ranges::equal(getBlocks(handle), shaderData.blocks, [&](const FlatBlock& lhs, const ShaderReflectionBlock& rhs) {
+            return lhs.type == rhs.type && lhs.set == rhs.set && lhs.binding == rhs.binding && lhs.size == rhs.size
+                && getString(lhs.name) == rhs.name && getString(lhs.typeName) == rhs.typeName
+                && equalMembers(getMembers(lhs), rhs.members);
+        });
+        const bool equalConstants = std::ranges::equal(getSpecConstants(handle), shaderData.specConstants, [&](const FlatSpecConstant& lhs, const ShaderSpecializationConstant& rhs) {
+            return lhs.constantId == rhs.constantId && lhs.type == rhs.type && lhs.width == rhs.width && lhs.defaultValue == rhs.defaultValue
+                && getString(lhs.name) == rhs.name;
+        });
+        if (!equalBlocks || !equalConstants)
+        {
+            return false;
+        }
+
+        const FlatWorkgroup* workgroup = getWorkgroup(handle);
+        if ((workgroup != nullptr) != shaderData.workgroup.has_value())
+        {
+            return false;
+        }
+        return workgroup == nullptr
+            || (workgroup->localSize == shaderData.workgroup->localSize
+                && workgroup->localSizeConstantIds == shaderData.workgroup->localSizeConstantIds
+                && workgroup->sharedMemorySize == shaderData.workgroup->sharedMemorySize
+                && std::ranges::equal(getSharedVariables(*workgroup), shaderData.workgroup->sharedVariables, [&](const FlatSharedVariable& lhs, const ShaderWorkgroupVariable& rhs) {
+                       return lhs.size == rhs.size && lhs.lengthConstantId == rhs.lengthConstantId && lhs.elementSize == rhs.elementSize
+                           && getString(lhs.name) == rhs.name;
+                   }));
+    }
+
+    auto FlatReflectionDatabase::equalMembers(const std::span<const FlatBlockMember> members, const std::vector<ShaderReflectionBlockMember>& other) const -> bool
+    {
+        return std::ranges::equal(members, other, [&](const FlatBlockMember& lhs, const ShaderReflectionBlockMember& rhs) {
+            return lhs.offset == rhs.offset && lhs.size == rhs.size && lhs.arrayStride == rhs.arrayStride
+                && lhs.matrixStride == rhs.matrixStride && lhs.rowMajor == rhs.rowMajor
+                && getString(lhs.name) == rhs.name && std::ranges::equal(getArrayDims(lhs), rhs.arrayDims)
+                && equalMembers(getMembers(lhs), rhs.members);
+        });
+    }
+
+    template <typename T>
+    auto FlatReflectionDatabase::slice(const std::pmr::vector<T>& array, const FlatRange range) -> std::span<const T>
+    {
+        return std::span<const T>(array).subspan(range.offset, range.count);
+    }
+}
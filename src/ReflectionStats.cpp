@@ -0,0 +1,377 @@
+#include "reflect/ReflectionStats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include "reflect/ShaderReflection.hpp"
+
+namespace nbl
+{
+    namespace
+    {
+        struct StatsState
+        {
+            std::mutex                              mutex;
+            std::vector<ReflectionEvent>            events;
+            std::vector<PipelineReflectionStats>    pipelines;
+            std::shared_ptr<const ReflectionStats::Callback> callback;
+            size_t                                  capacity = 1 << 20;
+            uint64_t                                dropped  = 0;
+        };
+
+        auto state() -> StatsState&
+        {
+            static StatsState s_state;
+            return s_state;
+        }
+
+        std::atomic<ReflectionStats::AllocationCounter> g_allocationCounter = nullptr;
+
+        void writeEscaped(std::ostream& out, const std::string_view value)
+        {
+            out << '"';
+            for (const char c : value)
+            {
+                switch (c)
+                {
+                    case '"':  out << "\\\""; break;
+                    case '\\': out << "\\\\"; break;
+                    case '\n': out << "\\n"; break;
+                    case '\t': out << "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            constexpr char hex[] = "0123456789abcdef";
+                            out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+                        }
+                        else
+                        {
+                            out << c;
+                        }
+                }
+            }
+            out << '"';
+        }
+
+        auto openOutput(const std::filesystem::path& filePath) -> std::ofstream
+        {
+            std::ofstream file(filePath, std::ios::trunc);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Failed to open file: " + filePath.string());
+            }
+            return file;
+        }
+
+        // Phases that are not nested in another phase of the same shader, their sum is the shader total
+        auto isTopLevel(const ReflectionPhase phase) -> bool
+        {
+            return phase == ReflectionPhase::eFileIO || phase == ReflectionPhase::eCacheLookup || phase == ReflectionPhase::eReflectShader;
+        }
+    }
+
+    void ReflectionStats::setEnabled(const bool enabled)
+    {
+        s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void ReflectionStats::setCallback(Callback callback)
+    {
+        auto shared = callback ? std::make_shared<const Callback>(std::move(callback)) : nullptr;
+        std::lock_guard lock(state().mutex);
+        state().callback = std::move(shared);
+    }
+
+    void ReflectionStats::setAllocationCounter(const AllocationCounter counter)
+    {
+        g_allocationCounter.store(counter, std::memory_order_relaxed);
+    }
+
+    void ReflectionStats::setEventCapacity(const size_t capacity)
+    {
+        std::lock_guard lock(state().mutex);
+        state().capacity = capacity;
+    }
+
+    void ReflectionStats::reset()
+    {
+        std::lock_guard lock(state().mutex);
+        state().events.clear();
+        state().pipelines.clear();
+        state().dropped = 0;
+    }
+
+    auto ReflectionStats::getEvents() -> std::vector<ReflectionEvent>
+    {
+        std::lock_guard lock(state().mutex);
+        return state().events;
+    }
+
+    auto ReflectionStats::getDroppedEvents() -> uint64_t
+    {
+        std::lock_guard lock(state().mutex);
+        return state().dropped;
+    }
+
+    auto ReflectionStats::getShaderStats() -> std::vector<ShaderReflectionStats>
+    {
+        const auto events = getEvents();
+
+        std::unordered_map<std::string_view, size_t> indices;
+        std::vector<ShaderReflectionStats> result;
+        for (const auto& event : events)
+        {
+            if (event.phase == ReflectionPhase::eMerge)
+            {
+                continue;
+            }
+
+            const auto [it, inserted] = indices.try_emplace(event.source, result.size());
+            if (inserted)
+            {
+                result.push_back({ .sourceFile = event.source });
+            }
+
+            auto& stats = result[it->second];
+            stats.phaseNs[static_cast<size_t>(event.phase)] += event.durationNs;
+            if (event.phase == ReflectionPhase::eReflectShader)
+            {
+                stats.reflections++;
+            }
+            if (isTopLevel(event.phase))
+            {
+                stats.totalNs     += event.durationNs;
+                stats.allocations += event.allocations;
+                stats.bytes        = std::max(stats.bytes, event.bytes);
+            }
+        }
+
+        std::ranges::sort(result, std::greater {}, &ShaderReflectionStats::totalNs);
+        return result;
+    }
+
+    auto ReflectionStats::getPipelineStats() -> std::vector<PipelineReflectionStats>
+    {
+        std::vector<PipelineReflectionStats> result;
+        {
+            std::lock_guard lock(state().mutex);
+            result = state().pipelines;
+        }
+
+        std::unordered_map<std::string, uint64_t> shaderTotals;
+        for (const auto& shader : getShaderStats())
+        {
+            shaderTotals.emplace(shader.sourceFile, shader.totalNs);
+        }
+
+        for (auto& pipeline : result)
+        {
+            for (const auto& file : pipeline.shaderFiles)
+            {
+                if (const auto it = shaderTotals.find(file); it != std::end(shaderTotals))
+                {
+                    pipeline.reflectNs += it->second;
+                }
+            }
+        }
+        return result;
+    }
+
+    void ReflectionStats::writeChromeTrace(std::ostream& out)
+    {
+        const auto events = getEvents();
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const auto& event = events[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "{\"name\":\"" << getPhaseName(event.phase) << "\",\"cat\":\"nblReflect\",\"ph\":\"X\""
+                << ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0
+                << ",\"dur\":" << static_cast<double>(event.durationNs) / 1000.0
+                << ",\"pid\":0,\"tid\":" << event.threadIndex
+                << ",\"args\":{\"source\":";
+            writeEscaped(out, event.source);
+            out << ",\"bytes\":" << event.bytes << ",\"allocations\":" << event.allocations << "}}";
+        }
+        out << "\n]}\n";
+    }
+
+    void ReflectionStats::writeChromeTrace(const std::filesystem::path& filePath)
+    {
+        auto file = openOutput(filePath);
+        writeChromeTrace(file);
+    }
+
+    void ReflectionStats::writeSummary(std::ostream& out)
+    {
+        const auto shaders = getShaderStats();
+        const auto pipelines = getPipelineStats();
+
+        out << "{\n  \"droppedEvents\": " << getDroppedEvents() << ",\n  \"shaders\": [";
+        for (size_t i = 0; i < shaders.size(); ++i)
+        {
+            const auto& shader = shaders[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"sourceFile\": ";
+            writeEscaped(out, shader.sourceFile);
+            out << ", \"bytes\": " << shader.bytes
+                << ", \"reflections\": " << shader.reflections
+                << ", \"totalNs\": " << shader.totalNs
+                << ", \"allocations\": " << shader.allocations
+                << ", \"phaseNs\": {";
+            for (size_t p = 0; p < shader.phaseNs.size(); ++p)
+            {
+                out << (p == 0 ? "" : ", ") << '"' << getPhaseName(static_cast<ReflectionPhase>(p)) << "\": " << shader.phaseNs[p];
+            }
+            out << "}}";
+        }
+
+        out << "\n  ],\n  \"pipelines\": [";
+        for (size_t i = 0; i < pipelines.size(); ++i)
+        {
+            const auto& pipeline = pipelines[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"shaderFiles\": [";
+            for (size_t s = 0; s < pipeline.shaderFiles.size(); ++s)
+            {
+                out << (s == 0 ? "" : ", ");
+                writeEscaped(out, pipeline.shaderFiles[s]);
+            }
+            out << "], \"bytes\": " << pipeline.bytes
+                << ", \"reflectNs\": " << pipeline.reflectNs
+                << ", \"mergeNs\": " << pipeline.mergeNs
+                << ", \"descriptorSets\": " << pipeline.descriptorSets
+                << ", \"descriptorBindings\": " << pipeline.descriptorBindings
+                << ", \"pushConstantRanges\": " << pipeline.pushConstantRanges
+                << ", \"conflicts\": " << pipeline.conflicts << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    void ReflectionStats::writeSummary(const std::filesystem::path& filePath)
+    {
+        auto file = openOutput(filePath);
+        writeSummary(file);
+    }
+
+    auto ReflectionStats::getPhaseName(const ReflectionPhase phase) -> const char*
+    {
+        switch (phase)
+        {
+            case ReflectionPhase::eFileIO:                  return "fileIO";
+            case ReflectionPhase::eCacheLookup:             return "cacheLookup";
+            case ReflectionPhase::eReflectShader:           return "reflectShader";
+            case ReflectionPhase::eModuleCreate:            return "moduleCreate";
+            case ReflectionPhase::eResolveDescriptorSets:   return "resolveDescriptorSets";
+            case ReflectionPhase::eResolvePushConstants:    return "resolvePushConstants";
+            case ReflectionPhase::eResolveVertexInput:      return "resolveVertexInput";
+            case ReflectionPhase::eResolveBlocks:           return "resolveBlocks";
+            case ReflectionPhase::eResolveSpecConstants:    return "resolveSpecConstants";
+            case ReflectionPhase::eResolveWorkgroup:        return "resolveWorkgroup";
+            case ReflectionPhase::eFastScanResolve:         return "fastScanResolve";
+            case ReflectionPhase::eMerge:                   return "merge";
+            default:                                        return "unknown";
+        }
+    }
+
+    void ReflectionStats::recordEvent(ReflectionEvent&& event)
+    {
+        std::shared_ptr<const Callback> callback;
+        {
+            std::lock_guard lock(state().mutex);
+            callback = state().callback;
+            if (state().events.size() < state().capacity)
+            {
+                state().events.push_back(callback ? event : std::move(event));
+                if (!callback)
+                {
+                    return;
+                }
+            }
+            else
+            {
+                state().dropped++;
+            }
+        }
+
+        if (callback)
+        {
+            (*callback)(event);
+        }
+    }
+
+    void ReflectionStats::recordPipeline(const PipelineReflectionData& pipeline, const uint64_t mergeNs)
+    {
+        PipelineReflectionStats stats;
+        stats.mergeNs            = mergeNs;
+        stats.descriptorSets     = pipeline.descriptorSets.size();
+        stats.pushConstantRanges = pipeline.pushConstants.size();
+        stats.conflicts          = pipeline.conflicts.size();
+        for (const auto& descriptorSet : pipeline.descriptorSets)
+        {
+            stats.descriptorBindings += descriptorSet.bindings.size();
+        }
+        for (const auto& shader : pipeline.shaderData)
+        {
+            stats.shaderFiles.push_back(shader.sourceFile);
+            stats.bytes += shader.shaderCode.sizeInBytes();
+        }
+
+        std::lock_guard lock(state().mutex);
+        state().pipelines.push_back(std::move(stats));
+    }
+
+    auto ReflectionStats::now() -> uint64_t
+    {
+        static const auto s_epoch = std::chrono::steady_clock::now();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count());
+    }
+
+    auto ReflectionStats::allocationCount() -> uint64_t
+    {
+        const auto counter = g_allocationCounter.load(std::memory_order_relaxed);
+        return counter ? counter() : 0;
+    }
+
+    auto ReflectionStats::threadIndex() -> uint32_t
+    {
+        static std::atomic<uint32_t> s_nextIndex = 0;
+        thread_local const uint32_t t_index = s_nextIndex.fetch_add(1, std::memory_order_relaxed);
+        return t_index;
+    }
+
+    ScopedReflectionTimer::ScopedReflectionTimer(const ReflectionPhase phase, const std::string_view source, const uint64_t bytes)
+        : m_phase(phase)
+        , m_source(source)
+        , m_bytes(bytes)
+        , m_active(ReflectionStats::isEnabled())
+    {
+        if (m_active)
+        {
+            m_allocations = ReflectionStats::allocationCount();
+            m_startNs     = ReflectionStats::now();
+        }
+    }
+
+    ScopedReflectionTimer::~ScopedReflectionTimer()
+    {
+        if (!m_active)
+        {
+            return;
+        }
+
+        const uint64_t endNs = ReflectionStats::now();
+        ReflectionStats::recordEvent({
+            .phase       = m_phase,
+            .source      = std::string(m_source),
+            .startNs     = m_startNs,
+            .durationNs  = endNs - m_startNs,
+            .threadIndex = ReflectionStats::threadIndex(),
+            .bytes       = m_bytes,
+            .allocations = ReflectionStats::allocationCount() - m_allocations,
+        });
+    }
+}
@@ -0,0 +1,192 @@
+#include "reflect/ShaderCode.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define NBL_REFLECT_POSIX_MMAP
+#endif
+
+namespace nbl
+{
+    namespace
+    {
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(const std::string& filePath)
+            {
+#if defined(_WIN32)
+                m_file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (m_file == INVALID_HANDLE_VALUE)
+                {
+                    throw std::runtime_error("Failed to open file: " + filePath);
+                }
+
+                LARGE_INTEGER fileSize;
+                if (!GetFileSizeEx(m_file, &fileSize))
+                {
+                    release();
+                    throw std::runtime_error("Failed to stat file: " + filePath);
+                }
+                m_size = static_cast<size_t>(fileSize.QuadPart);
+                if (m_size == 0)
+                {
+                    return;
+                }
+
+                m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                m_data    = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+                if (m_data == nullptr)
+                {
+                    release();
+                    throw std::runtime_error("Failed to map file: " + filePath);
+                }
+#elif defined(NBL_REFLECT_POSIX_MMAP)
+                m_file = open(filePath.c_str(), O_RDONLY);
+                if (m_file < 0)
+                {
+                    throw std::runtime_error("Failed to open file: " + filePath);
+                }
+
+                struct stat fileStat {};
+                if (fstat(m_file, &fileStat) != 0)
+                {
+                    release();
+                    throw std::runtime_error("Failed to stat file: " + filePath);
+                }
+                m_size = static_cast<size_t>(fileStat.st_size);
+                if (m_size == 0)
+                {
+                    return;
+                }
+
+                m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+                if (m_data == MAP_FAILED)
+                {
+                    m_data = nullptr;
+                    release();
+                    throw std::runtime_error("Failed to map file: " + filePath);
+                }
+#endif
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            ~MappedFile()
+            {
+                release();
+            }
+
+            auto data() const -> const void* { return m_data; }
+            auto size() const -> size_t      { return m_size; }
+
+        private:
+            void release()
+            {
+#if defined(_WIN32)
+                if (m_data)                         UnmapViewOfFile(m_data);
+                if (m_mapping)                      CloseHandle(m_mapping);
+                if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+                m_mapping = nullptr;
+                m_file    = INVALID_HANDLE_VALUE;
+#elif defined(NBL_REFLECT_POSIX_MMAP)
+                if (m_data)      munmap(m_data, m_size);
+                if (m_file >= 0) close(m_file);
+                m_file = -1;
+#endif
+                m_data = nullptr;
+            }
+
+#if defined(_WIN32)
+            HANDLE m_file    = INVALID_HANDLE_VALUE;
+            HANDLE m_mapping = nullptr;
+#elif defined(NBL_REFLECT_POSIX_MMAP)
+            int    m_file    = -1;
+#endif
+            void*  m_data    = nullptr;
+            size_t m_size    = 0;
+        };
+    }
+
+    auto ShaderCode::fromWords(std::vector<uint32_t>&& words) -> ShaderCode
+    {
+        auto storage = std::make_shared<const std::vector<uint32_t>>(std::move(words));
+
+        ShaderCode result;
+        result.m_words = *storage;
+        result.m_owner = std::move(storage);
+        return result;
+    }
+
+    auto ShaderCode::fromBytes(const std::span<const char> bytes) -> ShaderCode
+    {
+        if (bytes.size() % sizeof(uint32_t) != 0)
+        {
+            throw std::runtime_error("SPIR-V code size is not a multiple of 4 bytes.");
+        }
+
+        std::vector<uint32_t> words(bytes.size() / sizeof(uint32_t));
+        std::memcpy(words.data(), bytes.data(), bytes.size());
+        return fromWords(std::move(words));
+    }
+
+    auto ShaderCode::fromView(const std::span<const uint32_t> words, std::shared_ptr<const void> owner) -> ShaderCode
+    {
+        ShaderCode result;
+        result.m_words = words;
+        result.m_owner = std::move(owner);
+        return result;
+    }
+
+    auto ShaderCode::readFile(const std::string& filePath) -> ShaderCode
+    {
+        std::ifstream file(filePath.c_str(), std::ios::ate | std::ios::binary);
+
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file: " + filePath);
+        }
+
+        const std::streamsize fileSize = file.tellg();
+        if (fileSize % sizeof(uint32_t) != 0)
+        {
+            throw std::runtime_error("SPIR-V code size is not a multiple of 4 bytes: " + filePath);
+        }
+
+        std::vector<uint32_t> words(fileSize / sizeof(uint32_t));
+
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(words.data()), fileSize);
+        file.close();
+
+        return fromWords(std::move(words));
+    }
+
+    auto ShaderCode::mapFile(const std::string& filePath) -> ShaderCode
+    {
+#if defined(_WIN32) || defined(NBL_REFLECT_POSIX_MMAP)
+        auto mapping = std::make_shared<const MappedFile>(filePath);
+        if (mapping->size() % sizeof(uint32_t) != 0)
+        {
+            throw std::runtime_error("SPIR-V code size is not a multiple of 4 bytes: " + filePath);
+        }
+
+        // Mappings are page aligned, so the words can be referenced directly
+        const std::span words(static_cast<const uint32_t*>(mapping->data()), mapping->size() / sizeof(uint32_t));
+        return fromView(words, std::move(mapping));
+#else
+        return readFile(filePath);
+#endif
+    }
+}
@@ -0,0 +1,339 @@
+#include "reflect/ShaderPack.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "reflect/ShaderReflectionCache.hpp"
+#include "reflect/ShaderReflectionSerializer.hpp"
+
+namespace nbl
+{
+    namespace
+    {
+        // Layout: header, entries sorted by name, blobs, string pool, code (aligned), reflection records
+        struct PackHeader
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t blobCount;
+            uint64_t stringsOffset;
+            uint64_t stringsSize;
+            uint64_t fileSize;
+        };
+
+        struct PackEntry
+        {
+            uint32_t nameOffset;
+            uint32_t nameSize;
+            uint32_t blob;
+            uint32_t reserved;
+        };
+
+        struct PackBlob
+        {
+            uint64_t codeOffset;
+            uint64_t codeSize;
+            uint64_t recordOffset;
+            uint64_t recordSize;
+            uint64_t codeHash;
+        };
+
+        template <typename T>
+        auto read(const char* bytes, const uint64_t offset) -> T
+        {
+            T value;
+            std::memcpy(&value, bytes + offset, sizeof(T));
+            return value;
+        }
+
+        auto alignUp(const uint64_t value, const uint64_t alignment) -> uint64_t
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        auto isInRange(const uint64_t offset, const uint64_t size, const uint64_t limit) -> bool
+        {
+            return offset <= limit && size <= limit - offset;
+        }
+    }
+
+    ShaderPack::ShaderPack(ShaderCode pack)
+        : m_pack(std::move(pack))
+    {
+        const uint64_t packSize = m_pack.sizeInBytes();
+        if (packSize < sizeof(PackHeader))
+        {
+            throw std::runtime_error("Invalid shader pack: truncated header.");
+        }
+
+        const auto header = read<PackHeader>(bytes(), 0);
+        if (header.magic != kMagic || header.version != kFormatVersion)
+        {
+            throw std::runtime_error("Invalid shader pack: unknown magic or format version " + std::to_string(header.version) + ".");
+        }
+
+        m_entryCount    = header.entryCount;
+        m_blobCount     = header.blobCount;
+        m_entriesOffset = sizeof(PackHeader);
+        m_blobsOffset   = m_entriesOffset + static_cast<uint64_t>(m_entryCount) * sizeof(PackEntry);
+        m_stringsOffset = header.stringsOffset;
+        m_stringsSize   = header.stringsSize;
+
+        const uint64_t blobsEnd = m_blobsOffset + static_cast<uint64_t>(m_blobCount) * sizeof(PackBlob);
+        if (header.fileSize != packSize || blobsEnd > packSize || m_stringsOffset < blobsEnd || !isInRange(m_stringsOffset, m_stringsSize, packSize))
+        {
+            throw std::runtime_error("Invalid shader pack: index out of bounds.");
+        }
+    }
+
+    auto ShaderPack::open(const std::string& filePath) -> ShaderPack
+    {
+        return ShaderPack(ShaderCode::mapFile(filePath));
+    }
+
+    auto ShaderPack::getEntryName(const size_t index) const -> std::string_view
+    {
+        if (index >= m_entryCount)
+        {
+            throw std::runtime_error("Shader pack entry index out of range: " + std::to_string(index));
+        }
+
+        const auto entry = read<PackEntry>(bytes(), m_entriesOffset + index * sizeof(PackEntry));
+        if (!isInRange(entry.nameOffset, entry.nameSize, m_stringsSize))
+        {
+            throw std::runtime_error("Invalid shader pack: entry name out of bounds.");
+        }
+        return { bytes() + m_stringsOffset + entry.nameOffset, entry.nameSize };
+    }
+
+    auto ShaderPack::contains(const std::string_view name) const -> bool
+    {
+        return findEntry(name) < m_entryCount;
+    }
+
+    auto ShaderPack::getShaderCode(const std::string_view name) const -> ShaderCode
+    {
+        const Blob blob = findBlob(name);
+        return m_pack.subspan(blob.codeOffset / sizeof(uint32_t), blob.codeSize / sizeof(uint32_t));
+    }
+
+    auto ShaderPack::getCodeHash(const std::string_view name) const -> uint64_t
+    {
+        return findBlob(name).codeHash;
+    }
+
+    auto ShaderPack::reflectShader(const std::string_view name) const -> ShaderReflectionData
+    {
+        const Blob blob = findBlob(name);
+
+        ShaderReflectionData result;
+        if (!ShaderReflectionSerializer::deserialize({ bytes() + blob.recordOffset, blob.recordSize }, result))
+        {
+            throw std::runtime_error("Invalid shader pack: corrupt reflection record for " + std::string(name));
+        }
+
+        result.sourceFile = name;
+        result.shaderName = ShaderReflection::getShaderNameFromFilePath(result.sourceFile);
+        result.shaderCode = m_pack.subspan(blob.codeOffset / sizeof(uint32_t), blob.codeSize / sizeof(uint32_t));
+        return result;
+    }
+
+    auto ShaderPack::reflectPipeline(const std::vector<std::string>& names) const -> PipelineReflectionData
+    {
+        std::vector<ShaderReflectionData> shaderData;
+        shaderData.reserve(names.size());
+        for (const auto& name : names)
+        {
+            shaderData.push_back(reflectShader(name));
+        }
+        return ShaderReflection::mergePipelineShaders(std::move(shaderData));
+    }
+
+    auto ShaderPack::reflectPipelineStages(const std::vector<ShaderStageSource>& stages) const -> PipelineReflectionData
+    {
+        std::vector<ShaderReflectionData> shaderData;
+        shaderData.reserve(stages.size());
+        for (const auto& stage : stages)
+        {
+            shaderData.push_back(reflectShader(makeEntryName(stage.filePath, stage.entryPoint)));
+        }
+        return ShaderReflection::mergePipelineShaders(std::move(shaderData));
+    }
+
+    auto ShaderPack::makeEntryName(const std::string_view name, const std::string_view entryPoint) -> std::string
+    {
+        std::string result(name);
+        if (!entryPoint.empty())
+        {
+            result += '#';
+            result += entryPoint;
+        }
+        return result;
+    }
+
+    auto ShaderPack::findEntry(const std::string_view name) const -> size_t
+    {
+        // Entries are sorted by name, lower bound by binary search
+        size_t first = 0, count = m_entryCount;
+        while (count > 0)
+        {
+            const size_t step = count / 2;
+            if (getEntryName(first + step) < name)
+            {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+        return first < m_entryCount && getEntryName(first) == name ? first : m_entryCount;
+    }
+
+    auto ShaderPack::findBlob(const std::string_view name) const -> Blob
+    {
+        const size_t entry = findEntry(name);
+        if (entry >= m_entryCount)
+        {
+            throw std::runtime_error("Shader pack has no entry named " + std::string(name));
+        }
+        return readBlob(read<PackEntry>(bytes(), m_entriesOffset + entry * sizeof(PackEntry)).blob);
+    }
+
+    auto ShaderPack::readBlob(const uint32_t index) const -> Blob
+    {
+        if (index >= m_blobCount)
+        {
+            throw std::runtime_error("Invalid shader pack: blob index out of range.");
+        }
+
+        const auto blob = read<PackBlob>(bytes(), m_blobsOffset + static_cast<uint64_t>(index) * sizeof(PackBlob));
+        const uint64_t packSize = m_pack.sizeInBytes();
+        if (blob.codeOffset % kBlobAlignment != 0 || blob.codeSize % sizeof(uint32_t) != 0
+            || !isInRange(blob.codeOffset, blob.codeSize, packSize) || !isInRange(blob.recordOffset, blob.recordSize, packSize))
+        {
+            throw std::runtime_error("Invalid shader pack: blob out of bounds.");
+        }
+        return { blob.codeOffset, blob.codeSize, blob.recordOffset, blob.recordSize, blob.codeHash };
+    }
+
+    void ShaderPackWriter::add(const std::string& name, const ShaderReflectionData& shaderData)
+    {
+        if (m_entries.contains(name))
+        {
+            throw std::runtime_error("Shader pack already has an entry named " + name);
+        }
+
+        // Identical code is stored once, entry points of it reflect differently and get their own record
+        const uint64_t codeHash = ShaderReflectionCache::hashCode(shaderData.shaderCode);
+        auto code = static_cast<uint32_t>(m_codes.size());
+        const auto [first, last] = m_codesByHash.equal_range(codeHash);
+        for (auto it = first; it != last; ++it)
+        {
+            if (std::ranges::equal(m_codes[it->second].code.words(), shaderData.shaderCode.words()))
+            {
+                code = it->second;
+                break;
+            }
+        }
+        if (code == m_codes.size())
+        {
+            m_codes.push_back({ shaderData.shaderCode, codeHash });
+            m_codesByHash.emplace(codeHash, code);
+        }
+
+        const auto [blob, inserted] = m_blobsByEntryPoint.try_emplace({ code, shaderData.entryPoint }, static_cast<uint32_t>(m_blobs.size()));
+        if (inserted)
+        {
+            m_blobs.push_back({ code, shaderData.entryPoint, ShaderReflectionSerializer::serialize(shaderData) });
+        }
+        m_entries.emplace(name, blob->second);
+    }
+
+    auto ShaderPackWriter::build() const -> std::vector<char>
+    {
+        std::vector<std::pair<std::string_view, uint32_t>> entries(std::begin(m_entries), std::end(m_entries));
+        std::ranges::sort(entries);
+
+        // String pool
+        std::vector<PackEntry> packEntries;
+        std::string strings;
+        for (const auto& [name, blob] : entries)
+        {
+            packEntries.push_back({ static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(name.size()), blob, 0 });
+            strings += name;
+        }
+
+        // Code and records follow the index, code is aligned so it can be referenced in place
+        const uint64_t stringsOffset = sizeof(PackHeader) + packEntries.size() * sizeof(PackEntry) + m_blobs.size() * sizeof(PackBlob);
+        uint64_t offset = stringsOffset + strings.size();
+
+        std::vector<uint64_t> codeOffsets;
+        for (const Code& code : m_codes)
+        {
+            offset = alignUp(offset, ShaderPack::kBlobAlignment);
+            codeOffsets.push_back(offset);
+            offset += code.code.sizeInBytes();
+        }
+
+        // Blobs of the entry points of one module reference the same code
+        std::vector<PackBlob> packBlobs;
+        for (const Blob& blob : m_blobs)
+        {
+            const Code& code = m_codes[blob.code];
+            packBlobs.push_back({ codeOffsets[blob.code], code.code.sizeInBytes(), offset, blob.record.size(), code.codeHash });
+            offset += blob.record.size();
+        }
+        const uint64_t fileSize = alignUp(offset, ShaderPack::kBlobAlignment);
+
+        std::vector<char> result(fileSize);
+        const auto put = [&](const uint64_t at, const void* data, const size_t size) {
+            if (size > 0)
+            {
+                std::memcpy(result.data() + at, data, size);
+            }
+        };
+
+        const PackHeader header {
+            .magic         = ShaderPack::kMagic,
+            .version       = ShaderPack::kFormatVersion,
+            .entryCount    = static_cast<uint32_t>(packEntries.size()),
+            .blobCount     = static_cast<uint32_t>(packBlobs.size()),
+            .stringsOffset = stringsOffset,
+            .stringsSize   = strings.size(),
+            .fileSize      = fileSize,
+        };
+        put(0, &header, sizeof(PackHeader));
+        put(sizeof(PackHeader), packEntries.data(), packEntries.size() * sizeof(PackEntry));
+        put(sizeof(PackHeader) + packEntries.size() * sizeof(PackEntry), packBlobs.data(), packBlobs.size() * sizeof(PackBlob));
+        put(stringsOffset, strings.data(), strings.size());
+        for (size_t i = 0; i < m_codes.size(); ++i)
+        {
+            put(codeOffsets[i], m_codes[i].code.data(), m_codes[i].code.sizeInBytes());
+        }
+        for (size_t i = 0; i < m_blobs.size(); ++i)
+        {
+            put(packBlobs[i].recordOffset, m_blobs[i].record.data(), m_blobs[i].record.size());
+        }
+
+        return result;
+    }
+
+    void ShaderPackWriter::write(const std::string& filePath) const
+    {
+        const std::vector<char> pack = build();
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file: " + filePath);
+        }
+        file.write(pack.data(), static_cast<std::streamsize>(pack.size()));
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write shader pack: " + filePath);
+        }
+    }
+}
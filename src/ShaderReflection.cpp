@@ -1,14 +1,65 @@
 #include "reflect/ShaderReflection.hpp"
+#include "reflect/ReflectionHash.hpp"
+#include "reflect/ReflectionStats.hpp"
+#include "reflect/ShaderReflectionCache.hpp"
+#include "SpirvScanner.hpp"
 
-#include <ranges>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <unordered_map>
 
 namespace nbl
 {
+    auto ShaderReflectionBlock::findMember(const std::string_view path) const -> const ShaderReflectionBlockMember*
+    {
+        const std::vector<ShaderReflectionBlockMember>* scope = &members;
+        const ShaderReflectionBlockMember* member = nullptr;
+
+        size_t begin = 0;
+        while (begin <= path.size())
+        {
+            const size_t end = std::min(path.find('.', begin), path.size());
+            const std::string_view name = path.substr(begin, end - begin);
+
+            const auto it = std::ranges::find(*scope, name, &ShaderReflectionBlockMember::name);
+            if (name.empty() || it == std::end(*scope))
+            {
+                return nullptr;
+            }
+            member = &*it;
+            scope  = &member->members;
+            begin  = end + 1;
+        }
+
+        return member;
+    }
+
+    auto ShaderReflectionData::findBlock(const std::string_view name) const -> const ShaderReflectionBlock*
+    {
+        const auto it = std::ranges::find_if(blocks, [&](const ShaderReflectionBlock& block) {
+            return block.name == name || block.typeName == name;
+        });
+        return it != std::end(blocks) ? &*it : nullptr;
+    }
+
+    auto PipelineReflectionData::findBlock(const std::string_view name) const -> const ShaderReflectionBlock*
+    {
+        for (const auto& shader : shaderData)
+        {
+            if (const ShaderReflectionBlock* block = shader.findBlock(name))
+            {
+                return block;
+            }
+        }
+        return nullptr;
+    }
+
     auto ShaderReflectionData::getShaderModuleCreateInfo() const -> vk::ShaderModuleCreateInfo
     {
         return vk::ShaderModuleCreateInfo()
-            .setPCode(reinterpret_cast<const uint32_t*>(shaderCode.data()))
-            .setCodeSize(sizeof(char) * shaderCode.size());
+            .setPCode(shaderCode.data())
+            .setCodeSize(shaderCode.sizeInBytes());
     }
 
     auto ShaderReflectionData::getPipelineStageCreateInfo() const -> vk::PipelineShaderStageCreateInfo
@@ -18,104 +69,569 @@ namespace nbl
             .setPName(entryPoint.c_str());
     }
 
-    auto ShaderReflection::reflectShader(const std::string& filePath) -> ShaderReflectionData
+    auto ShaderReflection::reflectShader(const std::string& filePath, const ReflectionBackend backend) -> ShaderReflectionData
+    {
+        ShaderCode shaderCode;
+        {
+            NBL_REFLECT_STATS_SCOPE(ioTimer, ReflectionPhase::eFileIO, filePath, 0);
+            shaderCode = ShaderCode::mapFile(filePath);
+            NBL_REFLECT_STATS_SET_BYTES(ioTimer, shaderCode.sizeInBytes());
+        }
+        return reflectShader(shaderCode, filePath, backend);
+    }
+
+    auto ShaderReflection::reflectShader(const std::string& filePath, ShaderReflectionCache& cache, const ReflectionBackend backend) -> ShaderReflectionData
+    {
+        return cache.reflectShader(filePath, backend);
+    }
+
+    auto ShaderReflection::reflectShader(const std::span<const uint32_t> shaderCode, const std::string& sourceName, const ReflectionBackend backend) -> ShaderReflectionData
+    {
+        return reflectShader(ShaderCode::fromView(shaderCode), sourceName, backend);
+    }
+
+    auto ShaderReflection::reflectShader(const ShaderCode& shaderCode, const std::string& sourceName, const ReflectionBackend backend) -> ShaderReflectionData
+    {
+        return std::move(reflectEntryPoints(shaderCode, sourceName, backend, false).front());
+    }
+
+    auto ShaderReflection::reflectModule(const std::string& filePath, const ReflectionBackend backend) -> std::vector<ShaderReflectionData>
+    {
+        ShaderCode shaderCode;
+        {
+            NBL_REFLECT_STATS_SCOPE(ioTimer, ReflectionPhase::eFileIO, filePath, 0);
+            shaderCode = ShaderCode::mapFile(filePath);
+            NBL_REFLECT_STATS_SET_BYTES(ioTimer, shaderCode.sizeInBytes());
+        }
+        return reflectEntryPoints(shaderCode, filePath, backend, true);
+    }
+
+    auto ShaderReflection::reflectModule(const ShaderCode& shaderCode, const std::string& sourceName, const ReflectionBackend backend) -> std::vector<ShaderReflectionData>
+    {
+        return reflectEntryPoints(shaderCode, sourceName, backend, true);
+    }
+
+    auto ShaderReflection::reflectModuleBatch(const std::vector<std::string>& filePaths, const ReflectionExecutionMode mode, const ReflectionBackend backend)
+        -> std::vector<std::vector<ShaderReflectionData>>
+    {
+        std::vector<const std::string*> files;
+        files.reserve(filePaths.size());
+        for (const auto& filePath : filePaths)
+        {
+            files.push_back(&filePath);
+        }
+
+        std::vector<std::vector<ShaderReflectionData>> result(filePaths.size());
+        forEachShaderFile(files, mode, [&](const size_t i) {
+            result[i] = reflectModule(filePaths[i], backend);
+        });
+        return result;
+    }
+
+    auto ShaderReflection::reflectEntryPoints(const ShaderCode& shaderCode, const std::string& sourceName, const ReflectionBackend backend,
+                                              const bool allEntryPoints) -> std::vector<ShaderReflectionData>
     {
-        const auto shaderBytes = loadShaderBytes(filePath);
+        NBL_REFLECT_STATS_SCOPE(reflectTimer, ReflectionPhase::eReflectShader, sourceName, shaderCode.sizeInBytes());
+
+        const auto createResult = [&]() {
+            ShaderReflectionData result;
+            result.sourceFile = sourceName;
+            result.shaderName = getShaderNameFromFilePath(sourceName);
+            result.shaderCode = shaderCode;
+            return result;
+        };
+
+        if (backend == ReflectionBackend::eFastScan)
+        {
+            std::optional<SpirvScanner> scanner;
+            {
+                NBL_REFLECT_STATS_SCOPE(moduleTimer, ReflectionPhase::eModuleCreate, sourceName, shaderCode.sizeInBytes());
+                scanner.emplace(shaderCode.words());
+            }
+            NBL_REFLECT_STATS_SCOPE(resolveTimer, ReflectionPhase::eFastScanResolve, sourceName, 0);
 
-        ShaderReflectionData result;
-        result.sourceFile = filePath;
-        result.shaderName = getShaderNameFromFilePath(filePath);
-        result.shaderCode = shaderBytes;
+            // A module without entry points still reflects one, which throws
+            const size_t nEntryPoints = allEntryPoints ? std::max<size_t>(scanner->getEntryPointCount(), 1) : 1;
+            std::vector<ShaderReflectionData> results;
+            results.reserve(nEntryPoints);
+            for (size_t i = 0; i < nEntryPoints; ++i)
+            {
+                scanner->reflect(results.emplace_back(createResult()), i);
+            }
+            return results;
+        }
 
-        // Reflection
+        // Reflection, spirv-reflect parses the words in place instead of keeping its own copy
         SpvReflectShaderModule spvShaderModule;
-        SpvReflectResult rflResult = spvReflectCreateShaderModule(shaderBytes.size() * sizeof(char), shaderBytes.data(), &spvShaderModule);
-        if (rflResult != SPV_REFLECT_RESULT_SUCCESS)
         {
-            throw std::runtime_error("Failed to create reflection shader module.");
+            NBL_REFLECT_STATS_SCOPE(moduleTimer, ReflectionPhase::eModuleCreate, sourceName, shaderCode.sizeInBytes());
+            SpvReflectResult rflResult = spvReflectCreateShaderModule2(SPV_REFLECT_MODULE_FLAG_NO_COPY, shaderCode.sizeInBytes(), shaderCode.data(), &spvShaderModule);
+            if (rflResult != SPV_REFLECT_RESULT_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create reflection shader module.");
+            }
+        }
+
+        // Resolving throws on malformed modules, the module is destroyed on every path
+        struct ModuleGuard
+        {
+            SpvReflectShaderModule* shaderModule;
+            ~ModuleGuard() { spvReflectDestroyShaderModule(shaderModule); }
+        } moduleGuard { &spvShaderModule };
+
+        if (spvShaderModule.entry_point_count == 0)
+        {
+            throw std::runtime_error("No entry point found in shader module.");
         }
 
-        result.entryPoint     = spvShaderModule.entry_point_name;
-        result.shaderStage    = convertShaderStage(spvShaderModule.shader_stage);
-        result.descriptorSets = resolveDescriptorSets(spvShaderModule);
-        result.pushConstants  = resolvePushConstants(spvShaderModule);
+        // Built on first use, only needed for specialization constants and compute, task and mesh entry points
+        std::optional<SpirvScanner> scanner;
+        const auto getScanner = [&]() -> const SpirvScanner& {
+            if (!scanner.has_value())
+            {
+                scanner.emplace(shaderCode.words());
+            }
+            return *scanner;
+        };
 
-        if (result.shaderStage == vk::ShaderStageFlagBits::eVertex)
+        std::vector<ShaderSpecializationConstant> specConstants;
+        if (spvShaderModule.spec_constant_count > 0)
         {
-            result.vertexInput = resolveVertexInput(spvShaderModule);
+            NBL_REFLECT_STATS_SCOPE(specConstantTimer, ReflectionPhase::eResolveSpecConstants, sourceName, 0);
+            specConstants = resolveSpecializationConstants(spvShaderModule, getScanner());
+        }
+
+        const uint32_t nEntryPoints = allEntryPoints ? spvShaderModule.entry_point_count : 1;
+        std::vector<ShaderReflectionData> results;
+        results.reserve(nEntryPoints);
+        for (uint32_t i = 0; i < nEntryPoints; ++i)
+        {
+            const SpvEntryPointResources resources = getEntryPointResources(spvShaderModule, i);
+
+            ShaderReflectionData& result = results.emplace_back(createResult());
+            result.entryPoint    = spvShaderModule.entry_points[i].name;
+            result.shaderStage   = resources.shaderStage;
+            result.specConstants = specConstants;
+            {
+                NBL_REFLECT_STATS_SCOPE(descriptorTimer, ReflectionPhase::eResolveDescriptorSets, sourceName, 0);
+                result.descriptorSets = resolveDescriptorSets(resources);
+            }
+            {
+                NBL_REFLECT_STATS_SCOPE(pushConstantTimer, ReflectionPhase::eResolvePushConstants, sourceName, 0);
+                result.pushConstants = resolvePushConstants(resources);
+            }
+            {
+                NBL_REFLECT_STATS_SCOPE(blockTimer, ReflectionPhase::eResolveBlocks, sourceName, 0);
+                result.blocks = resolveBlocks(resources);
+            }
+
+            if (result.shaderStage == vk::ShaderStageFlagBits::eCompute || result.shaderStage == vk::ShaderStageFlagBits::eTaskEXT
+                || result.shaderStage == vk::ShaderStageFlagBits::eMeshEXT)
+            {
+                // spirv-reflect resolves neither LocalSizeId, the WorkgroupSize built-in nor shared memory, they are read from the code
+                NBL_REFLECT_STATS_SCOPE(workgroupTimer, ReflectionPhase::eResolveWorkgroup, sourceName, 0);
+                result.workgroup = getScanner().resolveWorkgroup(i);
+            }
+
+            if (result.shaderStage == vk::ShaderStageFlagBits::eVertex)
+            {
+                NBL_REFLECT_STATS_SCOPE(vertexInputTimer, ReflectionPhase::eResolveVertexInput, sourceName, 0);
+                result.vertexInput = resolveVertexInput(resources);
+            }
         }
 
-        spvReflectDestroyShaderModule(&spvShaderModule);
+        return results;
+    }
 
+    auto ShaderReflection::selectEntryPoints(const std::vector<ShaderReflectionData>& entryPoints, const std::span<const std::string> names,
+                                             const std::string& filePath) -> std::vector<ShaderReflectionData>
+    {
+        std::vector<ShaderReflectionData> result;
+        result.reserve(names.size());
+        for (const auto& name : names)
+        {
+            const auto it = name.empty()
+                ? std::begin(entryPoints)
+                : std::ranges::find(entryPoints, name, &ShaderReflectionData::entryPoint);
+            if (it == std::end(entryPoints))
+            {
+                throw std::runtime_error("Shader module " + filePath + " has no entry point " + name);
+            }
+            result.push_back(*it);
+        }
         return result;
     }
 
-    auto ShaderReflection::reflectPipelineShaders(const std::vector<std::string>& filePaths) -> PipelineReflectionData
+    auto ShaderReflection::reflectPipelineShaders(const std::vector<std::string>& filePaths, const ReflectionExecutionMode mode,
+                                                  ShaderReflectionCache* cache, const ReflectionBackend backend) -> PipelineReflectionData
     {
-        PipelineReflectionData result;
+        return std::move(reflectPipelineBatch(std::vector<std::vector<std::string>> { filePaths }, mode, cache, backend).front());
+    }
 
-        for (const auto& path : filePaths)
+    auto ShaderReflection::reflectPipelineShaders(const std::vector<ShaderStageSource>& stages, const ReflectionExecutionMode mode,
+                                                  ShaderReflectionCache* cache, const ReflectionBackend backend) -> PipelineReflectionData
+    {
+        return std::move(reflectPipelineBatch(std::vector<std::vector<ShaderStageSource>> { stages }, mode, cache, backend).front());
+    }
+
+    auto ShaderReflection::reflectPipelineBatch(const std::vector<std::vector<std::string>>& pipelines, const ReflectionExecutionMode mode,
+                                                ShaderReflectionCache* cache, const ReflectionBackend backend) -> std::vector<PipelineReflectionData>
+    {
+        std::vector<std::vector<ShaderStageSource>> stages(pipelines.size());
+        for (size_t p = 0; p < pipelines.size(); ++p)
         {
-            result.shaderData.push_back(
-                ShaderReflection::reflectShader(path)
-            );
+            for (const auto& path : pipelines[p])
+            {
+                stages[p].push_back({ .filePath = path });
+            }
         }
+        return reflectPipelineBatch(stages, mode, cache, backend);
+    }
+
+    auto ShaderReflection::reflectPipelineBatch(const std::vector<std::vector<ShaderStageSource>>& pipelines, const ReflectionExecutionMode mode,
+                                                ShaderReflectionCache* cache, const ReflectionBackend backend) -> std::vector<PipelineReflectionData>
+    {
+        struct Module
+        {
+            const std::string*                filePath    = nullptr;
+            // Distinct entry points requested by any stage
+            std::vector<std::string>          entryPoints = {};
+            // Parallel to entryPoints
+            std::vector<ShaderReflectionData> shaderData  = {};
+        };
+
+        struct StageEntry
+        {
+            size_t module;
+            size_t entryPoint;
+        };
 
-        for (const auto& shaderData : result.shaderData)
+        // Stages of every pipeline are grouped by file, each module is loaded and reflected by a single task
+        std::vector<Module> modules;
+        std::unordered_map<std::string, size_t> moduleIndices;
+        std::vector<std::vector<StageEntry>> stageEntries(pipelines.size());
+        for (size_t p = 0; p < pipelines.size(); ++p)
         {
-            for (const auto& descriptorSet : shaderData.descriptorSets)
+            for (const auto& stage : pipelines[p])
             {
-                auto set = std::ranges::find_if(result.descriptorSets, [&](const ShaderReflectionDescriptorSet& ds) -> bool {
-                    return ds.set == descriptorSet.set;
-                });
+                const auto [it, inserted] = moduleIndices.try_emplace(std::filesystem::path(stage.filePath).lexically_normal().string(), modules.size());
+                if (inserted)
+                {
+                    modules.push_back({ .filePath = &stage.filePath });
+                }
 
-                if (std::end(result.descriptorSets) == set)
+                std::vector<std::string>& entryPoints = modules[it->second].entryPoints;
+                const auto entryPoint = std::ranges::find(entryPoints, stage.entryPoint);
+                stageEntries[p].push_back({ it->second, static_cast<size_t>(entryPoint - std::begin(entryPoints)) });
+                if (entryPoint == std::end(entryPoints))
                 {
-                    result.descriptorSets.push_back(descriptorSet);
+                    entryPoints.push_back(stage.entryPoint);
                 }
-                else
+            }
+        }
+
+        std::vector<const std::string*> paths;
+        paths.reserve(modules.size());
+        for (const auto& module : modules)
+        {
+            paths.push_back(module.filePath);
+        }
+
+        // Every pipeline waits on its distinct modules, the task finishing the last one merges it
+        std::vector<std::vector<size_t>> dependents(modules.size());
+        std::vector<std::atomic<size_t>> pending(pipelines.size());
+        for (size_t p = 0; p < pipelines.size(); ++p)
+        {
+            size_t nModules = 0;
+            for (const StageEntry& stage : stageEntries[p])
+            {
+                std::vector<size_t>& pipelinesOfModule = dependents[stage.module];
+                if (pipelinesOfModule.empty() || pipelinesOfModule.back() != p)
                 {
-                    for (const auto& binding : descriptorSet.bindings)
-                    {
-                        auto b = std::ranges::find_if(set->bindings, [&](const vk::DescriptorSetLayoutBinding& dlb) -> bool {
-                            return dlb.binding == binding.binding;
-                        });
-                        if (b == std::end(set->bindings))
-                        {
-                            set->bindings.push_back(binding);
-                        }
-                    }
+                    pipelinesOfModule.push_back(p);
+                    ++nModules;
+                }
+            }
+            pending[p].store(nModules, std::memory_order_relaxed);
+        }
+
+        std::vector<PipelineReflectionData> result(pipelines.size());
+        const auto mergePipeline = [&](const size_t p) {
+            // Stages copy their module's result, the copies share the module's code
+            std::vector<ShaderReflectionData> shaderData;
+            shaderData.reserve(stageEntries[p].size());
+            for (const StageEntry& stage : stageEntries[p])
+            {
+                shaderData.push_back(modules[stage.module].shaderData[stage.entryPoint]);
+            }
+            result[p] = mergePipelineShaders(std::move(shaderData));
+        };
+
+        for (size_t p = 0; p < pipelines.size(); ++p)
+        {
+            if (pending[p].load(std::memory_order_relaxed) == 0)
+            {
+                mergePipeline(p);
+            }
+        }
+
+        forEachShaderFile(paths, mode, [&](const size_t i) {
+            Module& module = modules[i];
+            if (cache)
+            {
+                module.shaderData = cache->reflectEntryPoints(*module.filePath, module.entryPoints, backend);
+            }
+            else if (std::ranges::all_of(module.entryPoints, [](const std::string& name) { return name.empty(); }))
+            {
+                module.shaderData = { ShaderReflection::reflectShader(*module.filePath, backend) };
+            }
+            else
+            {
+                module.shaderData = selectEntryPoints(ShaderReflection::reflectModule(*module.filePath, backend), module.entryPoints, *module.filePath);
+            }
+
+            // Release publishes this module's result, acquire sees the results of the modules finished by other workers
+            for (const size_t p : dependents[i])
+            {
+                if (pending[p].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    mergePipeline(p);
+                }
+            }
+        });
+
+        return result;
+    }
+
+    auto ShaderReflection::mergePipelineShaders(std::vector<ShaderReflectionData>&& shaderData) -> PipelineReflectionData
+    {
+#ifdef NBL_REFLECT_ENABLE_STATS
+        // Label the merge after its first stage, only built while recording
+        std::string label;
+        if (ReflectionStats::isEnabled() && !shaderData.empty())
+        {
+            label = shaderData.front().sourceFile + (shaderData.size() > 1 ? " (+" + std::to_string(shaderData.size() - 1) + ")" : "");
+        }
+#endif
+        NBL_REFLECT_STATS_SCOPE(mergeTimer, ReflectionPhase::eMerge, label, 0);
+
+        PipelineReflectionData result;
+        result.shaderData     = std::move(shaderData);
+        result.descriptorSets = mergeDescriptorSets(result.shaderData, result.conflicts);
+        result.pushConstants  = mergePushConstants(result.shaderData);
+
+        NBL_REFLECT_STATS_PIPELINE(result, mergeTimer);
+        return result;
+    }
+
+    auto ShaderReflection::collectShaderModules(const std::span<const PipelineReflectionData> pipelines) -> ShaderModuleSet
+    {
+        ShaderModuleSet result;
+        result.stageModules.resize(pipelines.size());
+
+        // Stages reflected from the same module share its words, only code at an unknown address is hashed
+        std::unordered_map<const uint32_t*, uint32_t> addressIndices;
+        std::unordered_multimap<uint64_t, uint32_t> hashIndices;
+        for (size_t p = 0; p < pipelines.size(); ++p)
+        {
+            for (const auto& shader : pipelines[p].shaderData)
+            {
+                const ShaderCode& code = shader.shaderCode;
+                if (code.empty())
+                {
+                    result.stageModules[p].push_back(~0u);
+                    continue;
+                }
 
-                    for (auto&& [resultSet, shaderSet] : std::views::zip(set->bindings, descriptorSet.bindings))
+                if (const auto it = addressIndices.find(code.data());
+                    it != std::end(addressIndices) && result.modules[it->second].sizeInBytes() == code.sizeInBytes())
+                {
+                    result.stageModules[p].push_back(it->second);
+                    continue;
+                }
+
+                const uint64_t hash = ReflectionHash::hashBytes(code.data(), code.sizeInBytes());
+                uint32_t index = ~0u;
+                for (auto [it, last] = hashIndices.equal_range(hash); it != last; ++it)
+                {
+                    if (std::ranges::equal(result.modules[it->second].words(), code.words()))
                     {
-                        resultSet.stageFlags |= shaderSet.stageFlags;
+                        index = it->second;
+                        break;
                     }
                 }
+                if (index == ~0u)
+                {
+                    index = static_cast<uint32_t>(result.modules.size());
+                    result.modules.push_back(code);
+                    hashIndices.emplace(hash, index);
+                }
+
+                addressIndices.insert_or_assign(code.data(), index);
+                result.stageModules[p].push_back(index);
             }
+        }
+
+        return result;
+    }
+
+    auto ShaderReflection::mergeDescriptorSets(const std::vector<ShaderReflectionData>& shaderData,
+                                               std::vector<ShaderReflectionConflict>& conflicts) -> std::vector<ShaderReflectionDescriptorSet>
+    {
+        struct BindingEntry
+        {
+            uint32_t                              set;
+            uint32_t                              stage;
+            const vk::DescriptorSetLayoutBinding* binding;
+        };
 
-            for (const auto& pushConstant : shaderData.pushConstants)
+        size_t nBindings = 0;
+        for (const auto& shader : shaderData)
+        {
+            for (const auto& descriptorSet : shader.descriptorSets)
             {
-                auto pc = std::ranges::find_if(result.pushConstants, [&](const vk::PushConstantRange& ps) -> bool {
-                    return pushConstant.size == ps.size && pushConstant.offset == ps.offset;
-                });
+                nBindings += descriptorSet.bindings.size();
+            }
+        }
 
-                if (std::end(result.pushConstants) == pc)
+        std::vector<BindingEntry> entries;
+        entries.reserve(nBindings);
+        for (uint32_t stage = 0; stage < shaderData.size(); ++stage)
+        {
+            for (const auto& descriptorSet : shaderData[stage].descriptorSets)
+            {
+                for (const auto& binding : descriptorSet.bindings)
                 {
-                    result.pushConstants.push_back(pushConstant);
+                    entries.push_back({ descriptorSet.set, stage, &binding });
                 }
-                else
+            }
+        }
+
+        // Stable, so within a (set, binding) key the first stage declaring it stays first
+        std::ranges::stable_sort(entries, {}, [](const BindingEntry& e) {
+            return static_cast<uint64_t>(e.set) << 32 | e.binding->binding;
+        });
+
+        std::vector<ShaderReflectionDescriptorSet> result;
+        for (size_t i = 0; i < entries.size();)
+        {
+            const BindingEntry& first = entries[i];
+            vk::DescriptorSetLayoutBinding merged = *first.binding;
+
+            size_t j = i + 1;
+            for (; j < entries.size() && entries[j].set == first.set && entries[j].binding->binding == merged.binding; ++j)
+            {
+                const vk::DescriptorSetLayoutBinding& other = *entries[j].binding;
+                merged.stageFlags |= other.stageFlags;
+
+                if (other.descriptorType != merged.descriptorType)
                 {
-                    pc->stageFlags |= pushConstant.stageFlags;
+                    conflicts.push_back({
+                        .set     = first.set,
+                        .binding = merged.binding,
+                        .message = shaderData[first.stage].shaderName + " declares " + vk::to_string(merged.descriptorType) + ", "
+                                 + shaderData[entries[j].stage].shaderName + " declares " + vk::to_string(other.descriptorType),
+                    });
                 }
+                if (other.descriptorCount != merged.descriptorCount)
+                {
+                    conflicts.push_back({
+                        .set     = first.set,
+                        .binding = merged.binding,
+                        .message = shaderData[first.stage].shaderName + " declares " + std::to_string(merged.descriptorCount) + " descriptors, "
+                                 + shaderData[entries[j].stage].shaderName + " declares " + std::to_string(other.descriptorCount),
+                    });
+                    // The layout has to be large enough for every stage, runtime arrays (count 0) stay unbounded
+                    merged.descriptorCount = merged.descriptorCount == 0 || other.descriptorCount == 0
+                        ? 0
+                        : std::max(merged.descriptorCount, other.descriptorCount);
+                }
+            }
+
+            if (result.empty() || result.back().set != first.set)
+            {
+                result.push_back({ .set = first.set });
+            }
+            result.back().bindings.push_back(merged);
+            i = j;
+        }
+
+        return result;
+    }
+
+    auto ShaderReflection::mergePushConstants(const std::vector<ShaderReflectionData>& shaderData) -> std::vector<vk::PushConstantRange>
+    {
+        std::vector<vk::PushConstantRange> ranges;
+        for (const auto& shader : shaderData)
+        {
+            ranges.insert(std::end(ranges), std::begin(shader.pushConstants), std::end(shader.pushConstants));
+        }
+
+        std::ranges::sort(ranges, {}, [](const vk::PushConstantRange& pc) {
+            return static_cast<uint64_t>(pc.offset) << 32 | pc.size;
+        });
+
+        // Overlapping ranges are coalesced, a stage may only appear in a single range of a pipeline layout
+        std::vector<vk::PushConstantRange> result;
+        for (const auto& range : ranges)
+        {
+            if (!result.empty() && range.offset < result.back().offset + result.back().size)
+            {
+                auto& merged = result.back();
+                merged.size        = std::max(merged.offset + merged.size, range.offset + range.size) - merged.offset;
+                merged.stageFlags |= range.stageFlags;
+            }
+            else
+            {
+                result.push_back(range);
             }
         }
 
         return result;
     }
 
-    auto ShaderReflection::resolveDescriptorSets(const SpvReflectShaderModule& shaderModule) -> std::vector<ShaderReflectionDescriptorSet>
+    auto ShaderReflection::getEntryPointResources(const SpvReflectShaderModule& shaderModule, const uint32_t entryPoint) -> SpvEntryPointResources
+    {
+        SpvEntryPointResources resources;
+
+        // spirv-reflect's module wide data covers every declared resource, the same as a single entry point always got
+        if (shaderModule.entry_point_count == 1)
+        {
+            resources.shaderStage    = convertShaderStage(shaderModule.shader_stage);
+            resources.descriptorSets = { shaderModule.descriptor_sets, shaderModule.descriptor_set_count };
+            resources.inputVariables = { shaderModule.input_variables, shaderModule.input_variable_count };
+            for (uint32_t i = 0; i < shaderModule.push_constant_block_count; ++i)
+            {
+                resources.pushConstants.push_back(&shaderModule.push_constant_blocks[i]);
+            }
+            return resources;
+        }
+
+        // Statically used resources only, other entry points of the module may declare bindings this one never accesses
+        const SpvReflectEntryPoint& spvEntryPoint = shaderModule.entry_points[entryPoint];
+        resources.shaderStage    = convertShaderStage(spvEntryPoint.shader_stage);
+        resources.descriptorSets = { spvEntryPoint.descriptor_sets, spvEntryPoint.descriptor_set_count };
+        resources.inputVariables = { spvEntryPoint.input_variables, spvEntryPoint.input_variable_count };
+
+        uint32_t nPushConstants = 0;
+        if (spvReflectEnumerateEntryPointPushConstantBlocks(&shaderModule, spvEntryPoint.name, &nPushConstants, nullptr) != SPV_REFLECT_RESULT_SUCCESS)
+        {
+            throw std::runtime_error("Failed to enumerate push constants of entry point " + std::string(spvEntryPoint.name));
+        }
+        std::vector<SpvReflectBlockVariable*> pushConstants(nPushConstants);
+        if (nPushConstants > 0
+            && spvReflectEnumerateEntryPointPushConstantBlocks(&shaderModule, spvEntryPoint.name, &nPushConstants, pushConstants.data()) != SPV_REFLECT_RESULT_SUCCESS)
+        {
+            throw std::runtime_error("Failed to enumerate push constants of entry point " + std::string(spvEntryPoint.name));
+        }
+        resources.pushConstants.assign(std::begin(pushConstants), std::end(pushConstants));
+
+        return resources;
+    }
+
+    auto ShaderReflection::resolveDescriptorSets(const SpvEntryPointResources& resources) -> std::vector<ShaderReflectionDescriptorSet>
     {
-        const uint32_t nDescriptorSets = shaderModule.descriptor_set_count;
+        const size_t nDescriptorSets = resources.descriptorSets.size();
         if (nDescriptorSets == 0)
         {
             return {};
@@ -123,16 +639,16 @@ namespace nbl
 
         // Get Descriptor Sets
         std::vector<ShaderReflectionDescriptorSet> result(nDescriptorSets);
-        for (uint32_t set = 0; set < nDescriptorSets; ++set)
+        for (size_t set = 0; set < nDescriptorSets; ++set)
         {
             ShaderReflectionDescriptorSet& descriptorSet = result[set];
-            const SpvReflectDescriptorSet spvDescriptorSet = shaderModule.descriptor_sets[set];
+            const SpvReflectDescriptorSet& spvDescriptorSet = resources.descriptorSets[set];
 
             // Get Bindings
             const uint32_t nBindings = spvDescriptorSet.binding_count;
             if (nBindings == 0)
             {
-                throw std::runtime_error("No bindings found for descriptor set #" + set);
+                throw std::runtime_error("No bindings found for descriptor set #" + std::to_string(spvDescriptorSet.set));
             }
 
             std::vector<vk::DescriptorSetLayoutBinding> bindings(nBindings);
@@ -143,52 +659,189 @@ namespace nbl
                     .setDescriptorCount(spvDescriptorBinding->count)
                     .setBinding(spvDescriptorBinding->binding)
                     .setDescriptorType(convertDescriptorType(spvDescriptorBinding->descriptor_type))
-                    .setStageFlags(convertShaderStage(shaderModule.shader_stage));
+                    .setStageFlags(resources.shaderStage);
             }
 
-            descriptorSet.set      = set;
+            descriptorSet.set      = spvDescriptorSet.set;
             descriptorSet.bindings = bindings;
         }
 
         return result;
     }
 
-    auto ShaderReflection::resolvePushConstants(const SpvReflectShaderModule& shaderModule) -> std::vector<vk::PushConstantRange>
+    auto ShaderReflection::resolvePushConstants(const SpvEntryPointResources& resources) -> std::vector<vk::PushConstantRange>
     {
-        const uint32_t nPushConstants = shaderModule.push_constant_block_count;
-        if (nPushConstants == 0)
+        std::vector<vk::PushConstantRange> pushConstants;
+        pushConstants.reserve(resources.pushConstants.size());
+        for (const SpvReflectBlockVariable* spvPushConstant : resources.pushConstants)
         {
-            return {};
-        }
-
-        std::vector<vk::PushConstantRange> pushConstants(nPushConstants);
-        for (uint32_t i = 0; i < nPushConstants; ++i)
-        {
-            const SpvReflectBlockVariable spvPushConstant = shaderModule.push_constant_blocks[i];
-            pushConstants[i] = vk::PushConstantRange()
-                .setStageFlags(convertShaderStage(shaderModule.shader_stage))
-                .setOffset(spvPushConstant.offset)
-                .setSize(spvPushConstant.size);
+            pushConstants.push_back(vk::PushConstantRange()
+                .setStageFlags(resources.shaderStage)
+                .setOffset(spvPushConstant->offset)
+                .setSize(spvPushConstant->size));
         }
 
         return pushConstants;
     }
 
-    auto ShaderReflection::resolveVertexInput(const SpvReflectShaderModule& shaderModule) -> ShaderReflectionVertexInput
+    auto ShaderReflection::resolveVertexInput(const SpvEntryPointResources& resources) -> ShaderReflectionVertexInput
     {
         ShaderReflectionVertexInput result;
 
-        // Input Variables
-        const uint32_t nInputVars = shaderModule.input_variable_count;
-        for (uint32_t i = 0; i < nInputVars; ++i)
+        // Input Variables, built-ins such as gl_VertexIndex are not fetched from vertex buffers
+        std::vector<const SpvReflectInterfaceVariable*> inputVars;
+        for (const SpvReflectInterfaceVariable* spvInputVar : resources.inputVariables)
+        {
+            if ((spvInputVar->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN) == 0)
+            {
+                inputVars.push_back(spvInputVar);
+            }
+        }
+        std::ranges::sort(inputVars, {}, &SpvReflectInterfaceVariable::location);
+
+        for (const SpvReflectInterfaceVariable* spvInputVar : inputVars)
         {
-            const SpvReflectInterfaceVariable* spvInputVar = shaderModule.input_variables[i];
             const auto attrib = vk::VertexInputAttributeDescription()
                 .setLocation(spvInputVar->location)
                 .setFormat(convertFormat(spvInputVar->format));
             result.attributeDescriptions.push_back(attrib);
+            result.attributeNames.emplace_back(spvInputVar->name ? spvInputVar->name : "");
+        }
+
+        result.applyLayout(VertexInputLayout::eInterleaved);
+        return result;
+    }
+
+    auto ShaderReflection::resolveBlocks(const SpvEntryPointResources& resources) -> std::vector<ShaderReflectionBlock>
+    {
+        std::vector<ShaderReflectionBlock> result;
+
+        const auto addBlock = [&](const ShaderBlockType type, const char* name, const SpvReflectTypeDescription* typeDescription,
+                                  const uint32_t set, const uint32_t binding, const SpvReflectBlockVariable& spvBlock) {
+            ShaderReflectionBlock& block = result.emplace_back();
+            block.type     = type;
+            block.name     = name ? name : "";
+            block.typeName = typeDescription && typeDescription->type_name ? typeDescription->type_name : "";
+            block.set      = set;
+            block.binding  = binding;
+            block.members  = resolveBlockMembers(spvBlock, 0);
+            for (const auto& member : block.members)
+            {
+                block.size = std::max(block.size, member.offset + member.size);
+            }
+        };
+
+        // Descriptor sets and their bindings are already sorted by number
+        for (const SpvReflectDescriptorSet& spvDescriptorSet : resources.descriptorSets)
+        {
+            for (uint32_t b = 0; b < spvDescriptorSet.binding_count; ++b)
+            {
+                const SpvReflectDescriptorBinding* spvDescriptorBinding = spvDescriptorSet.bindings[b];
+                const vk::DescriptorType descriptorType = convertDescriptorType(spvDescriptorBinding->descriptor_type);
+                if (descriptorType != vk::DescriptorType::eUniformBuffer && descriptorType != vk::DescriptorType::eStorageBuffer)
+                {
+                    continue;
+                }
+
+                addBlock(descriptorType == vk::DescriptorType::eUniformBuffer ? ShaderBlockType::eUniformBuffer : ShaderBlockType::eStorageBuffer,
+                         spvDescriptorBinding->name, spvDescriptorBinding->type_description,
+                         spvDescriptorBinding->set, spvDescriptorBinding->binding, spvDescriptorBinding->block);
+            }
+        }
+
+        for (const SpvReflectBlockVariable* spvPushConstant : resources.pushConstants)
+        {
+            addBlock(ShaderBlockType::ePushConstant, spvPushConstant->name, spvPushConstant->type_description, 0, 0, *spvPushConstant);
+        }
+
+        return result;
+    }
+
+    auto ShaderReflection::resolveBlockMembers(const SpvReflectBlockVariable& block, const uint32_t baseOffset) -> std::vector<ShaderReflectionBlockMember>
+    {
+        std::vector<ShaderReflectionBlockMember> result(block.member_count);
+        for (uint32_t m = 0; m < block.member_count; ++m)
+        {
+            const SpvReflectBlockVariable& spvMember = block.members[m];
+            const SpvReflectTypeFlags typeFlags = spvMember.type_description ? spvMember.type_description->type_flags : 0;
+
+            ShaderReflectionBlockMember& member = result[m];
+            member.name     = spvMember.name ? spvMember.name : "";
+            member.offset   = baseOffset + spvMember.offset;
+            member.rowMajor = (spvMember.decoration_flags & SPV_REFLECT_DECORATION_ROW_MAJOR) != 0;
+            member.arrayDims.assign(spvMember.array.dims, spvMember.array.dims + spvMember.array.dims_count);
+            if ((typeFlags & SPV_REFLECT_TYPE_FLAG_ARRAY) && member.arrayDims.empty())
+            {
+                // Older spirv-reflect versions record no dimension for runtime arrays
+                member.arrayDims.push_back(0);
+            }
+            member.arrayStride  = member.arrayDims.empty() ? 0 : spvMember.array.stride;
+            member.matrixStride = (typeFlags & SPV_REFLECT_TYPE_FLAG_MATRIX) ? spvMember.numeric.matrix.stride : 0;
+
+            // Sizes are derived from the types, spirv-reflect pads the last member of a struct to 16 bytes
+            uint32_t elementSize = 0;
+            if (typeFlags & SPV_REFLECT_TYPE_FLAG_STRUCT)
+            {
+                member.members = resolveBlockMembers(spvMember, member.offset);
+                for (const auto& child : member.members)
+                {
+                    elementSize = std::max(elementSize, child.offset - member.offset + child.size);
+                }
+            }
+            else
+            {
+                const SpvReflectNumericTraits& numeric = spvMember.numeric;
+                const uint32_t scalarSize = (typeFlags & SPV_REFLECT_TYPE_FLAG_BOOL) ? 4 : numeric.scalar.width / 8;
+                if (typeFlags & SPV_REFLECT_TYPE_FLAG_MATRIX)
+                {
+                    elementSize = member.matrixStride != 0
+                        ? (member.rowMajor ? numeric.matrix.row_count : numeric.matrix.column_count) * member.matrixStride
+                        : numeric.matrix.column_count * numeric.matrix.row_count * scalarSize;
+                }
+                else if (typeFlags & SPV_REFLECT_TYPE_FLAG_VECTOR)
+                {
+                    elementSize = numeric.vector.component_count * scalarSize;
+                }
+                else
+                {
+                    elementSize = scalarSize;
+                }
+            }
+
+            member.size = elementSize;
+            if (!member.arrayDims.empty())
+            {
+                uint32_t nElements = 1;
+                for (const uint32_t dim : member.arrayDims)
+                {
+                    nElements *= dim;
+                }
+                member.size = nElements * (member.arrayStride != 0 ? member.arrayStride : elementSize);
+            }
+        }
+
+        return result;
+    }
+
+    auto ShaderReflection::resolveSpecializationConstants(const SpvReflectShaderModule& shaderModule, const SpirvScanner& scanner)
+        -> std::vector<ShaderSpecializationConstant>
+    {
+        std::vector<ShaderSpecializationConstant> result;
+        for (uint32_t i = 0; i < shaderModule.spec_constant_count; ++i)
+        {
+            const SpvReflectSpecializationConstant& spvConstant = shaderModule.spec_constants[i];
+            auto constant = scanner.resolveSpecializationConstant(spvConstant.spirv_id);
+            if (!constant.has_value())
+            {
+                continue;
+            }
+
+            constant->constantId = spvConstant.constant_id;
+            constant->name       = spvConstant.name ? spvConstant.name : "";
+            result.push_back(std::move(*constant));
         }
 
+        std::ranges::stable_sort(result, {}, &ShaderSpecializationConstant::constantId);
         return result;
     }
-}
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "reflect/ShaderReflectionCache.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include "reflect/ReflectionHash.hpp"
+#include "reflect/ReflectionStats.hpp"
+#include "reflect/ShaderReflectionSerializer.hpp"
+
+namespace nbl
+{
+    ShaderReflectionCache::ShaderReflectionCache(std::optional<std::filesystem::path> directory)
+        : m_directory(std::move(directory))
+    {
+        if (m_directory.has_value())
+        {
+            std::filesystem::create_directories(*m_directory);
+        }
+    }
+
+    auto ShaderReflectionCache::reflectShader(const std::string& filePath, const ReflectionBackend backend) -> ShaderReflectionData
+    {
+        const std::string firstEntryPoint;
+        return std::move(reflectEntryPoints(filePath, std::span(&firstEntryPoint, 1), backend).front());
+    }
+
+    auto ShaderReflectionCache::reflectEntryPoints(const std::string& filePath, const std::span<const std::string> entryPoints,
+                                                   const ReflectionBackend backend) -> std::vector<ShaderReflectionData>
+    {
+        ShaderCode shaderCode;
+        {
+            NBL_REFLECT_STATS_SCOPE(ioTimer, ReflectionPhase::eFileIO, filePath, 0);
+            shaderCode = ShaderCode::mapFile(filePath);
+            NBL_REFLECT_STATS_SET_BYTES(ioTimer, shaderCode.sizeInBytes());
+        }
+
+        uint64_t codeHash = 0;
+        {
+            NBL_REFLECT_STATS_SCOPE(hashTimer, ReflectionPhase::eCacheLookup, filePath, shaderCode.sizeInBytes());
+            codeHash = hashCode(shaderCode);
+        }
+        return reflectEntryPoints(shaderCode, codeHash, filePath, entryPoints, backend);
+    }
+
+    auto ShaderReflectionCache::reflectEntryPoints(const ShaderCode& shaderCode, const uint64_t codeHash, const std::string& sourceName,
+                                                   const std::span<const std::string> entryPoints, const ReflectionBackend backend)
+        -> std::vector<ShaderReflectionData>
+    {
+        const size_t codeSize = shaderCode.sizeInBytes();
+
+        std::vector<ShaderReflectionData> result;
+        {
+            NBL_REFLECT_STATS_SCOPE(lookupTimer, ReflectionPhase::eCacheLookup, sourceName, 0);
+            for (const auto& entryPoint : entryPoints)
+            {
+                auto cached = find(codeHash, codeSize, entryPoint, backend);
+                if (!cached.has_value())
+                {
+                    break;
+                }
+                result.push_back(std::move(*cached));
+            }
+        }
+
+        if (result.size() == entryPoints.size())
+        {
+            for (auto& cached : result)
+            {
+                cached.sourceFile = sourceName;
+                cached.shaderName = ShaderReflection::getShaderNameFromFilePath(sourceName);
+                cached.shaderCode = shaderCode;
+            }
+            return result;
+        }
+
+        // Only the first entry point is needed, modules with a single entry point never pay for reflecting the others
+        if (std::ranges::all_of(entryPoints, [](const std::string& name) { return name.empty(); }))
+        {
+            auto shaderData = ShaderReflection::reflectShader(shaderCode, sourceName, backend);
+            store(codeHash, codeSize, shaderData, {}, backend);
+            return std::vector<ShaderReflectionData>(entryPoints.size(), shaderData);
+        }
+
+        // The first entry point is stored under both its name and the empty name
+        const auto shaderData = ShaderReflection::reflectModule(shaderCode, sourceName, backend);
+        for (size_t i = 0; i < shaderData.size(); ++i)
+        {
+            if (i == 0)
+            {
+                store(codeHash, codeSize, shaderData[i], {}, backend);
+            }
+            store(codeHash, codeSize, shaderData[i], shaderData[i].entryPoint, backend);
+        }
+        return ShaderReflection::selectEntryPoints(shaderData, entryPoints, sourceName);
+    }
+
+    auto ShaderReflectionCache::find(const uint64_t codeHash, const size_t codeSize, const std::string_view entryPoint, const ReflectionBackend backend)
+        -> std::optional<ShaderReflectionData>
+    {
+        const CacheKey key = getKey(codeHash, codeSize, entryPoint, backend);
+
+        // Guards against colliding entry point name hashes
+        const auto matches = [&](const ShaderReflectionData& shaderData) {
+            return entryPoint.empty() || shaderData.entryPoint == entryPoint;
+        };
+
+        {
+            std::shared_lock lock(m_mutex);
+            if (const auto it = m_entries.find(key); it != std::end(m_entries) && matches(it->second))
+            {
+                m_hits.fetch_add(1, std::memory_order_relaxed);
+                return it->second;
+            }
+        }
+
+        auto persisted = loadEntry(key);
+        if (!persisted.has_value() || !matches(*persisted))
+        {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock lock(m_mutex);
+        m_entries.try_emplace(key, *persisted);
+        return persisted;
+    }
+
+    void ShaderReflectionCache::store(const uint64_t codeHash, const size_t codeSize, const ShaderReflectionData& shaderData, const std::string_view entryPoint,
+                                      const ReflectionBackend backend)
+    {
+        const CacheKey key = getKey(codeHash, codeSize, entryPoint, backend);
+
+        // The cached copy does not keep the shader code alive, it is provided by the caller on every hit
+        ShaderReflectionData entry;
+        entry.entryPoint     = shaderData.entryPoint;
+        entry.shaderStage    = shaderData.shaderStage;
+        entry.descriptorSets = shaderData.descriptorSets;
+        entry.pushConstants  = shaderData.pushConstants;
+        entry.vertexInput    = shaderData.vertexInput;
+        entry.blocks         = shaderData.blocks;
+        entry.specConstants  = shaderData.specConstants;
+        entry.workgroup      = shaderData.workgroup;
+
+        saveEntry(key, entry);
+
+        std::unique_lock lock(m_mutex);
+        m_entries.insert_or_assign(key, std::move(entry));
+    }
+
+    void ShaderReflectionCache::clear()
+    {
+        std::unique_lock lock(m_mutex);
+        m_entries.clear();
+    }
+
+    auto ShaderReflectionCache::hashCode(const ShaderCode& shaderCode) -> uint64_t
+    {
+        return ReflectionHash::hashBytes(shaderCode.data(), shaderCode.sizeInBytes());
+    }
+
+    auto ShaderReflectionCache::getKey(const uint64_t codeHash, const size_t codeSize, const std::string_view entryPoint, const ReflectionBackend backend)
+        -> CacheKey
+    {
+        return {
+            codeHash,
+            codeSize,
+            entryPoint.empty() ? 0 : ReflectionHash::hashBytes(entryPoint.data(), entryPoint.size()),
+            static_cast<uint64_t>(backend),
+        };
+    }
+
+    auto ShaderReflectionCache::getEntryPath(const CacheKey& key) const -> std::filesystem::path
+    {
+        char name[64] = {};
+        char* it = std::to_chars(name, name + sizeof(name), key.codeHash, 16).ptr;
+        *it++ = '-';
+        it = std::to_chars(it, name + sizeof(name), key.codeSize, 16).ptr;
+        if (key.entryPoint != 0)
+        {
+            *it++ = '-';
+            it = std::to_chars(it, name + sizeof(name), key.entryPoint, 16).ptr;
+        }
+        const char* backend = static_cast<ReflectionBackend>(key.backend) == ReflectionBackend::eFastScan ? "-fastscan" : "-spvreflect";
+        return *m_directory / (std::string(name, it) + backend + ".nblr");
+    }
+
+    auto ShaderReflectionCache::loadEntry(const CacheKey& key) const -> std::optional<ShaderReflectionData>
+    {
+        if (!m_directory.has_value())
+        {
+            return std::nullopt;
+        }
+
+        std::ifstream file(getEntryPath(key), std::ios::ate | std::ios::binary);
+        if (!file.is_open())
+        {
+            return std::nullopt;
+        }
+
+        const std::streamsize fileSize = file.tellg();
+        if (fileSize < static_cast<std::streamsize>(sizeof(CacheKey)))
+        {
+            return std::nullopt;
+        }
+
+        std::vector<char> buffer(fileSize);
+        file.seekg(0);
+        file.read(buffer.data(), fileSize);
+
+        // Guards against hash collisions in the file name and against entries copied between directories
+        CacheKey storedKey;
+        std::memcpy(&storedKey, buffer.data(), sizeof(CacheKey));
+        if (!file || storedKey != key)
+        {
+            return std::nullopt;
+        }
+
+        ShaderReflectionData result;
+        if (!ShaderReflectionSerializer::deserialize(std::span(buffer).subspan(sizeof(CacheKey)), result))
+        {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    void ShaderReflectionCache::saveEntry(const CacheKey& key, const ShaderReflectionData& shaderData) const
+    {
+        if (!m_directory.has_value())
+        {
+            return;
+        }
+
+        const auto record    = ShaderReflectionSerializer::serialize(shaderData);
+        const auto entryPath = getEntryPath(key);
+
+        // Write to a temporary file first so concurrent readers never observe a partially written entry
+        auto tempPath = entryPath;
+        tempPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                return;
+            }
+            file.write(reinterpret_cast<const char*>(&key), sizeof(CacheKey));
+            file.write(record.data(), static_cast<std::streamsize>(record.size()));
+            if (!file)
+            {
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, entryPath, ec);
+        if (ec)
+        {
+            std::filesystem::remove(tempPath, ec);
+        }
+    }
+}
@@ -0,0 +1,471 @@
+#include "reflect/ShaderReflectionDatabase.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include "reflect/ShaderReflectionCache.hpp"
+
+#if defined(__linux__)
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #define NBL_REFLECT_INOTIFY
+#endif
+
+namespace nbl
+{
+    namespace
+    {
+        auto equalDescriptorSets(const std::vector<ShaderReflectionDescriptorSet>& lhs, const std::vector<ShaderReflectionDescriptorSet>& rhs) -> bool
+        {
+            return std::ranges::equal(lhs, rhs, [](const ShaderReflectionDescriptorSet& a, const ShaderReflectionDescriptorSet& b) {
+                return a.set == b.set && a.bindings == b.bindings;
+            });
+        }
+
+        auto equalVertexInput(const std::optional<ShaderReflectionVertexInput>& lhs, const std::optional<ShaderReflectionVertexInput>& rhs) -> bool
+        {
+            if (lhs.has_value() != rhs.has_value())
+            {
+                return false;
+            }
+            return !lhs.has_value()
+                || (lhs->attributeDescriptions == rhs->attributeDescriptions && lhs->bindingDescriptions == rhs->bindingDescriptions);
+        }
+    }
+
+    ShaderReflectionDatabase::ShaderReflectionDatabase(const ReflectionBackend backend, ShaderReflectionCache* cache)
+        : m_backend(backend)
+        , m_cache(cache)
+    {
+#if defined(NBL_REFLECT_INOTIFY)
+        m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+    }
+
+    ShaderReflectionDatabase::~ShaderReflectionDatabase()
+    {
+#if defined(NBL_REFLECT_INOTIFY)
+        if (m_inotify >= 0)
+        {
+            close(m_inotify);
+        }
+#endif
+    }
+
+    auto ShaderReflectionDatabase::addPipeline(const std::vector<std::string>& filePaths) -> PipelineId
+    {
+        std::vector<ShaderStageSource> stages;
+        stages.reserve(filePaths.size());
+        for (const auto& filePath : filePaths)
+        {
+            stages.push_back({ .filePath = filePath });
+        }
+        return addPipeline(stages);
+    }
+
+    auto ShaderReflectionDatabase::addPipeline(const std::vector<ShaderStageSource>& stages) -> PipelineId
+    {
+        const auto pipelineId = static_cast<PipelineId>(m_pipelines.size());
+
+        struct LoadedShader
+        {
+            std::string                         key         = {};
+            std::string                         filePath    = {};
+            std::vector<std::string>            entryPoints = {};
+            std::vector<ShaderReflectionData>   data        = {};
+            uint64_t                            codeHash    = 0;
+        };
+
+        // Collect the entry points not reflected yet, per file
+        PipelineEntry pipeline;
+        std::vector<LoadedShader> loaded;
+        for (const auto& stage : stages)
+        {
+            std::string key = getKey(stage.filePath);
+            pipeline.stages.push_back({ key, stage.entryPoint });
+
+            const auto shader = m_shaders.find(key);
+            if (shader != std::end(m_shaders) && findEntryPoint(shader->second, stage.entryPoint) != nullptr)
+            {
+                continue;
+            }
+
+            auto it = std::ranges::find(loaded, key, &LoadedShader::key);
+            if (it == std::end(loaded))
+            {
+                it = loaded.insert(std::end(loaded), { .key = std::move(key), .filePath = stage.filePath });
+            }
+            if (std::ranges::find(it->entryPoints, stage.entryPoint) == std::end(it->entryPoints))
+            {
+                it->entryPoints.push_back(stage.entryPoint);
+            }
+        }
+
+        // Reflect first, so a failing file leaves the database untouched
+        for (auto& shader : loaded)
+        {
+            shader.data = loadShader(shader.filePath, shader.entryPoints, shader.codeHash);
+        }
+
+        for (auto& shader : loaded)
+        {
+            if (const auto it = m_shaders.find(shader.key); it != std::end(m_shaders))
+            {
+                ShaderEntry& entry = it->second;
+                entry.entryPoints.insert(std::end(entry.entryPoints), std::begin(shader.entryPoints), std::end(shader.entryPoints));
+                entry.data.insert(std::end(entry.data), std::make_move_iterator(std::begin(shader.data)), std::make_move_iterator(std::end(shader.data)));
+
+                // The file changed since its other entry points were reflected, the next poll reloads all of them
+                if (shader.codeHash != entry.codeHash)
+                {
+                    m_retry.insert(shader.key);
+                }
+                continue;
+            }
+
+            ShaderEntry entry;
+            entry.filePath    = std::move(shader.filePath);
+            entry.entryPoints = std::move(shader.entryPoints);
+            entry.data        = std::move(shader.data);
+            entry.codeHash    = shader.codeHash;
+
+            std::error_code ec;
+            entry.writeTime = std::filesystem::last_write_time(shader.key, ec);
+            entry.fileSize  = std::filesystem::file_size(shader.key, ec);
+            m_shaders.emplace(shader.key, std::move(entry));
+            watch(shader.key);
+        }
+
+        for (const auto& stage : pipeline.stages)
+        {
+            auto& users = m_shaders.at(stage.filePath).pipelines;
+            if (users.empty() || users.back() != pipelineId)
+            {
+                users.push_back(pipelineId);
+            }
+        }
+
+        pipeline.data = mergePipeline(pipeline);
+        m_pipelines.push_back(std::move(pipeline));
+        return pipelineId;
+    }
+
+    auto ShaderReflectionDatabase::getPipeline(const PipelineId pipeline) const -> const PipelineReflectionData&
+    {
+        if (pipeline >= m_pipelines.size())
+        {
+            throw std::runtime_error("Invalid pipeline id: " + std::to_string(pipeline));
+        }
+        return m_pipelines[pipeline].data;
+    }
+
+    auto ShaderReflectionDatabase::getShader(const std::string& filePath, const std::string& entryPoint) const -> const ShaderReflectionData&
+    {
+        const auto it = m_shaders.find(getKey(filePath));
+        if (it == std::end(m_shaders))
+        {
+            throw std::runtime_error("Shader is not part of the database: " + filePath);
+        }
+
+        const ShaderReflectionData* shaderData = findEntryPoint(it->second, entryPoint);
+        if (shaderData == nullptr)
+        {
+            throw std::runtime_error("Entry point \"" + entryPoint + "\" of " + filePath + " is not used by any pipeline");
+        }
+        return *shaderData;
+    }
+
+    auto ShaderReflectionDatabase::poll() -> ReflectionDatabaseUpdate
+    {
+        return reloadKeys(collectChanges());
+    }
+
+    auto ShaderReflectionDatabase::reload(const std::vector<std::string>& filePaths) -> ReflectionDatabaseUpdate
+    {
+        std::vector<std::string> keys;
+        for (const auto& filePath : filePaths)
+        {
+            std::string key = getKey(filePath);
+            if (!m_shaders.contains(key))
+            {
+                throw std::runtime_error("Shader is not part of the database: " + filePath);
+            }
+            keys.push_back(std::move(key));
+        }
+        return reloadKeys(keys);
+    }
+
+    auto ShaderReflectionDatabase::diffShader(const ShaderReflectionData& previous, const ShaderReflectionData& current) -> ReflectionChangeFlags
+    {
+        ReflectionChangeFlags changes = ReflectionChangeFlags::eNone;
+        if (!std::ranges::equal(previous.shaderCode.words(), current.shaderCode.words()))
+        {
+            changes |= ReflectionChangeFlags::eCode;
+        }
+        if (previous.shaderStage != current.shaderStage || previous.entryPoint != current.entryPoint)
+        {
+            changes |= ReflectionChangeFlags::eStage;
+        }
+        if (!equalDescriptorSets(previous.descriptorSets, current.descriptorSets))
+        {
+            changes |= ReflectionChangeFlags::eDescriptorLayout;
+        }
+        if (previous.pushConstants != current.pushConstants)
+        {
+            changes |= ReflectionChangeFlags::ePushConstants;
+        }
+        if (!equalVertexInput(previous.vertexInput, current.vertexInput))
+        {
+            changes |= ReflectionChangeFlags::eVertexInput;
+        }
+        if (previous.blocks != current.blocks)
+        {
+            changes |= ReflectionChangeFlags::eBlockLayout;
+        }
+        if (previous.specConstants != current.specConstants)
+        {
+            changes |= ReflectionChangeFlags::eSpecialization;
+        }
+        if (previous.workgroup != current.workgroup)
+        {
+            changes |= ReflectionChangeFlags::eWorkgroup;
+        }
+        return changes;
+    }
+
+    auto ShaderReflectionDatabase::diffPipeline(const PipelineReflectionData& previous, const PipelineReflectionData& current) -> ReflectionChangeFlags
+    {
+        ReflectionChangeFlags changes = ReflectionChangeFlags::eNone;
+        if (previous.shaderData.size() != current.shaderData.size())
+        {
+            changes |= ReflectionChangeFlags::eCode | ReflectionChangeFlags::eStage;
+        }
+
+        // Layout changes of a single stage only matter if they survive the merge
+        const size_t nStages = std::min(previous.shaderData.size(), current.shaderData.size());
+        for (size_t i = 0; i < nStages; ++i)
+        {
+            changes |= diffShader(previous.shaderData[i], current.shaderData[i])
+                & (ReflectionChangeFlags::eCode | ReflectionChangeFlags::eStage | ReflectionChangeFlags::eVertexInput | ReflectionChangeFlags::eBlockLayout
+                   | ReflectionChangeFlags::eSpecialization | ReflectionChangeFlags::eWorkgroup);
+        }
+
+        if (!equalDescriptorSets(previous.descriptorSets, current.descriptorSets))
+        {
+            changes |= ReflectionChangeFlags::eDescriptorLayout;
+        }
+        if (previous.pushConstants != current.pushConstants)
+        {
+            changes |= ReflectionChangeFlags::ePushConstants;
+        }
+        return changes;
+    }
+
+    auto ShaderReflectionDatabase::getKey(const std::string& filePath) -> std::string
+    {
+        return std::filesystem::absolute(filePath).lexically_normal().string();
+    }
+
+    auto ShaderReflectionDatabase::findEntryPoint(const ShaderEntry& shader, const std::string& entryPoint) -> const ShaderReflectionData*
+    {
+        // Requested names first, then a named lookup of an entry point requested as the first one
+        for (size_t i = 0; i < shader.entryPoints.size(); ++i)
+        {
+            if (shader.entryPoints[i] == entryPoint)
+            {
+                return &shader.data[i];
+            }
+        }
+        if (entryPoint.empty())
+        {
+            return nullptr;
+        }
+        const auto it = std::ranges::find(shader.data, entryPoint, &ShaderReflectionData::entryPoint);
+        return it != std::end(shader.data) ? &*it : nullptr;
+    }
+
+    auto ShaderReflectionDatabase::loadShader(const std::string& filePath, const std::span<const std::string> entryPoints, uint64_t& codeHash) const
+        -> std::vector<ShaderReflectionData>
+    {
+        // Read rather than mapped, watched files are typically rewritten in place by the shader compiler
+        const auto shaderCode = ShaderCode::readFile(filePath);
+        codeHash = ShaderReflectionCache::hashCode(shaderCode);
+        if (m_cache)
+        {
+            return m_cache->reflectEntryPoints(shaderCode, codeHash, filePath, entryPoints, m_backend);
+        }
+
+        // Only the first entry point is used, the others are never reflected
+        if (std::ranges::all_of(entryPoints, [](const std::string& name) { return name.empty(); }))
+        {
+            return std::vector<ShaderReflectionData>(entryPoints.size(), ShaderReflection::reflectShader(shaderCode, filePath, m_backend));
+        }
+        return ShaderReflection::selectEntryPoints(ShaderReflection::reflectModule(shaderCode, filePath, m_backend), entryPoints, filePath);
+    }
+
+    auto ShaderReflectionDatabase::mergePipeline(const PipelineEntry& pipeline) const -> PipelineReflectionData
+    {
+        std::vector<ShaderReflectionData> shaderData;
+        shaderData.reserve(pipeline.stages.size());
+        for (const auto& stage : pipeline.stages)
+        {
+            shaderData.push_back(*findEntryPoint(m_shaders.at(stage.filePath), stage.entryPoint));
+        }
+        return ShaderReflection::mergePipelineShaders(std::move(shaderData));
+    }
+
+    void ShaderReflectionDatabase::watch(const std::string& key)
+    {
+#if defined(NBL_REFLECT_INOTIFY)
+        if (m_inotify < 0)
+        {
+            return;
+        }
+
+        // Directories are watched instead of files, compilers often replace the file rather than writing to it
+        const std::string directory = std::filesystem::path(key).parent_path().string();
+        const bool watched = std::ranges::any_of(m_watchedDirectories, [&](const auto& entry) { return entry.second == directory; });
+        if (watched)
+        {
+            return;
+        }
+
+        const int wd = inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0)
+        {
+            // Out of watches, fall back to polling modification times for every file
+            close(m_inotify);
+            m_inotify = -1;
+            m_watchedDirectories.clear();
+            return;
+        }
+        m_watchedDirectories.emplace(wd, directory);
+#else
+        (void) key;
+#endif
+    }
+
+    auto ShaderReflectionDatabase::collectChanges() -> std::vector<std::string>
+    {
+        std::unordered_set<std::string> changed = std::move(m_retry);
+        m_retry.clear();
+
+#if defined(NBL_REFLECT_INOTIFY)
+        if (m_inotify >= 0)
+        {
+            bool overflow = false;
+            alignas(inotify_event) char buffer[4096];
+            for (ssize_t length = 0; (length = read(m_inotify, buffer, sizeof(buffer))) > 0;)
+            {
+                for (const char* ptr = buffer; ptr < buffer + length;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                    ptr += sizeof(inotify_event) + event->len;
+
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        overflow = true;
+                        continue;
+                    }
+
+                    const auto directory = m_watchedDirectories.find(event->wd);
+                    if (event->len == 0 || directory == std::end(m_watchedDirectories))
+                    {
+                        continue;
+                    }
+
+                    std::string key = (std::filesystem::path(directory->second) / event->name).lexically_normal().string();
+                    if (m_shaders.contains(key))
+                    {
+                        changed.insert(std::move(key));
+                    }
+                }
+            }
+
+            // Events were lost, every file is checked, unchanged contents are skipped by their hash
+            if (overflow)
+            {
+                for (const auto& [key, shader] : m_shaders)
+                {
+                    changed.insert(key);
+                }
+            }
+
+            std::vector<std::string> result(std::begin(changed), std::end(changed));
+            std::ranges::sort(result);
+            return result;
+        }
+#endif
+
+        for (const auto& [key, shader] : m_shaders)
+        {
+            std::error_code timeError, sizeError;
+            const auto writeTime = std::filesystem::last_write_time(key, timeError);
+            const auto fileSize  = std::filesystem::file_size(key, sizeError);
+            if (!timeError && !sizeError && (writeTime != shader.writeTime || fileSize != shader.fileSize))
+            {
+                changed.insert(key);
+            }
+        }
+
+        std::vector<std::string> result(std::begin(changed), std::end(changed));
+        std::ranges::sort(result);
+        return result;
+    }
+
+    auto ShaderReflectionDatabase::reloadKeys(const std::vector<std::string>& keys) -> ReflectionDatabaseUpdate
+    {
+        ReflectionDatabaseUpdate update;
+
+        std::vector<PipelineId> affected;
+        for (const auto& key : keys)
+        {
+            ShaderEntry& shader = m_shaders.at(key);
+
+            try
+            {
+                std::error_code ec;
+                const auto writeTime = std::filesystem::last_write_time(key, ec);
+                const auto fileSize  = std::filesystem::file_size(key, ec);
+
+                uint64_t codeHash = 0;
+                auto data = loadShader(shader.filePath, shader.entryPoints, codeHash);
+                shader.writeTime = writeTime;
+                shader.fileSize  = fileSize;
+
+                // Touched or rewritten with identical contents
+                if (codeHash == shader.codeHash && data.front().shaderCode.sizeInBytes() == shader.data.front().shaderCode.sizeInBytes())
+                {
+                    continue;
+                }
+
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    update.shaders.push_back({ shader.filePath, shader.entryPoints[i], diffShader(shader.data[i], data[i]) });
+                }
+                shader.data     = std::move(data);
+                shader.codeHash = codeHash;
+                affected.insert(std::end(affected), std::begin(shader.pipelines), std::end(shader.pipelines));
+            }
+            catch (const std::exception& err)
+            {
+                update.errors.push_back({ shader.filePath, err.what() });
+                m_retry.insert(key);
+            }
+        }
+
+        std::ranges::sort(affected);
+        const auto [first, last] = std::ranges::unique(affected);
+        affected.erase(first, last);
+
+        for (const PipelineId pipelineId : affected)
+        {
+            auto& pipeline = m_pipelines[pipelineId];
+            auto data = mergePipeline(pipeline);
+            update.pipelines.push_back({ pipelineId, diffPipeline(pipeline.data, data) });
+            pipeline.data = std::move(data);
+        }
+
+        return update;
+    }
+}
@@ -0,0 +1,432 @@
+#include "reflect/ShaderReflectionSerializer.hpp"
+
+#include <cstring>
+#include <type_traits>
+#include "reflect/ReflectionHash.hpp"
+
+namespace nbl
+{
+    namespace
+    {
+        struct RecordHeader
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t payloadSize;
+            uint64_t payloadHash;
+        };
+
+        class RecordWriter
+        {
+        public:
+            template <typename T>
+            void write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                const auto* bytes = reinterpret_cast<const char*>(&value);
+                m_bytes.insert(std::end(m_bytes), bytes, bytes + sizeof(T));
+            }
+
+            void write(const std::string& value)
+            {
+                write(static_cast<uint32_t>(value.size()));
+                m_bytes.insert(std::end(m_bytes), std::begin(value), std::end(value));
+            }
+
+            std::vector<char> m_bytes;
+        };
+
+        class RecordReader
+        {
+        public:
+            explicit RecordReader(const std::span<const char> bytes) : m_bytes(bytes) {}
+
+            template <typename T>
+            auto read(T& value) -> bool
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                if (m_bytes.size() - m_offset < sizeof(T))
+                {
+                    return false;
+                }
+                std::memcpy(&value, m_bytes.data() + m_offset, sizeof(T));
+                m_offset += sizeof(T);
+                return true;
+            }
+
+            auto read(std::string& value) -> bool
+            {
+                uint32_t size = 0;
+                if (!read(size) || m_bytes.size() - m_offset < size)
+                {
+                    return false;
+                }
+                value.assign(m_bytes.data() + m_offset, size);
+                m_offset += size;
+                return true;
+            }
+
+            /**
+             * @note Guards vector sizes against corrupt counts before anything is allocated.
+             */
+            auto readCount(uint32_t& count, const size_t elementSize) -> bool
+            {
+                return read(count) && static_cast<size_t>(count) * elementSize <= m_bytes.size() - m_offset;
+            }
+
+            auto finished() const -> bool { return m_offset == m_bytes.size(); }
+
+        private:
+            std::span<const char> m_bytes;
+            size_t                m_offset = 0;
+        };
+
+        // Bounds the recursion on corrupt records, far deeper than any real struct nesting
+        constexpr uint32_t kMaxMemberDepth = 64;
+
+        void writeMembers(RecordWriter& payload, const std::vector<ShaderReflectionBlockMember>& members)
+        {
+            payload.write(static_cast<uint32_t>(members.size()));
+            for (const auto& member : members)
+            {
+                payload.write(member.name);
+                payload.write(member.offset);
+                payload.write(member.size);
+                payload.write(member.arrayStride);
+                payload.write(member.matrixStride);
+                payload.write(static_cast<uint8_t>(member.rowMajor));
+                payload.write(static_cast<uint32_t>(member.arrayDims.size()));
+                for (const uint32_t dim : member.arrayDims)
+                {
+                    payload.write(dim);
+                }
+                writeMembers(payload, member.members);
+            }
+        }
+
+        auto readMembers(RecordReader& payload, std::vector<ShaderReflectionBlockMember>& members, const uint32_t depth) -> bool
+        {
+            uint32_t nMembers = 0;
+            if (depth > kMaxMemberDepth || !payload.readCount(nMembers, 7 * sizeof(uint32_t)))
+            {
+                return false;
+            }
+            members.resize(nMembers);
+            for (auto& member : members)
+            {
+                uint8_t rowMajor = 0;
+                uint32_t nDims = 0;
+                if (!payload.read(member.name) || !payload.read(member.offset) || !payload.read(member.size)
+                    || !payload.read(member.arrayStride) || !payload.read(member.matrixStride) || !payload.read(rowMajor)
+                    || !payload.readCount(nDims, sizeof(uint32_t)))
+                {
+                    return false;
+                }
+                member.rowMajor = rowMajor != 0;
+                member.arrayDims.resize(nDims);
+                for (auto& dim : member.arrayDims)
+                {
+                    payload.read(dim);
+                }
+                if (!readMembers(payload, member.members, depth + 1))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    auto ShaderReflectionSerializer::serialize(const ShaderReflectionData& shaderData) -> std::vector<char>
+    {
+        RecordWriter payload;
+        payload.write(shaderData.entryPoint);
+        payload.write(static_cast<uint32_t>(shaderData.shaderStage));
+
+        payload.write(static_cast<uint32_t>(shaderData.descriptorSets.size()));
+        for (const auto& descriptorSet : shaderData.descriptorSets)
+        {
+            payload.write(descriptorSet.set);
+            payload.write(static_cast<uint32_t>(descriptorSet.bindings.size()));
+            for (const auto& binding : descriptorSet.bindings)
+            {
+                payload.write(binding.binding);
+                payload.write(static_cast<uint32_t>(binding.descriptorType));
+                payload.write(binding.descriptorCount);
+                payload.write(static_cast<uint32_t>(binding.stageFlags));
+            }
+        }
+
+        payload.write(static_cast<uint32_t>(shaderData.pushConstants.size()));
+        for (const auto& pushConstant : shaderData.pushConstants)
+        {
+            payload.write(static_cast<uint32_t>(pushConstant.stageFlags));
+            payload.write(pushConstant.offset);
+            payload.write(pushConstant.size);
+        }
+
+        payload.write(static_cast<uint8_t>(shaderData.vertexInput.has_value()));
+        if (shaderData.vertexInput.has_value())
+        {
+            const auto& attributes = shaderData.vertexInput->attributeDescriptions;
+            payload.write(static_cast<uint32_t>(attributes.size()));
+            for (const auto& attribute : attributes)
+            {
+                payload.write(attribute.location);
+                payload.write(attribute.binding);
+                payload.write(static_cast<uint32_t>(attribute.format));
+                payload.write(attribute.offset);
+            }
+
+            const auto& bindings = shaderData.vertexInput->bindingDescriptions;
+            payload.write(static_cast<uint32_t>(bindings.size()));
+            for (const auto& binding : bindings)
+            {
+                payload.write(binding.binding);
+                payload.write(binding.stride);
+                payload.write(static_cast<uint32_t>(binding.inputRate));
+            }
+
+            const auto& names = shaderData.vertexInput->attributeNames;
+            payload.write(static_cast<uint32_t>(names.size()));
+            for (const auto& name : names)
+            {
+                payload.write(name);
+            }
+        }
+
+        payload.write(static_cast<uint32_t>(shaderData.blocks.size()));
+        for (const auto& block : shaderData.blocks)
+        {
+            payload.write(static_cast<uint32_t>(block.type));
+            payload.write(block.name);
+            payload.write(block.typeName);
+            payload.write(block.set);
+            payload.write(block.binding);
+            payload.write(block.size);
+            writeMembers(payload, block.members);
+        }
+
+        payload.write(static_cast<uint32_t>(shaderData.specConstants.size()));
+        for (const auto& constant : shaderData.specConstants)
+        {
+            payload.write(constant.constantId);
+            payload.write(constant.name);
+            payload.write(static_cast<uint32_t>(constant.type));
+            payload.write(constant.width);
+            payload.write(constant.defaultValue);
+        }
+
+        payload.write(static_cast<uint8_t>(shaderData.workgroup.has_value()));
+        if (shaderData.workgroup.has_value())
+        {
+            const auto& workgroup = *shaderData.workgroup;
+            payload.write(workgroup.localSize);
+            payload.write(workgroup.localSizeConstantIds);
+            payload.write(workgroup.sharedMemorySize);
+            payload.write(static_cast<uint32_t>(workgroup.sharedVariables.size()));
+            for (const auto& variable : workgroup.sharedVariables)
+            {
+                payload.write(variable.name);
+                payload.write(variable.size);
+                payload.write(variable.lengthConstantId);
+                payload.write(variable.elementSize);
+            }
+        }
+
+        RecordWriter record;
+        record.write(RecordHeader {
+            .magic       = kMagic,
+            .version     = kFormatVersion,
+            .payloadSize = payload.m_bytes.size(),
+            .payloadHash = ReflectionHash::hashBytes(payload.m_bytes.data(), payload.m_bytes.size()),
+        });
+        record.m_bytes.insert(std::end(record.m_bytes), std::begin(payload.m_bytes), std::end(payload.m_bytes));
+
+        return record.m_bytes;
+    }
+
+    auto ShaderReflectionSerializer::deserialize(const std::span<const char> record, ShaderReflectionData& shaderData) -> bool
+    {
+        RecordHeader header {};
+        if (record.size() < sizeof(RecordHeader))
+        {
+            return false;
+        }
+        std::memcpy(&header, record.data(), sizeof(RecordHeader));
+
+        const auto payloadBytes = record.subspan(sizeof(RecordHeader));
+        if (header.magic != kMagic || header.version != kFormatVersion || header.payloadSize != payloadBytes.size()
+            || header.payloadHash != ReflectionHash::hashBytes(payloadBytes.data(), payloadBytes.size()))
+        {
+            return false;
+        }
+
+        RecordReader payload(payloadBytes);
+        uint32_t value = 0;
+
+        if (!payload.read(shaderData.entryPoint) || !payload.read(value))
+        {
+            return false;
+        }
+        shaderData.shaderStage = static_cast<vk::ShaderStageFlagBits>(value);
+
+        uint32_t nDescriptorSets = 0;
+        if (!payload.readCount(nDescriptorSets, 2 * sizeof(uint32_t)))
+        {
+            return false;
+        }
+        shaderData.descriptorSets.resize(nDescriptorSets);
+        for (auto& descriptorSet : shaderData.descriptorSets)
+        {
+            uint32_t nBindings = 0;
+            if (!payload.read(descriptorSet.set) || !payload.readCount(nBindings, 4 * sizeof(uint32_t)))
+            {
+                return false;
+            }
+            descriptorSet.bindings.resize(nBindings);
+            for (auto& binding : descriptorSet.bindings)
+            {
+                uint32_t type = 0, stages = 0;
+                payload.read(binding.binding);
+                payload.read(type);
+                payload.read(binding.descriptorCount);
+                payload.read(stages);
+                binding.descriptorType = static_cast<vk::DescriptorType>(type);
+                binding.stageFlags     = vk::ShaderStageFlags(stages);
+            }
+        }
+
+        uint32_t nPushConstants = 0;
+        if (!payload.readCount(nPushConstants, 3 * sizeof(uint32_t)))
+        {
+            return false;
+        }
+        shaderData.pushConstants.resize(nPushConstants);
+        for (auto& pushConstant : shaderData.pushConstants)
+        {
+            uint32_t stages = 0;
+            payload.read(stages);
+            payload.read(pushConstant.offset);
+            payload.read(pushConstant.size);
+            pushConstant.stageFlags = vk::ShaderStageFlags(stages);
+        }
+
+        uint8_t hasVertexInput = 0;
+        if (!payload.read(hasVertexInput))
+        {
+            return false;
+        }
+        shaderData.vertexInput.reset();
+        if (hasVertexInput)
+        {
+            uint32_t nAttributes = 0;
+            if (!payload.readCount(nAttributes, 4 * sizeof(uint32_t)))
+            {
+                return false;
+            }
+            auto& vertexInput = shaderData.vertexInput.emplace();
+            vertexInput.attributeDescriptions.resize(nAttributes);
+            for (auto& attribute : vertexInput.attributeDescriptions)
+            {
+                uint32_t format = 0;
+                payload.read(attribute.location);
+                payload.read(attribute.binding);
+                payload.read(format);
+                payload.read(attribute.offset);
+                attribute.format = static_cast<vk::Format>(format);
+            }
+
+            uint32_t nBindings = 0;
+            if (!payload.readCount(nBindings, 3 * sizeof(uint32_t)))
+            {
+                return false;
+            }
+            vertexInput.bindingDescriptions.resize(nBindings);
+            for (auto& binding : vertexInput.bindingDescriptions)
+            {
+                uint32_t inputRate = 0;
+                payload.read(binding.binding);
+                payload.read(binding.stride);
+                payload.read(inputRate);
+                binding.inputRate = static_cast<vk::VertexInputRate>(inputRate);
+            }
+
+            uint32_t nNames = 0;
+            if (!payload.readCount(nNames, sizeof(uint32_t)))
+            {
+                return false;
+            }
+            vertexInput.attributeNames.resize(nNames);
+            for (auto& name : vertexInput.attributeNames)
+            {
+                if (!payload.read(name))
+                {
+                    return false;
+                }
+            }
+        }
+
+        uint32_t nBlocks = 0;
+        if (!payload.readCount(nBlocks, 7 * sizeof(uint32_t)))
+        {
+            return false;
+        }
+        shaderData.blocks.resize(nBlocks);
+        for (auto& block : shaderData.blocks)
+        {
+            uint32_t type = 0;
+            if (!payload.read(type) || !payload.read(block.name) || !payload.read(block.typeName) || !payload.read(block.set)
+                || !payload.read(block.binding) || !payload.read(block.size) || !readMembers(payload, block.members, 0))
+            {
+                return false;
+            }
+            block.type = static_cast<ShaderBlockType>(type);
+        }
+
+        uint32_t nSpecConstants = 0;
+        if (!payload.readCount(nSpecConstants, 4 * sizeof(uint32_t) + sizeof(uint64_t)))
+        {
+            return false;
+        }
+        shaderData.specConstants.resize(nSpecConstants);
+        for (auto& constant : shaderData.specConstants)
+        {
+            uint32_t type = 0;
+            if (!payload.read(constant.constantId) || !payload.read(constant.name) || !payload.read(type)
+                || !payload.read(constant.width) || !payload.read(constant.defaultValue))
+            {
+                return false;
+            }
+            constant.type = static_cast<SpecializationConstantType>(type);
+        }
+
+        uint8_t hasWorkgroup = 0;
+        if (!payload.read(hasWorkgroup))
+        {
+            return false;
+        }
+        shaderData.workgroup.reset();
+        if (hasWorkgroup)
+        {
+            auto& workgroup = shaderData.workgroup.emplace();
+            uint32_t nVariables = 0;
+            if (!payload.read(workgroup.localSize) || !payload.read(workgroup.localSizeConstantIds) || !payload.read(workgroup.sharedMemorySize)
+                || !payload.readCount(nVariables, 4 * sizeof(uint32_t)))
+            {
+                return false;
+            }
+            workgroup.sharedVariables.resize(nVariables);
+            for (auto& variable : workgroup.sharedVariables)
+            {
+                if (!payload.read(variable.name) || !payload.read(variable.size) || !payload.read(variable.lengthConstantId)
+                    || !payload.read(variable.elementSize))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return payload.finished();
+    }
+}
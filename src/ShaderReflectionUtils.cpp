@@ -1,6 +1,12 @@
 #include "reflect/ShaderReflection.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <numeric>
+#include <thread>
 
 namespace nbl
 {
@@ -104,22 +110,72 @@ namespace nbl
         };
     }
 
-    auto ShaderReflection::loadShaderBytes(const std::string& filePath) -> std::vector<char>
+    void ShaderReflection::forEachShaderFile(const std::vector<const std::string*>& filePaths, const ReflectionExecutionMode mode,
+                                             const std::function<void(size_t)>& task)
     {
-        std::ifstream file(filePath.c_str(), std::ios::ate | std::ios::binary);
+        const size_t nTasks = filePaths.size();
+        const size_t nWorkers = std::min<size_t>(nTasks, std::max(1u, std::thread::hardware_concurrency()));
 
-        if (!file.is_open())
+        if (mode == ReflectionExecutionMode::eSerial || nWorkers <= 1)
         {
-            throw std::runtime_error("Failed to open file: " + filePath);
+            for (size_t i = 0; i < nTasks; ++i)
+            {
+                task(i);
+            }
+            return;
         }
 
-        const std::streamsize fileSize = file.tellg();
-        std::vector<char> buffer(fileSize);
+        // Largest modules first, so a single slow module does not end up as the tail of the schedule
+        std::vector<uintmax_t> fileSizes(nTasks);
+        for (size_t i = 0; i < nTasks; ++i)
+        {
+            std::error_code ec;
+            const uintmax_t size = std::filesystem::file_size(*filePaths[i], ec);
+            fileSizes[i] = ec ? 0 : size;
+        }
+
+        std::vector<size_t> order(nTasks);
+        std::iota(std::begin(order), std::end(order), 0);
+        std::ranges::stable_sort(order, std::greater{}, [&](const size_t i) { return fileSizes[i]; });
+
+        std::atomic<size_t> next     = 0;
+        std::atomic<bool>   failed   = false;
+        std::exception_ptr  error    = nullptr;
+        std::mutex          errorMutex;
+
+        const auto worker = [&] {
+            for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < nTasks && !failed.load(std::memory_order_relaxed);
+                 i = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                try
+                {
+                    task(order[i]);
+                }
+                catch (...)
+                {
+                    std::scoped_lock lock(errorMutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
 
-        file.seekg(0);
-        file.read(buffer.data(), fileSize);
-        file.close();
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(nWorkers - 1);
+            for (size_t w = 1; w < nWorkers; ++w)
+            {
+                workers.emplace_back(worker);
+            }
+            worker();
+        }
 
-        return buffer;
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,320 @@
+#include "reflect/ShaderReflection.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <stdexcept>
+
+namespace nbl
+{
+    namespace
+    {
+        /**
+         * @return Size of a single component, used as the alignment of an attribute within a vertex.
+         */
+        auto getComponentSize(const vk::Format format) -> uint32_t
+        {
+            switch (format)
+            {
+                case vk::Format::eR8G8Unorm:
+                case vk::Format::eR8G8B8A8Unorm:
+                case vk::Format::eR8G8B8A8Snorm:
+                case vk::Format::eR8G8B8A8Uint:
+                case vk::Format::eR8G8B8A8Sint:
+                    return 1;
+                case vk::Format::eA2B10G10R10SnormPack32:
+                    return 4;
+                default:
+                    break;
+            }
+
+            // 16, 32 and 64-bit per component formats produced by reflection
+            const uint32_t size = ShaderReflectionVertexInput::getFormatSize(format);
+            switch (format)
+            {
+                case vk::Format::eR16Uint:          case vk::Format::eR16Sint:          case vk::Format::eR16Sfloat:
+                case vk::Format::eR16G16Unorm:      case vk::Format::eR16G16Snorm:
+                case vk::Format::eR16G16Uint:       case vk::Format::eR16G16Sint:       case vk::Format::eR16G16Sfloat:
+                case vk::Format::eR16G16B16Uint:    case vk::Format::eR16G16B16Sint:    case vk::Format::eR16G16B16Sfloat:
+                case vk::Format::eR16G16B16A16Unorm:case vk::Format::eR16G16B16A16Snorm:
+                case vk::Format::eR16G16B16A16Uint: case vk::Format::eR16G16B16A16Sint: case vk::Format::eR16G16B16A16Sfloat:
+                    return 2;
+                case vk::Format::eR64Uint:          case vk::Format::eR64Sint:          case vk::Format::eR64Sfloat:
+                case vk::Format::eR64G64Uint:       case vk::Format::eR64G64Sint:       case vk::Format::eR64G64Sfloat:
+                case vk::Format::eR64G64B64Uint:    case vk::Format::eR64G64B64Sint:    case vk::Format::eR64G64B64Sfloat:
+                case vk::Format::eR64G64B64A64Uint: case vk::Format::eR64G64B64A64Sint: case vk::Format::eR64G64B64A64Sfloat:
+                    return 8;
+                default:
+                    return size == 0 ? 1 : 4;
+            }
+        }
+
+        auto alignUp(const uint32_t value, const uint32_t alignment) -> uint32_t
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        auto interleavedStride(const std::vector<vk::Format>& formats) -> uint32_t
+        {
+            uint32_t offset = 0, alignment = 1;
+            for (const vk::Format format : formats)
+            {
+                const uint32_t componentSize = getComponentSize(format);
+                offset    = alignUp(offset, componentSize) + ShaderReflectionVertexInput::getFormatSize(format);
+                alignment = std::max(alignment, componentSize);
+            }
+            return alignUp(offset, alignment);
+        }
+
+        auto contains(const std::string& name, const std::initializer_list<std::string_view> keys) -> bool
+        {
+            return std::ranges::any_of(keys, [&](const std::string_view key) { return name.find(key) != std::string::npos; });
+        }
+
+        auto suggestFormat(const vk::Format format, const std::string& name, std::string& reason) -> vk::Format
+        {
+            const bool isPosition = contains(name, { "pos" });
+            const bool isColor    = contains(name, { "color", "colour" }) && !isPosition;
+            const bool isNormal   = contains(name, { "normal", "tangent" });
+            const bool isTexCoord = contains(name, { "uv", "texcoord", "tex" });
+            const bool isWeight   = contains(name, { "weight" });
+            const bool isIndex    = contains(name, { "joint", "bone", "index", "indices" });
+
+            switch (format)
+            {
+                case vk::Format::eR32G32B32Sfloat:
+                case vk::Format::eR32G32B32A32Sfloat:
+                {
+                    if (isPosition)
+                    {
+                        return format;
+                    }
+                    if (isColor)
+                    {
+                        reason = "Colors in [0, 1] fit 8-bit UNORM.";
+                        return vk::Format::eR8G8B8A8Unorm;
+                    }
+                    if (isNormal)
+                    {
+                        reason = "Unit vectors in [-1, 1] fit 16-bit SNORM.";
+                        return vk::Format::eR16G16B16A16Snorm;
+                    }
+                    if (isWeight)
+                    {
+                        reason = "Blend weights in [0, 1] fit 8-bit UNORM.";
+                        return vk::Format::eR8G8B8A8Unorm;
+                    }
+                    reason = "Half precision, verify the value range.";
+                    return vk::Format::eR16G16B16A16Sfloat;
+                }
+                case vk::Format::eR32G32Sfloat:
+                {
+                    if (isPosition)
+                    {
+                        return format;
+                    }
+                    reason = isTexCoord ? "Texture coordinates rarely need more than half precision." : "Half precision, verify the value range.";
+                    return vk::Format::eR16G16Sfloat;
+                }
+                case vk::Format::eR32G32B32A32Uint:
+                case vk::Format::eR32G32B32A32Sint:
+                {
+                    if (!isIndex)
+                    {
+                        return format;
+                    }
+                    reason = "Indices below 65536 fit 16-bit integers.";
+                    return format == vk::Format::eR32G32B32A32Uint ? vk::Format::eR16G16B16A16Uint : vk::Format::eR16G16B16A16Sint;
+                }
+                default:
+                    return format;
+            }
+        }
+    }
+
+    void ShaderReflectionVertexInput::applyLayout(const VertexInputLayout layout, const std::span<const VertexInputStream> streams)
+    {
+        // Validated up front, a rejected layout leaves the current one untouched
+        if (layout == VertexInputLayout::eCustom)
+        {
+            for (auto it = std::begin(streams); it != std::end(streams); ++it)
+            {
+                for (auto other = std::begin(streams); other != it; ++other)
+                {
+                    if (other->location == it->location)
+                    {
+                        throw std::runtime_error("Vertex stream location #" + std::to_string(it->location) + " is mapped more than once");
+                    }
+                    if (other->binding == it->binding && other->inputRate != it->inputRate)
+                    {
+                        throw std::runtime_error("Vertex streams of binding #" + std::to_string(it->binding) + " use different input rates");
+                    }
+                }
+            }
+            for (const auto& attribute : attributeDescriptions)
+            {
+                if (std::ranges::find(streams, attribute.location, &VertexInputStream::location) == std::end(streams))
+                {
+                    throw std::runtime_error("No vertex stream mapped for location #" + std::to_string(attribute.location));
+                }
+            }
+        }
+
+        std::map<uint32_t, vk::VertexInputRate> inputRates;
+        for (uint32_t i = 0; i < attributeDescriptions.size(); ++i)
+        {
+            auto& attribute = attributeDescriptions[i];
+            switch (layout)
+            {
+                case VertexInputLayout::eInterleaved:
+                    attribute.binding = 0;
+                    break;
+                case VertexInputLayout::eBindingPerAttribute:
+                    attribute.binding = i;
+                    break;
+                case VertexInputLayout::eCustom:
+                {
+                    const auto stream = std::ranges::find(streams, attribute.location, &VertexInputStream::location);
+                    attribute.binding = stream->binding;
+                    inputRates[stream->binding] = stream->inputRate;
+                    break;
+                }
+            }
+            inputRates.try_emplace(attribute.binding, vk::VertexInputRate::eVertex);
+        }
+
+        // Attributes are in location order, so offsets within each binding follow location order as well
+        bindingDescriptions.clear();
+        for (const auto& [binding, inputRate] : inputRates)
+        {
+            uint32_t offset = 0, alignment = 1;
+            for (auto& attribute : attributeDescriptions)
+            {
+                if (attribute.binding != binding)
+                {
+                    continue;
+                }
+                const uint32_t componentSize = getComponentSize(attribute.format);
+                attribute.offset = alignUp(offset, componentSize);
+                offset           = attribute.offset + getFormatSize(attribute.format);
+                alignment        = std::max(alignment, componentSize);
+            }
+
+            bindingDescriptions.push_back(vk::VertexInputBindingDescription()
+                .setBinding(binding)
+                .setStride(alignUp(offset, alignment))
+                .setInputRate(inputRate));
+        }
+    }
+
+    auto ShaderReflectionVertexInput::suggestPacking() const -> VertexInputPackingReport
+    {
+        VertexInputPackingReport result;
+
+        struct Candidate
+        {
+            uint32_t    location;
+            vk::Format  format;
+            bool        isPosition;
+        };
+        std::vector<Candidate> candidates;
+        std::vector<vk::Format> currentFormats;
+
+        for (size_t i = 0; i < attributeDescriptions.size(); ++i)
+        {
+            const auto& attribute = attributeDescriptions[i];
+            std::string name = i < attributeNames.size() ? attributeNames[i] : std::string();
+            std::ranges::transform(name, std::begin(name), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            std::string reason;
+            const vk::Format suggested = suggestFormat(attribute.format, name, reason);
+            if (suggested != attribute.format)
+            {
+                result.suggestions.push_back({
+                    .location        = attribute.location,
+                    .name            = i < attributeNames.size() ? attributeNames[i] : std::string(),
+                    .currentFormat   = attribute.format,
+                    .suggestedFormat = suggested,
+                    .reason          = std::move(reason),
+                });
+            }
+
+            currentFormats.push_back(attribute.format);
+            candidates.push_back({ attribute.location, suggested, name.find("pos") != std::string::npos });
+        }
+
+        // Position first (it is the only attribute fetched by depth-only passes), then by decreasing alignment so no padding is needed
+        std::ranges::stable_sort(candidates, [](const Candidate& a, const Candidate& b) {
+            if (a.isPosition != b.isPosition)
+            {
+                return a.isPosition;
+            }
+            return getComponentSize(a.format) > getComponentSize(b.format);
+        });
+
+        std::vector<vk::Format> suggestedFormats;
+        for (const auto& candidate : candidates)
+        {
+            result.suggestedOrder.push_back(candidate.location);
+            suggestedFormats.push_back(candidate.format);
+        }
+
+        result.currentStride   = interleavedStride(currentFormats);
+        result.suggestedStride = interleavedStride(suggestedFormats);
+        return result;
+    }
+
+    auto ShaderReflectionVertexInput::getFormatSize(const vk::Format format) -> uint32_t
+    {
+        switch (format)
+        {
+            case vk::Format::eR8G8Unorm:                return 2;
+            case vk::Format::eR8G8B8A8Unorm:
+            case vk::Format::eR8G8B8A8Snorm:
+            case vk::Format::eR8G8B8A8Uint:
+            case vk::Format::eR8G8B8A8Sint:
+            case vk::Format::eA2B10G10R10SnormPack32:   return 4;
+            case vk::Format::eR16Uint:
+            case vk::Format::eR16Sint:
+            case vk::Format::eR16Sfloat:                return 2;
+            case vk::Format::eR16G16Unorm:
+            case vk::Format::eR16G16Snorm:
+            case vk::Format::eR16G16Uint:
+            case vk::Format::eR16G16Sint:
+            case vk::Format::eR16G16Sfloat:             return 4;
+            case vk::Format::eR16G16B16Uint:
+            case vk::Format::eR16G16B16Sint:
+            case vk::Format::eR16G16B16Sfloat:          return 6;
+            case vk::Format::eR16G16B16A16Unorm:
+            case vk::Format::eR16G16B16A16Snorm:
+            case vk::Format::eR16G16B16A16Uint:
+            case vk::Format::eR16G16B16A16Sint:
+            case vk::Format::eR16G16B16A16Sfloat:       return 8;
+            case vk::Format::eR32Uint:
+            case vk::Format::eR32Sint:
+            case vk::Format::eR32Sfloat:                return 4;
+            case vk::Format::eR32G32Uint:
+            case vk::Format::eR32G32Sint:
+            case vk::Format::eR32G32Sfloat:             return 8;
+            case vk::Format::eR32G32B32Uint:
+            case vk::Format::eR32G32B32Sint:
+            case vk::Format::eR32G32B32Sfloat:          return 12;
+            case vk::Format::eR32G32B32A32Uint:
+            case vk::Format::eR32G32B32A32Sint:
+            case vk::Format::eR32G32B32A32Sfloat:       return 16;
+            case vk::Format::eR64Uint:
+            case vk::Format::eR64Sint:
+            case vk::Format::eR64Sfloat:                return 8;
+            case vk::Format::eR64G64Uint:
+            case vk::Format::eR64G64Sint:
+            case vk::Format::eR64G64Sfloat:             return 16;
+            case vk::Format::eR64G64B64Uint:
+            case vk::Format::eR64G64B64Sint:
+            case vk::Format::eR64G64B64Sfloat:          return 24;
+            case vk::Format::eR64G64B64A64Uint:
+            case vk::Format::eR64G64B64A64Sint:
+            case vk::Format::eR64G64B64A64Sfloat:       return 32;
+            default:                                    return 0;
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#include "reflect/ShaderReflection.hpp"
+#include "reflect/ShaderSpecialization.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace nbl
+{
+    namespace
+    {
+        auto formatSize(const std::array<uint32_t, 3>& size) -> std::string
+        {
+            return std::to_string(size[0]) + "x" + std::to_string(size[1]) + "x" + std::to_string(size[2]);
+        }
+    }
+
+    auto WorkgroupLimits::fromDeviceLimits(const vk::PhysicalDeviceLimits& limits) -> WorkgroupLimits
+    {
+        return {
+            .maxWorkgroupSize    = { limits.maxComputeWorkGroupSize[0], limits.maxComputeWorkGroupSize[1], limits.maxComputeWorkGroupSize[2] },
+            .maxInvocations      = limits.maxComputeWorkGroupInvocations,
+            .maxWorkgroupCount   = { limits.maxComputeWorkGroupCount[0], limits.maxComputeWorkGroupCount[1], limits.maxComputeWorkGroupCount[2] },
+            .maxSharedMemorySize = limits.maxComputeSharedMemorySize,
+        };
+    }
+
+    auto WorkgroupLimits::fromMeshShaderProperties(const vk::PhysicalDeviceMeshShaderPropertiesEXT& properties, const vk::ShaderStageFlagBits stage)
+        -> WorkgroupLimits
+    {
+        if (stage == vk::ShaderStageFlagBits::eTaskEXT)
+        {
+            return {
+                .maxWorkgroupSize    = { properties.maxTaskWorkGroupSize[0], properties.maxTaskWorkGroupSize[1], properties.maxTaskWorkGroupSize[2] },
+                .maxInvocations      = properties.maxTaskWorkGroupInvocations,
+                .maxWorkgroupCount   = { properties.maxTaskWorkGroupCount[0], properties.maxTaskWorkGroupCount[1], properties.maxTaskWorkGroupCount[2] },
+                .maxSharedMemorySize = properties.maxTaskSharedMemorySize,
+            };
+        }
+        if (stage == vk::ShaderStageFlagBits::eMeshEXT)
+        {
+            return {
+                .maxWorkgroupSize    = { properties.maxMeshWorkGroupSize[0], properties.maxMeshWorkGroupSize[1], properties.maxMeshWorkGroupSize[2] },
+                .maxInvocations      = properties.maxMeshWorkGroupInvocations,
+                .maxWorkgroupCount   = { properties.maxMeshWorkGroupCount[0], properties.maxMeshWorkGroupCount[1], properties.maxMeshWorkGroupCount[2] },
+                .maxSharedMemorySize = properties.maxMeshSharedMemorySize,
+            };
+        }
+        throw std::runtime_error("Mesh shader properties only hold limits of task and mesh stages.");
+    }
+
+    auto ShaderReflectionWorkgroup::specialize(const ShaderSpecialization& specialization) const -> ShaderReflectionWorkgroup
+    {
+        ShaderReflectionWorkgroup result = *this;
+        for (size_t d = 0; d < 3; ++d)
+        {
+            if (specialization.hasConstant(localSizeConstantIds[d]))
+            {
+                result.localSize[d] = static_cast<uint32_t>(specialization.getValue(localSizeConstantIds[d]));
+            }
+        }
+
+        result.sharedMemorySize = 0;
+        for (auto& variable : result.sharedVariables)
+        {
+            if (specialization.hasConstant(variable.lengthConstantId))
+            {
+                variable.size = variable.elementSize * static_cast<uint32_t>(specialization.getValue(variable.lengthConstantId));
+            }
+            result.sharedMemorySize += variable.size;
+        }
+
+        return result;
+    }
+
+    auto ShaderReflectionWorkgroup::getDispatchSize(const std::array<uint32_t, 3>& problemSize) const -> std::array<uint32_t, 3>
+    {
+        std::array<uint32_t, 3> groupCount = {};
+        for (size_t d = 0; d < 3; ++d)
+        {
+            const uint64_t size = std::max(localSize[d], 1u);
+            groupCount[d] = static_cast<uint32_t>((problemSize[d] + size - 1) / size);
+        }
+        return groupCount;
+    }
+
+    auto ShaderReflectionWorkgroup::checkLimits(const WorkgroupLimits& limits, const std::optional<std::array<uint32_t, 3>>& problemSize) const
+        -> std::vector<std::string>
+    {
+        std::vector<std::string> violations;
+        for (size_t d = 0; d < 3; ++d)
+        {
+            if (localSize[d] > limits.maxWorkgroupSize[d])
+            {
+                violations.push_back("Workgroup size " + formatSize(localSize) + " exceeds the maximum size " + formatSize(limits.maxWorkgroupSize) + ".");
+                break;
+            }
+        }
+
+        const uint64_t invocations = static_cast<uint64_t>(localSize[0]) * localSize[1] * localSize[2];
+        if (invocations > limits.maxInvocations)
+        {
+            violations.push_back("Workgroup of " + std::to_string(invocations) + " invocations exceeds the maximum of "
+                                 + std::to_string(limits.maxInvocations) + ".");
+        }
+
+        if (sharedMemorySize > limits.maxSharedMemorySize)
+        {
+            violations.push_back("Shared memory of " + std::to_string(sharedMemorySize) + " bytes exceeds the maximum of "
+                                 + std::to_string(limits.maxSharedMemorySize) + " bytes.");
+        }
+
+        if (problemSize.has_value())
+        {
+            const std::array<uint32_t, 3> groupCount = getDispatchSize(*problemSize);
+            for (size_t d = 0; d < 3; ++d)
+            {
+                if (groupCount[d] > limits.maxWorkgroupCount[d])
+                {
+                    violations.push_back("Dispatch of " + formatSize(groupCount) + " workgroups exceeds the maximum count "
+                                         + formatSize(limits.maxWorkgroupCount) + ".");
+                    break;
+                }
+            }
+        }
+
+        return violations;
+    }
+}
@@ -0,0 +1,270 @@
+#include "reflect/ShaderSpecialization.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "reflect/ReflectionHash.hpp"
+
+namespace nbl
+{
+    namespace
+    {
+        auto getTypeName(const ShaderSpecializationConstant& constant) -> std::string
+        {
+            switch (constant.type)
+            {
+                case SpecializationConstantType::eBool:  return "bool";
+                case SpecializationConstantType::eInt:   return "int" + std::to_string(constant.width);
+                case SpecializationConstantType::eUint:  return "uint" + std::to_string(constant.width);
+                case SpecializationConstantType::eFloat: return "float" + std::to_string(constant.width);
+            }
+            return "unknown";
+        }
+
+        [[noreturn]] void throwConversionError(const ShaderSpecializationConstant& constant, const std::string& what)
+        {
+            throw std::runtime_error("Cannot specialize " + getTypeName(constant) + " constant " + constant.name
+                                     + " (id " + std::to_string(constant.constantId) + ") with " + what);
+        }
+
+        auto getMask(const uint32_t width) -> uint64_t
+        {
+            return width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+        }
+    }
+
+    ShaderSpecialization::ShaderSpecialization(const std::span<const ShaderSpecializationConstant> constants)
+        : m_constants(std::begin(constants), std::end(constants))
+    {
+        std::ranges::stable_sort(m_constants, {}, &ShaderSpecializationConstant::constantId);
+        reset();
+    }
+
+    void ShaderSpecialization::reset()
+    {
+        m_values.clear();
+        for (const auto& constant : m_constants)
+        {
+            m_values.push_back(constant.defaultValue);
+        }
+        update();
+    }
+
+    auto ShaderSpecialization::hasConstant(const std::string_view name) const -> bool
+    {
+        return std::ranges::find(m_constants, name, &ShaderSpecializationConstant::name) != std::end(m_constants);
+    }
+
+    auto ShaderSpecialization::hasConstant(const uint32_t constantId) const -> bool
+    {
+        return std::ranges::find(m_constants, constantId, &ShaderSpecializationConstant::constantId) != std::end(m_constants);
+    }
+
+    auto ShaderSpecialization::getSpecializationInfo() const -> vk::SpecializationInfo
+    {
+        return vk::SpecializationInfo()
+            .setMapEntryCount(static_cast<uint32_t>(m_entries.size()))
+            .setPMapEntries(m_entries.data())
+            .setDataSize(m_data.size())
+            .setPData(m_data.data());
+    }
+
+    auto ShaderSpecialization::getKey(const uint32_t stage) const -> SpecializationKey
+    {
+        SpecializationKey key;
+        key.hash = ReflectionHash::hashCombine(0, stage);
+        for (size_t i = 0; i < m_constants.size(); ++i)
+        {
+            if (m_values[i] != m_constants[i].defaultValue)
+            {
+                const uint64_t id = static_cast<uint64_t>(stage) << 32 | m_constants[i].constantId;
+                key.values.emplace_back(id, m_values[i]);
+                key.hash = ReflectionHash::hashCombine(ReflectionHash::hashCombine(key.hash, id), m_values[i]);
+            }
+        }
+        return key;
+    }
+
+    auto ShaderSpecialization::getIndex(const std::string_view name) const -> size_t
+    {
+        const auto it = std::ranges::find(m_constants, name, &ShaderSpecializationConstant::name);
+        if (name.empty() || it == std::end(m_constants))
+        {
+            throw std::runtime_error("Unknown specialization constant: " + std::string(name));
+        }
+        return static_cast<size_t>(it - std::begin(m_constants));
+    }
+
+    auto ShaderSpecialization::getIndex(const uint32_t constantId) const -> size_t
+    {
+        const auto it = std::ranges::find(m_constants, constantId, &ShaderSpecializationConstant::constantId);
+        if (it == std::end(m_constants))
+        {
+            throw std::runtime_error("Unknown specialization constant id: " + std::to_string(constantId));
+        }
+        return static_cast<size_t>(it - std::begin(m_constants));
+    }
+
+    auto ShaderSpecialization::setBits(const size_t index, const uint64_t bits) -> ShaderSpecialization&
+    {
+        if (m_values[index] != bits)
+        {
+            m_values[index] = bits;
+            update();
+        }
+        return *this;
+    }
+
+    void ShaderSpecialization::update()
+    {
+        m_entries.clear();
+        m_data.clear();
+
+        // Entries are naturally aligned within the data
+        for (size_t i = 0; i < m_constants.size(); ++i)
+        {
+            const ShaderSpecializationConstant& constant = m_constants[i];
+            if (m_values[i] == constant.defaultValue)
+            {
+                continue;
+            }
+
+            const uint32_t size   = constant.getSize();
+            const uint32_t offset = (static_cast<uint32_t>(m_data.size()) + size - 1) / size * size;
+            m_data.resize(offset + size);
+
+            // Values are little-endian bits in the low-order bytes, like the SPIR-V literals they replace
+            uint64_t value = m_values[i];
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                value = std::byteswap(value) >> (64 - 8 * size);
+            }
+            std::memcpy(m_data.data() + offset, &value, size);
+
+            m_entries.push_back(vk::SpecializationMapEntry()
+                .setConstantID(constant.constantId)
+                .setOffset(offset)
+                .setSize(size));
+        }
+    }
+
+    auto ShaderSpecialization::convertBool(const size_t index, const bool value) const -> uint64_t
+    {
+        const ShaderSpecializationConstant& constant = m_constants[index];
+        if (constant.type != SpecializationConstantType::eBool)
+        {
+            throwConversionError(constant, "a bool");
+        }
+        return value ? 1 : 0;
+    }
+
+    auto ShaderSpecialization::convertInt(const size_t index, const int64_t value) const -> uint64_t
+    {
+        const ShaderSpecializationConstant& constant = m_constants[index];
+        switch (constant.type)
+        {
+            case SpecializationConstantType::eInt:
+            {
+                const int64_t max = constant.width >= 64 ? std::numeric_limits<int64_t>::max() : (int64_t(1) << (constant.width - 1)) - 1;
+                if (value > max || value < -max - 1)
+                {
+                    throwConversionError(constant, "out of range value " + std::to_string(value));
+                }
+                return static_cast<uint64_t>(value) & getMask(constant.width);
+            }
+            case SpecializationConstantType::eUint:
+            {
+                if (value < 0)
+                {
+                    throwConversionError(constant, "negative value " + std::to_string(value));
+                }
+                return convertUint(index, static_cast<uint64_t>(value));
+            }
+            case SpecializationConstantType::eFloat:
+                return convertFloat(index, static_cast<double>(value));
+            default:
+                throwConversionError(constant, "an integer");
+        }
+    }
+
+    auto ShaderSpecialization::convertUint(const size_t index, const uint64_t value) const -> uint64_t
+    {
+        const ShaderSpecializationConstant& constant = m_constants[index];
+        switch (constant.type)
+        {
+            case SpecializationConstantType::eUint:
+            {
+                if (value > getMask(constant.width))
+                {
+                    throwConversionError(constant, "out of range value " + std::to_string(value));
+                }
+                return value;
+            }
+            case SpecializationConstantType::eInt:
+            {
+                if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                {
+                    throwConversionError(constant, "out of range value " + std::to_string(value));
+                }
+                return convertInt(index, static_cast<int64_t>(value));
+            }
+            case SpecializationConstantType::eFloat:
+                return convertFloat(index, static_cast<double>(value));
+            default:
+                throwConversionError(constant, "an integer");
+        }
+    }
+
+    auto ShaderSpecialization::convertFloat(const size_t index, const double value) const -> uint64_t
+    {
+        const ShaderSpecializationConstant& constant = m_constants[index];
+        if (constant.type != SpecializationConstantType::eFloat)
+        {
+            throwConversionError(constant, "a floating point value");
+        }
+
+        switch (constant.width)
+        {
+            case 32: return std::bit_cast<uint32_t>(static_cast<float>(value));
+            case 64: return std::bit_cast<uint64_t>(value);
+            default: throwConversionError(constant, "a floating point value, only 32 and 64-bit floats are converted");
+        }
+    }
+
+    PipelineSpecialization::PipelineSpecialization(const PipelineReflectionData& pipelineData)
+    {
+        m_stages.reserve(pipelineData.shaderData.size());
+        for (const auto& shader : pipelineData.shaderData)
+        {
+            m_stages.emplace_back(shader);
+        }
+    }
+
+    void PipelineSpecialization::reset()
+    {
+        for (auto& stage : m_stages)
+        {
+            stage.reset();
+        }
+    }
+
+    auto PipelineSpecialization::getKey() const -> SpecializationKey
+    {
+        SpecializationKey key;
+        for (uint32_t s = 0; s < m_stages.size(); ++s)
+        {
+            SpecializationKey stageKey = m_stages[s].getKey(s);
+            key.values.insert(std::end(key.values), std::begin(stageKey.values), std::end(stageKey.values));
+            key.hash = ReflectionHash::hashCombine(key.hash, stageKey.hash);
+        }
+        return key;
+    }
+
+    void PipelineSpecialization::throwUnknownConstant(const std::string_view name)
+    {
+        throw std::runtime_error("No stage declares the specialization constant: " + std::string(name));
+    }
+}
@@ -0,0 +1,1182 @@
+#include "SpirvScanner.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace nbl
+{
+    namespace
+    {
+        // Subset of the SPIR-V grammar the scanner consumes, see the SPIR-V specification section 3
+        enum Op : uint32_t
+        {
+            OpName                          = 5,
+            OpMemberName                    = 6,
+            OpEntryPoint                    = 15,
+            OpExecutionMode                 = 16,
+            OpTypeVoid                      = 19,
+            OpTypeBool                      = 20,
+            OpTypeInt                       = 21,
+            OpTypeFloat                     = 22,
+            OpTypeVector                    = 23,
+            OpTypeMatrix                    = 24,
+            OpTypeImage                     = 25,
+            OpTypeSampler                   = 26,
+            OpTypeSampledImage              = 27,
+            OpTypeArray                     = 28,
+            OpTypeRuntimeArray              = 29,
+            OpTypeStruct                    = 30,
+            OpTypePointer                   = 32,
+            OpTypeFunction                  = 33,
+            OpConstant                      = 43,
+            OpConstantComposite             = 44,
+            OpSpecConstantTrue              = 48,
+            OpSpecConstantFalse             = 49,
+            OpSpecConstant                  = 50,
+            OpSpecConstantComposite         = 51,
+            OpSpecConstantOp                = 52,
+            OpFunction                      = 54,
+            OpFunctionCall                  = 57,
+            OpVariable                      = 59,
+            OpImageTexelPointer             = 60,
+            OpLoad                          = 61,
+            OpStore                         = 62,
+            OpCopyMemory                    = 63,
+            OpCopyMemorySized               = 64,
+            OpAccessChain                   = 65,
+            OpInBoundsAccessChain           = 66,
+            OpPtrAccessChain                = 67,
+            OpArrayLength                   = 68,
+            OpInBoundsPtrAccessChain        = 70,
+            OpDecorate                      = 71,
+            OpMemberDecorate                = 72,
+            OpCopyObject                    = 83,
+            OpIAdd                          = 128,
+            OpISub                          = 130,
+            OpIMul                          = 132,
+            OpUDiv                          = 134,
+            OpSDiv                          = 135,
+            OpUMod                          = 137,
+            OpShiftRightLogical             = 194,
+            OpShiftLeftLogical              = 196,
+            OpBitwiseOr                     = 197,
+            OpBitwiseAnd                    = 199,
+            OpAtomicLoad                    = 227,
+            OpAtomicStore                   = 228,
+            OpAtomicExchange                = 229,
+            OpAtomicXor                     = 242,
+            OpAtomicFlagTestAndSet          = 318,
+            OpAtomicFlagClear               = 319,
+            OpExecutionModeId               = 331,
+            OpTypeAccelerationStructureKHR  = 5341,
+        };
+
+        enum Decoration : uint32_t
+        {
+            DecorationSpecId                = 1,
+            DecorationBlock                 = 2,
+            DecorationBufferBlock           = 3,
+            DecorationRowMajor              = 4,
+            DecorationArrayStride           = 6,
+            DecorationMatrixStride          = 7,
+            DecorationBuiltIn               = 11,
+            DecorationLocation              = 30,
+            DecorationBinding               = 33,
+            DecorationDescriptorSet         = 34,
+            DecorationOffset                = 35,
+        };
+
+        enum BuiltIn : uint32_t
+        {
+            BuiltInWorkgroupSize            = 25,
+        };
+
+        enum ExecutionModeKind : uint32_t
+        {
+            ExecutionModeLocalSize          = 17,
+            ExecutionModeLocalSizeId        = 38,
+        };
+
+        enum StorageClass : uint32_t
+        {
+            StorageClassUniformConstant     = 0,
+            StorageClassInput               = 1,
+            StorageClassUniform             = 2,
+            StorageClassWorkgroup           = 4,
+            StorageClassPushConstant        = 9,
+            StorageClassStorageBuffer       = 12,
+        };
+
+        enum Dim : uint32_t
+        {
+            DimBuffer                       = 5,
+            DimSubpassData                  = 6,
+        };
+
+        constexpr uint32_t kSpirvMagic = 0x07230203;
+        constexpr uint32_t kHeaderSize = 5;
+        // From SPIR-V 1.4 on the entry point interface lists every global variable the entry point uses
+        constexpr uint32_t kVersion1_4 = 0x00010400;
+
+        /**
+         * @note Only the integer operations array lengths and workgroup sizes are typically computed with, others evaluate to 0.
+         */
+        auto evaluateSpecConstantOp(const uint32_t opcode, const uint32_t a, const uint32_t b) -> uint32_t
+        {
+            switch (opcode)
+            {
+                case OpIAdd:                return a + b;
+                case OpISub:                return a - b;
+                case OpIMul:                return a * b;
+                case OpUDiv:                return b != 0 ? a / b : 0;
+                case OpSDiv:                return b != 0 && !(a == 0x80000000u && b == ~0u) ? static_cast<uint32_t>(static_cast<int32_t>(a) / static_cast<int32_t>(b)) : 0;
+                case OpUMod:                return b != 0 ? a % b : 0;
+                case OpShiftRightLogical:   return b < 32 ? a >> b : 0;
+                case OpShiftLeftLogical:    return b < 32 ? a << b : 0;
+                case OpBitwiseOr:           return a | b;
+                case OpBitwiseAnd:          return a & b;
+                default:                    return 0;
+            }
+        }
+
+        /**
+         * @note Covers every operand the scanner reads, resolvers index the defining instruction of an id without further checks.
+         * @return Minimum word count of the instruction, including the opcode word.
+         */
+        auto getMinWordCount(const uint32_t opcode) -> uint32_t
+        {
+            switch (opcode)
+            {
+                case OpTypeVoid:
+                case OpTypeBool:
+                case OpTypeSampler:
+                case OpTypeStruct:
+                case OpTypeAccelerationStructureKHR:    return 2;
+                case OpName:
+                case OpExecutionMode:
+                case OpExecutionModeId:
+                case OpTypeFloat:
+                case OpTypeSampledImage:
+                case OpTypeRuntimeArray:
+                case OpTypeFunction:
+                case OpConstantComposite:
+                case OpSpecConstantTrue:
+                case OpSpecConstantFalse:
+                case OpSpecConstantComposite:
+                case OpDecorate:                        return 3;
+                case OpMemberName:
+                case OpEntryPoint:
+                case OpTypeInt:
+                case OpTypeVector:
+                case OpTypeMatrix:
+                case OpTypeArray:
+                case OpTypePointer:
+                case OpConstant:
+                case OpSpecConstant:
+                case OpSpecConstantOp:
+                case OpVariable:
+                case OpMemberDecorate:                  return 4;
+                case OpFunction:                        return 5;
+                case OpTypeImage:                       return 9;
+                default:                                return 1;
+            }
+        }
+
+        auto alignUp(const uint32_t value, const uint32_t alignment) -> uint32_t
+        {
+            return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+        }
+    }
+
+    SpirvScanner::SpirvScanner(const std::span<const uint32_t> words)
+        : m_words(words)
+    {
+        if (words.size() < kHeaderSize || words[0] != kSpirvMagic)
+        {
+            throw std::runtime_error("Failed to scan shader module: invalid SPIR-V header.");
+        }
+
+        const uint32_t bound = words[3];
+        m_ids.resize(bound);
+
+        const auto defineId = [&](const uint32_t id, const uint32_t opcode, const size_t wordOffset) -> IdInfo& {
+            if (id >= bound)
+            {
+                throw std::runtime_error("Failed to scan shader module: id out of bounds.");
+            }
+            IdInfo& info = m_ids[id];
+            info.opcode     = opcode;
+            info.wordOffset = static_cast<uint32_t>(wordOffset);
+            return info;
+        };
+
+        const auto decorateId = [&](const uint32_t id) -> IdInfo& {
+            if (id >= bound)
+            {
+                throw std::runtime_error("Failed to scan shader module: id out of bounds.");
+            }
+            return m_ids[id];
+        };
+
+        // Function whose body is being scanned
+        uint32_t functionId = kInvalid;
+
+        size_t offset = kHeaderSize;
+        while (offset < words.size())
+        {
+            const uint32_t wordCount = words[offset] >> 16;
+            const uint32_t opcode    = words[offset] & 0xFFFF;
+            if (wordCount == 0 || wordCount < getMinWordCount(opcode) || offset + wordCount > words.size())
+            {
+                throw std::runtime_error("Failed to scan shader module: malformed instruction.");
+            }
+
+            const auto ins = words.subspan(offset, wordCount);
+
+            // Global declarations always precede function definitions
+            if (opcode == OpFunction)
+            {
+                // Bodies are only needed to tell the variables of several entry points apart, later versions list them in the interface
+                if (m_entryPoints.size() < 2 || words[1] >= kVersion1_4)
+                {
+                    break;
+                }
+                defineId(ins[2], opcode, offset);
+                functionId = ins[2];
+            }
+
+            if (functionId != kInvalid)
+            {
+                recordFunctionReferences(functionId, ins);
+                offset += wordCount;
+                continue;
+            }
+
+            switch (opcode)
+            {
+                case OpName:
+                {
+                    size_t nameLength = 0;
+                    decorateId(ins[1]).name = readString(ins.subspan(2), nameLength);
+                    break;
+                }
+                case OpMemberName:
+                {
+                    size_t nameLength = 0;
+                    m_memberNames.push_back({ ins[1], ins[2], readString(ins.subspan(3), nameLength) });
+                    break;
+                }
+                case OpEntryPoint:
+                {
+                    size_t nameLength = 0;
+                    EntryPoint& entryPoint = m_entryPoints.emplace_back();
+                    entryPoint.executionModel = ins[1];
+                    entryPoint.functionId     = ins[2];
+                    entryPoint.name           = readString(ins.subspan(3), nameLength);
+                    entryPoint.interface      = ins.subspan(3 + nameLength);
+                    break;
+                }
+                case OpExecutionMode:
+                case OpExecutionModeId:
+                {
+                    m_executionModes.push_back({ ins[1], ins[2], ins.subspan(3) });
+                    break;
+                }
+                case OpDecorate:
+                {
+                    IdInfo& info = decorateId(ins[1]);
+                    const uint32_t value = wordCount > 3 ? ins[3] : 0;
+                    switch (ins[2])
+                    {
+                        case DecorationSpecId:          info.specId      = value; break;
+                        case DecorationBlock:           info.block       = true;  break;
+                        case DecorationBufferBlock:     info.bufferBlock = true;  break;
+                        case DecorationArrayStride:     info.arrayStride = value; break;
+                        case DecorationBuiltIn:         info.builtIn     = value; break;
+                        case DecorationLocation:        info.location    = value; break;
+                        case DecorationBinding:         info.binding     = value; break;
+                        case DecorationDescriptorSet:   info.set         = value; break;
+                        default: break;
+                    }
+                    break;
+                }
+                case OpMemberDecorate:
+                {
+                    m_memberDecorations.push_back({ ins[1], ins[2], ins[3], wordCount > 4 ? ins[4] : 0 });
+                    break;
+                }
+                case OpTypeVoid:
+                case OpTypeBool:
+                case OpTypeInt:
+                case OpTypeFloat:
+                case OpTypeVector:
+                case OpTypeMatrix:
+                case OpTypeImage:
+                case OpTypeSampler:
+                case OpTypeSampledImage:
+                case OpTypeArray:
+                case OpTypeRuntimeArray:
+                case OpTypeStruct:
+                case OpTypePointer:
+                case OpTypeFunction:
+                case OpTypeAccelerationStructureKHR:
+                {
+                    defineId(ins[1], opcode, offset);
+                    break;
+                }
+                case OpConstant:
+                {
+                    defineId(ins[2], opcode, offset).constantValue = ins[3];
+                    break;
+                }
+                case OpSpecConstant:
+                {
+                    defineId(ins[2], opcode, offset).constantValue = ins[3];
+                    m_specConstants.push_back(ins[2]);
+                    break;
+                }
+                case OpSpecConstantTrue:
+                case OpSpecConstantFalse:
+                {
+                    defineId(ins[2], opcode, offset).constantValue = opcode == OpSpecConstantTrue;
+                    m_specConstants.push_back(ins[2]);
+                    break;
+                }
+                case OpSpecConstantOp:
+                {
+                    // Operands are defined before their use, their default values are already known
+                    const auto operand = [&](const size_t i) { return i < wordCount ? decorateId(ins[i]).constantValue : 0; };
+                    defineId(ins[2], opcode, offset).constantValue = evaluateSpecConstantOp(ins[3], operand(4), operand(5));
+                    break;
+                }
+                case OpConstantComposite:
+                case OpSpecConstantComposite:
+                {
+                    if (defineId(ins[2], opcode, offset).builtIn == BuiltInWorkgroupSize)
+                    {
+                        m_workgroupSizeId = ins[2];
+                    }
+                    break;
+                }
+                case OpVariable:
+                {
+                    defineId(ins[2], opcode, offset);
+                    m_variables.push_back({ ins[2], ins[1], ins[3] });
+                    break;
+                }
+                default: break;
+            }
+
+            offset += wordCount;
+        }
+
+        std::ranges::sort(m_memberDecorations, {}, [](const MemberDecoration& md) {
+            return std::tie(md.structId, md.member, md.decoration);
+        });
+        std::ranges::sort(m_memberNames, {}, [](const MemberName& mn) {
+            return std::tie(mn.structId, mn.member);
+        });
+        std::ranges::stable_sort(m_functionReferences, {}, &FunctionReference::functionId);
+    }
+
+    void SpirvScanner::recordFunctionReferences(const uint32_t functionId, const std::span<const uint32_t> ins)
+    {
+        const auto reference = [&](const size_t i) {
+            if (i < ins.size())
+            {
+                m_functionReferences.push_back({ functionId, ins[i] });
+            }
+        };
+
+        // Only instructions that can take a global variable (or a function) as an operand
+        const uint32_t opcode = ins[0] & 0xFFFF;
+        switch (opcode)
+        {
+            case OpFunctionCall:
+            {
+                // Callee followed by the arguments, pointers to globals may be passed along
+                for (size_t i = 3; i < ins.size(); ++i)
+                {
+                    reference(i);
+                }
+                break;
+            }
+            case OpStore:
+            case OpAtomicStore:
+            case OpAtomicFlagClear:
+            {
+                reference(1);
+                break;
+            }
+            case OpCopyMemory:
+            case OpCopyMemorySized:
+            {
+                reference(1);
+                reference(2);
+                break;
+            }
+            case OpImageTexelPointer:
+            case OpLoad:
+            case OpAccessChain:
+            case OpInBoundsAccessChain:
+            case OpPtrAccessChain:
+            case OpArrayLength:
+            case OpInBoundsPtrAccessChain:
+            case OpCopyObject:
+            case OpAtomicLoad:
+            case OpAtomicFlagTestAndSet:
+            {
+                reference(3);
+                break;
+            }
+            default:
+            {
+                if (opcode >= OpAtomicExchange && opcode <= OpAtomicXor)
+                {
+                    reference(3);
+                }
+                break;
+            }
+        }
+    }
+
+    auto SpirvScanner::getEntryPoint(const size_t entryPoint) const -> const EntryPoint&
+    {
+        if (m_entryPoints.empty())
+        {
+            throw std::runtime_error("Failed to scan shader module: no entry point found.");
+        }
+        if (entryPoint >= m_entryPoints.size())
+        {
+            throw std::runtime_error("Failed to scan shader module: entry point #" + std::to_string(entryPoint) + " does not exist.");
+        }
+        return m_entryPoints[entryPoint];
+    }
+
+    auto SpirvScanner::resolveUsedVariables(const EntryPoint& entryPoint) const -> std::vector<bool>
+    {
+        std::vector<bool> used;
+        if (m_words[1] >= kVersion1_4)
+        {
+            used.resize(m_ids.size());
+            for (const uint32_t id : entryPoint.interface)
+            {
+                if (id < used.size())
+                {
+                    used[id] = true;
+                }
+            }
+            return used;
+        }
+
+        // Function bodies were skipped, every variable belongs to the only entry point
+        if (m_entryPoints.size() < 2)
+        {
+            return used;
+        }
+
+        // Static call tree of the entry point, the same usage spirv-reflect reports per entry point
+        used.resize(m_ids.size());
+        std::vector<bool> visited(m_ids.size());
+        std::vector<uint32_t> pending { entryPoint.functionId };
+        while (!pending.empty())
+        {
+            const uint32_t functionId = pending.back();
+            pending.pop_back();
+            if (functionId >= visited.size() || visited[functionId])
+            {
+                continue;
+            }
+            visited[functionId] = true;
+
+            const auto first = std::ranges::lower_bound(m_functionReferences, functionId, {}, &FunctionReference::functionId);
+            for (auto it = first; it != std::end(m_functionReferences) && it->functionId == functionId; ++it)
+            {
+                if (it->id >= m_ids.size())
+                {
+                    continue;
+                }
+                if (m_ids[it->id].opcode == OpFunction)
+                {
+                    pending.push_back(it->id);
+                }
+                else if (m_ids[it->id].opcode == OpVariable)
+                {
+                    used[it->id] = true;
+                }
+            }
+        }
+
+        return used;
+    }
+
+    void SpirvScanner::reflect(ShaderReflectionData& result, const size_t entryPointIndex) const
+    {
+        const EntryPoint& entryPoint = getEntryPoint(entryPointIndex);
+        const vk::ShaderStageFlagBits stage = convertExecutionModel(entryPoint.executionModel);
+
+        // With a single entry point every declared resource is reported, like spirv-reflect's module wide data
+        const std::vector<bool> used = m_entryPoints.size() > 1 ? resolveUsedVariables(entryPoint) : std::vector<bool>();
+
+        result.entryPoint  = entryPoint.name;
+        result.shaderStage = stage;
+
+        // Descriptor bindings, sorted by set and binding number the same way spirv-reflect reports them
+        struct Binding
+        {
+            uint32_t                       set;
+            vk::DescriptorSetLayoutBinding binding;
+        };
+        std::vector<Binding> bindings;
+
+        // Push constants
+        result.pushConstants.clear();
+
+        // Buffer blocks are sorted together with the bindings, push constant blocks follow them
+        std::vector<ShaderReflectionBlock> pushConstantBlocks;
+        result.blocks.clear();
+
+        for (const Variable& variable : m_variables)
+        {
+            if (!used.empty() && !used[variable.id])
+            {
+                continue;
+            }
+
+            const uint32_t pointeeId = instruction(variable.pointerTypeId, OpTypePointer)[3];
+
+            if (variable.storageClass == StorageClassPushConstant)
+            {
+                uint32_t minOffset = kInvalid;
+                const auto first = std::ranges::lower_bound(m_memberDecorations, pointeeId, {}, &MemberDecoration::structId);
+                for (auto it = first; it != std::end(m_memberDecorations) && it->structId == pointeeId; ++it)
+                {
+                    if (it->decoration == DecorationOffset)
+                    {
+                        minOffset = std::min(minOffset, it->value);
+                    }
+                }
+
+                result.pushConstants.push_back(vk::PushConstantRange()
+                    .setStageFlags(stage)
+                    .setOffset(minOffset == kInvalid ? 0 : minOffset)
+                    .setSize(resolveStructSize(pointeeId)));
+                pushConstantBlocks.push_back(resolveBlock(ShaderBlockType::ePushConstant, variable.id, pointeeId));
+                continue;
+            }
+
+            if (variable.storageClass != StorageClassUniformConstant
+                && variable.storageClass != StorageClassUniform
+                && variable.storageClass != StorageClassStorageBuffer)
+            {
+                continue;
+            }
+
+            const IdInfo& info = m_ids[variable.id];
+            if (info.set == kInvalid || info.binding == kInvalid)
+            {
+                continue;
+            }
+
+            uint32_t count = 1;
+            const vk::DescriptorType type = resolveDescriptorType(pointeeId, variable.storageClass, count);
+            bindings.push_back({ info.set, vk::DescriptorSetLayoutBinding()
+                .setDescriptorCount(count)
+                .setBinding(info.binding)
+                .setDescriptorType(type)
+                .setStageFlags(stage) });
+
+            if (type == vk::DescriptorType::eUniformBuffer || type == vk::DescriptorType::eStorageBuffer)
+            {
+                uint32_t structId = pointeeId;
+                while (m_ids[structId].opcode == OpTypeArray || m_ids[structId].opcode == OpTypeRuntimeArray)
+                {
+                    structId = instruction(structId)[2];
+                }
+                result.blocks.push_back(resolveBlock(type == vk::DescriptorType::eUniformBuffer ? ShaderBlockType::eUniformBuffer : ShaderBlockType::eStorageBuffer,
+                                                     variable.id, structId));
+            }
+        }
+
+        std::ranges::stable_sort(bindings, {}, [](const Binding& b) { return std::tie(b.set, b.binding.binding); });
+        std::ranges::stable_sort(result.blocks, {}, [](const ShaderReflectionBlock& b) { return std::tie(b.set, b.binding); });
+        result.blocks.insert(std::end(result.blocks), std::make_move_iterator(std::begin(pushConstantBlocks)), std::make_move_iterator(std::end(pushConstantBlocks)));
+
+        result.descriptorSets.clear();
+        for (const Binding& binding : bindings)
+        {
+            if (result.descriptorSets.empty() || result.descriptorSets.back().set != binding.set)
+            {
+                result.descriptorSets.push_back({ .set = binding.set });
+            }
+            result.descriptorSets.back().bindings.push_back(binding.binding);
+        }
+
+        // Vertex input, built-ins are not fetched from vertex buffers
+        result.vertexInput.reset();
+        if (stage == vk::ShaderStageFlagBits::eVertex)
+        {
+            std::vector<uint32_t> inputs;
+            for (const uint32_t id : entryPoint.interface)
+            {
+                if (id < m_ids.size() && m_ids[id].opcode == OpVariable && m_ids[id].builtIn == kInvalid
+                    && instruction(id)[3] == StorageClassInput)
+                {
+                    inputs.push_back(id);
+                }
+            }
+            std::ranges::sort(inputs, {}, [&](const uint32_t id) { return m_ids[id].location; });
+
+            ShaderReflectionVertexInput vertexInput;
+            for (const uint32_t id : inputs)
+            {
+                vertexInput.attributeDescriptions.push_back(vk::VertexInputAttributeDescription()
+                    .setLocation(m_ids[id].location)
+                    .setFormat(resolveFormat(instruction(instruction(id)[1], OpTypePointer)[3])));
+                vertexInput.attributeNames.emplace_back(m_ids[id].name);
+            }
+            vertexInput.applyLayout(VertexInputLayout::eInterleaved);
+            result.vertexInput = std::move(vertexInput);
+        }
+
+        // Specialization constants, only the ones with a SpecId can be specialized
+        result.specConstants.clear();
+        for (const uint32_t id : m_specConstants)
+        {
+            if (m_ids[id].specId != kInvalid)
+            {
+                if (auto constant = resolveSpecializationConstant(id))
+                {
+                    result.specConstants.push_back(std::move(*constant));
+                }
+            }
+        }
+        std::ranges::stable_sort(result.specConstants, {}, &ShaderSpecializationConstant::constantId);
+
+        result.workgroup = resolveWorkgroup(entryPointIndex);
+    }
+
+    auto SpirvScanner::resolveWorkgroup(const size_t entryPointIndex) const -> std::optional<ShaderReflectionWorkgroup>
+    {
+        if (m_entryPoints.empty())
+        {
+            return std::nullopt;
+        }
+
+        const EntryPoint& entryPoint = getEntryPoint(entryPointIndex);
+        const vk::ShaderStageFlagBits stage = convertExecutionModel(entryPoint.executionModel);
+        if (stage != vk::ShaderStageFlagBits::eCompute && stage != vk::ShaderStageFlagBits::eTaskEXT && stage != vk::ShaderStageFlagBits::eMeshEXT)
+        {
+            return std::nullopt;
+        }
+
+        ShaderReflectionWorkgroup workgroup;
+        const auto setDimension = [&](const size_t dimension, const uint32_t id) {
+            const IdInfo& info = getId(id);
+            workgroup.localSize[dimension]            = info.constantValue;
+            workgroup.localSizeConstantIds[dimension] = info.opcode == OpSpecConstant ? info.specId : kInvalid;
+        };
+
+        for (const ExecutionMode& mode : m_executionModes)
+        {
+            if (mode.functionId != entryPoint.functionId || mode.operands.size() < 3)
+            {
+                continue;
+            }
+            for (size_t d = 0; d < 3; ++d)
+            {
+                if (mode.mode == ExecutionModeLocalSize)
+                {
+                    workgroup.localSize[d] = mode.operands[d];
+                }
+                else if (mode.mode == ExecutionModeLocalSizeId)
+                {
+                    setDimension(d, mode.operands[d]);
+                }
+            }
+        }
+
+        // The WorkgroupSize built-in overrides the execution mode, glslang emits both for local_size_*_id
+        if (m_workgroupSizeId != kInvalid)
+        {
+            const auto composite = instruction(m_workgroupSizeId);
+            for (size_t d = 0; d < 3 && 3 + d < composite.size(); ++d)
+            {
+                setDimension(d, composite[3 + d]);
+            }
+        }
+
+        const std::vector<bool> used = resolveUsedVariables(entryPoint);
+        for (const Variable& variable : m_variables)
+        {
+            if (variable.storageClass != StorageClassWorkgroup || (!used.empty() && !used[variable.id]))
+            {
+                continue;
+            }
+
+            ShaderWorkgroupVariable shared;
+            shared.name = m_ids[variable.id].name;
+
+            uint32_t alignment = 1;
+            const uint32_t typeId = instruction(variable.pointerTypeId, OpTypePointer)[3];
+            shared.size = resolveWorkgroupTypeSize(typeId, alignment);
+            if (m_ids[typeId].opcode == OpTypeArray)
+            {
+                const auto array = instruction(typeId);
+                const IdInfo& length = getId(array[3]);
+                if (length.opcode == OpSpecConstant && length.specId != kInvalid)
+                {
+                    uint32_t elementAlignment = 1;
+                    shared.lengthConstantId = length.specId;
+                    shared.elementSize      = alignUp(resolveWorkgroupTypeSize(array[2], elementAlignment), elementAlignment);
+                }
+            }
+
+            workgroup.sharedMemorySize += shared.size;
+            workgroup.sharedVariables.push_back(std::move(shared));
+        }
+
+        return workgroup;
+    }
+
+    auto SpirvScanner::resolveSpecializationConstant(const uint32_t id) const -> std::optional<ShaderSpecializationConstant>
+    {
+        if (id >= m_ids.size())
+        {
+            return std::nullopt;
+        }
+
+        const IdInfo& info = m_ids[id];
+        ShaderSpecializationConstant constant;
+        constant.constantId = info.specId == kInvalid ? 0 : info.specId;
+        constant.name       = info.name;
+
+        switch (info.opcode)
+        {
+            case OpSpecConstantTrue:
+            case OpSpecConstantFalse:
+            {
+                constant.type         = SpecializationConstantType::eBool;
+                constant.width        = 32;
+                constant.defaultValue = info.opcode == OpSpecConstantTrue;
+                return constant;
+            }
+            case OpSpecConstant:
+            {
+                const auto ins  = instruction(id);
+                const auto type = instruction(ins[1]);
+                if (m_ids[ins[1]].opcode == OpTypeInt)
+                {
+                    constant.type = type[3] != 0 ? SpecializationConstantType::eInt : SpecializationConstantType::eUint;
+                }
+                else if (m_ids[ins[1]].opcode == OpTypeFloat)
+                {
+                    constant.type = SpecializationConstantType::eFloat;
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+
+                // Literals wider than 32 bits are stored low-order word first, narrower ones may be sign extended
+                constant.width        = type[2];
+                constant.defaultValue = ins[3];
+                if (constant.width > 32 && ins.size() > 4)
+                {
+                    constant.defaultValue |= static_cast<uint64_t>(ins[4]) << 32;
+                }
+                if (constant.width < 64)
+                {
+                    constant.defaultValue &= (uint64_t(1) << constant.width) - 1;
+                }
+                return constant;
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+
+    auto SpirvScanner::getId(const uint32_t id) const -> const IdInfo&
+    {
+        if (id >= m_ids.size())
+        {
+            throw std::runtime_error("Failed to scan shader module: id out of bounds.");
+        }
+        return m_ids[id];
+    }
+
+    auto SpirvScanner::instruction(const uint32_t id) const -> std::span<const uint32_t>
+    {
+        if (id >= m_ids.size() || m_ids[id].opcode == 0)
+        {
+            throw std::runtime_error("Failed to scan shader module: reference to undefined id.");
+        }
+
+        const uint32_t wordOffset = m_ids[id].wordOffset;
+        return m_words.subspan(wordOffset, m_words[wordOffset] >> 16);
+    }
+
+    auto SpirvScanner::instruction(const uint32_t id, const uint32_t opcode) const -> std::span<const uint32_t>
+    {
+        const auto ins = instruction(id);
+        if (m_ids[id].opcode != opcode)
+        {
+            throw std::runtime_error("Failed to scan shader module: id does not name the expected instruction.");
+        }
+        return ins;
+    }
+
+    auto SpirvScanner::resolveDescriptorType(uint32_t typeId, const uint32_t storageClass, uint32_t& count) const -> vk::DescriptorType
+    {
+        // Arrays of descriptors, runtime arrays report a count of 0 like spirv-reflect does
+        count = 1;
+        auto type = instruction(typeId);
+        while (m_ids[typeId].opcode == OpTypeArray || m_ids[typeId].opcode == OpTypeRuntimeArray)
+        {
+            count *= m_ids[typeId].opcode == OpTypeArray ? getId(type[3]).constantValue : 0;
+            typeId = type[2];
+            type   = instruction(typeId);
+        }
+
+        switch (m_ids[typeId].opcode)
+        {
+            case OpTypeSampler:                 return vk::DescriptorType::eSampler;
+            case OpTypeSampledImage:            return vk::DescriptorType::eCombinedImageSampler;
+            case OpTypeAccelerationStructureKHR:return vk::DescriptorType::eAccelerationStructureKHR;
+            case OpTypeImage:
+            {
+                const uint32_t dim     = type[3];
+                const uint32_t sampled = type[7];
+                if (dim == DimSubpassData)
+                {
+                    return vk::DescriptorType::eInputAttachment;
+                }
+                if (dim == DimBuffer)
+                {
+                    return sampled == 2 ? vk::DescriptorType::eStorageTexelBuffer : vk::DescriptorType::eUniformTexelBuffer;
+                }
+                return sampled == 2 ? vk::DescriptorType::eStorageImage : vk::DescriptorType::eSampledImage;
+            }
+            case OpTypeStruct:
+            {
+                if (storageClass == StorageClassStorageBuffer || m_ids[typeId].bufferBlock)
+                {
+                    return vk::DescriptorType::eStorageBuffer;
+                }
+                return vk::DescriptorType::eUniformBuffer;
+            }
+            default: break;
+        }
+
+        throw std::runtime_error("Failed to scan shader module: unsupported descriptor type.");
+    }
+
+    auto SpirvScanner::resolveFormat(uint32_t typeId) const -> vk::Format
+    {
+        while (getId(typeId).opcode == OpTypeArray)
+        {
+            typeId = instruction(typeId)[2];
+        }
+
+        uint32_t components = 1;
+        auto type = instruction(typeId);
+        if (m_ids[typeId].opcode == OpTypeVector)
+        {
+            components = type[3];
+            typeId     = type[2];
+            type       = instruction(typeId);
+        }
+
+        const uint32_t opcode = m_ids[typeId].opcode;
+        if ((opcode != OpTypeInt && opcode != OpTypeFloat) || components < 1 || components > 4)
+        {
+            return vk::Format::eUndefined;
+        }
+
+        // Formats are laid out as [width][components][uint, sint, sfloat]
+        static constexpr vk::Format kFormats[3][4][3] = {
+            {
+                { vk::Format::eR16Uint,          vk::Format::eR16Sint,          vk::Format::eR16Sfloat          },
+                { vk::Format::eR16G16Uint,       vk::Format::eR16G16Sint,       vk::Format::eR16G16Sfloat       },
+                { vk::Format::eR16G16B16Uint,    vk::Format::eR16G16B16Sint,    vk::Format::eR16G16B16Sfloat    },
+                { vk::Format::eR16G16B16A16Uint, vk::Format::eR16G16B16A16Sint, vk::Format::eR16G16B16A16Sfloat },
+            },
+            {
+                { vk::Format::eR32Uint,          vk::Format::eR32Sint,          vk::Format::eR32Sfloat          },
+                { vk::Format::eR32G32Uint,       vk::Format::eR32G32Sint,       vk::Format::eR32G32Sfloat       },
+                { vk::Format::eR32G32B32Uint,    vk::Format::eR32G32B32Sint,    vk::Format::eR32G32B32Sfloat    },
+                { vk::Format::eR32G32B32A32Uint, vk::Format::eR32G32B32A32Sint, vk::Format::eR32G32B32A32Sfloat },
+            },
+            {
+                { vk::Format::eR64Uint,          vk::Format::eR64Sint,          vk::Format::eR64Sfloat          },
+                { vk::Format::eR64G64Uint,       vk::Format::eR64G64Sint,       vk::Format::eR64G64Sfloat       },
+                { vk::Format::eR64G64B64Uint,    vk::Format::eR64G64B64Sint,    vk::Format::eR64G64B64Sfloat    },
+                { vk::Format::eR64G64B64A64Uint, vk::Format::eR64G64B64A64Sint, vk::Format::eR64G64B64A64Sfloat },
+            },
+        };
+
+        uint32_t widthIndex;
+        switch (type[2])
+        {
+            case 16: widthIndex = 0; break;
+            case 32: widthIndex = 1; break;
+            case 64: widthIndex = 2; break;
+            default: return vk::Format::eUndefined;
+        }
+
+        const uint32_t kind = opcode == OpTypeFloat ? 2 : (type[3] != 0 ? 1 : 0);
+        return kFormats[widthIndex][components - 1][kind];
+    }
+
+    auto SpirvScanner::resolveTypeSize(const uint32_t typeId, const uint32_t matrixStride, const bool rowMajor) const -> uint32_t
+    {
+        const auto type = instruction(typeId);
+        switch (m_ids[typeId].opcode)
+        {
+            case OpTypeBool:
+                return 4;
+            case OpTypeInt:
+            case OpTypeFloat:
+                return type[2] / 8;
+            case OpTypeVector:
+                return type[3] * resolveTypeSize(type[2], 0, false);
+            case OpTypeMatrix:
+            {
+                const auto column   = instruction(type[2], OpTypeVector);
+                const uint32_t cols = type[3];
+                const uint32_t rows = column[3];
+                if (matrixStride == 0)
+                {
+                    return cols * resolveTypeSize(type[2], 0, false);
+                }
+                return (rowMajor ? rows : cols) * matrixStride;
+            }
+            case OpTypeArray:
+            {
+                const uint32_t length = getId(type[3]).constantValue;
+                const uint32_t stride = m_ids[typeId].arrayStride;
+                return length * (stride != 0 ? stride : resolveTypeSize(type[2], matrixStride, rowMajor));
+            }
+            case OpTypeRuntimeArray:
+                return 0;
+            case OpTypeStruct:
+                return resolveStructSize(typeId);
+            default:
+                return 0;
+        }
+    }
+
+    auto SpirvScanner::resolveStructSize(const uint32_t structId) const -> uint32_t
+    {
+        const auto type = instruction(structId);
+
+        uint32_t size = 0;
+        for (uint32_t member = 0; member + 2 < type.size(); ++member)
+        {
+            const MemberDecoration* offset       = findMemberDecoration(structId, member, DecorationOffset);
+            const MemberDecoration* matrixStride = findMemberDecoration(structId, member, DecorationMatrixStride);
+            const bool rowMajor = findMemberDecoration(structId, member, DecorationRowMajor) != nullptr;
+
+            const uint32_t memberOffset = offset ? offset->value : size;
+            const uint32_t memberSize   = resolveTypeSize(type[2 + member], matrixStride ? matrixStride->value : 0, rowMajor);
+            size = std::max(size, memberOffset + memberSize);
+        }
+
+        return size;
+    }
+
+    auto SpirvScanner::resolveWorkgroupTypeSize(const uint32_t typeId, uint32_t& alignment) const -> uint32_t
+    {
+        // Workgroup variables have no explicit layout, sizes follow std430 like most implementations lay them out
+        const auto type = instruction(typeId);
+        switch (m_ids[typeId].opcode)
+        {
+            case OpTypeBool:
+                alignment = 4;
+                return 4;
+            case OpTypeInt:
+            case OpTypeFloat:
+                alignment = type[2] / 8;
+                return alignment;
+            case OpTypeVector:
+            {
+                const uint32_t componentSize = resolveWorkgroupTypeSize(type[2], alignment);
+                alignment = (type[3] == 3 ? 4 : type[3]) * componentSize;
+                return type[3] * componentSize;
+            }
+            case OpTypeMatrix:
+            {
+                const uint32_t columnSize = resolveWorkgroupTypeSize(type[2], alignment);
+                return type[3] * alignUp(columnSize, alignment);
+            }
+            case OpTypeArray:
+            {
+                const uint32_t elementSize = resolveWorkgroupTypeSize(type[2], alignment);
+                return getId(type[3]).constantValue * alignUp(elementSize, alignment);
+            }
+            case OpTypeStruct:
+            {
+                uint32_t size = 0;
+                uint32_t structAlignment = 1;
+                for (size_t member = 2; member < type.size(); ++member)
+                {
+                    uint32_t memberAlignment = 1;
+                    const uint32_t memberSize = resolveWorkgroupTypeSize(type[member], memberAlignment);
+                    size = alignUp(size, memberAlignment) + memberSize;
+                    structAlignment = std::max(structAlignment, memberAlignment);
+                }
+                alignment = structAlignment;
+                return alignUp(size, structAlignment);
+            }
+            default:
+                alignment = 1;
+                return 0;
+        }
+    }
+
+    auto SpirvScanner::findMemberDecoration(const uint32_t structId, const uint32_t member, const uint32_t decoration) const -> const MemberDecoration*
+    {
+        const auto key = std::tie(structId, member, decoration);
+        const auto it = std::ranges::lower_bound(m_memberDecorations, key, {}, [](const MemberDecoration& md) {
+            return std::tie(md.structId, md.member, md.decoration);
+        });
+
+        if (it == std::end(m_memberDecorations) || std::tie(it->structId, it->member, it->decoration) != key)
+        {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    auto SpirvScanner::findMemberName(const uint32_t structId, const uint32_t member) const -> std::string_view
+    {
+        const auto key = std::tie(structId, member);
+        const auto it = std::ranges::lower_bound(m_memberNames, key, {}, [](const MemberName& mn) {
+            return std::tie(mn.structId, mn.member);
+        });
+
+        if (it == std::end(m_memberNames) || std::tie(it->structId, it->member) != key)
+        {
+            return {};
+        }
+        return it->name;
+    }
+
+    auto SpirvScanner::resolveBlock(const ShaderBlockType type, const uint32_t variableId, const uint32_t structId) const -> ShaderReflectionBlock
+    {
+        ShaderReflectionBlock block;
+        block.type     = type;
+        block.name     = m_ids[variableId].name;
+        block.typeName = m_ids[structId].name;
+        if (type != ShaderBlockType::ePushConstant)
+        {
+            block.set     = m_ids[variableId].set;
+            block.binding = m_ids[variableId].binding;
+        }
+        block.members = resolveBlockMembers(structId, 0);
+        for (const auto& member : block.members)
+        {
+            block.size = std::max(block.size, member.offset + member.size);
+        }
+        return block;
+    }
+
+    auto SpirvScanner::resolveBlockMembers(const uint32_t structId, const uint32_t baseOffset) const -> std::vector<ShaderReflectionBlockMember>
+    {
+        const auto type = instruction(structId);
+
+        std::vector<ShaderReflectionBlockMember> result(type.size() - 2);
+        for (uint32_t m = 0; m < result.size(); ++m)
+        {
+            const MemberDecoration* offset       = findMemberDecoration(structId, m, DecorationOffset);
+            const MemberDecoration* matrixStride = findMemberDecoration(structId, m, DecorationMatrixStride);
+
+            ShaderReflectionBlockMember& member = result[m];
+            member.name     = findMemberName(structId, m);
+            member.offset   = baseOffset + (offset ? offset->value : 0);
+            member.rowMajor = findMemberDecoration(structId, m, DecorationRowMajor) != nullptr;
+
+            // Array dimensions outermost first, the stride is the one of the innermost dimension
+            uint32_t typeId = type[2 + m];
+            while (getId(typeId).opcode == OpTypeArray || m_ids[typeId].opcode == OpTypeRuntimeArray)
+            {
+                const auto array = instruction(typeId);
+                member.arrayDims.push_back(m_ids[typeId].opcode == OpTypeArray ? getId(array[3]).constantValue : 0);
+                member.arrayStride = m_ids[typeId].arrayStride;
+                typeId = array[2];
+            }
+
+            uint32_t elementSize = 0;
+            if (m_ids[typeId].opcode == OpTypeStruct)
+            {
+                member.members = resolveBlockMembers(typeId, member.offset);
+                for (const auto& child : member.members)
+                {
+                    elementSize = std::max(elementSize, child.offset - member.offset + child.size);
+                }
+            }
+            else
+            {
+                if (m_ids[typeId].opcode == OpTypeMatrix && matrixStride)
+                {
+                    member.matrixStride = matrixStride->value;
+                }
+                elementSize = resolveTypeSize(typeId, member.matrixStride, member.rowMajor);
+            }
+
+            member.size = elementSize;
+            if (!member.arrayDims.empty())
+            {
+                uint32_t nElements = 1;
+                for (const uint32_t dim : member.arrayDims)
+                {
+                    nElements *= dim;
+                }
+                member.size = nElements * (member.arrayStride != 0 ? member.arrayStride : elementSize);
+            }
+        }
+
+        return result;
+    }
+
+    auto SpirvScanner::readString(const std::span<const uint32_t> words, size_t& length) -> std::string_view
+    {
+        const auto* chars = reinterpret_cast<const char*>(words.data());
+        const size_t maxLength = words.size() * sizeof(uint32_t);
+        const size_t nChars = std::find(chars, chars + maxLength, '\0') - chars;
+        if (nChars == maxLength)
+        {
+            throw std::runtime_error("Failed to scan shader module: unterminated string literal.");
+        }
+
+        length = nChars / sizeof(uint32_t) + 1;
+        return { chars, nChars };
+    }
+
+    auto SpirvScanner::convertExecutionModel(const uint32_t executionModel) -> vk::ShaderStageFlagBits
+    {
+        switch (executionModel)
+        {
+            case 0:     return vk::ShaderStageFlagBits::eVertex;
+            case 1:     return vk::ShaderStageFlagBits::eTessellationControl;
+            case 2:     return vk::ShaderStageFlagBits::eTessellationEvaluation;
+            case 3:     return vk::ShaderStageFlagBits::eGeometry;
+            case 4:     return vk::ShaderStageFlagBits::eFragment;
+            case 5:     return vk::ShaderStageFlagBits::eCompute;
+            case 5267:
+            case 5364:  return vk::ShaderStageFlagBits::eTaskEXT;
+            case 5268:
+            case 5365:  return vk::ShaderStageFlagBits::eMeshEXT;
+            case 5313:  return vk::ShaderStageFlagBits::eRaygenKHR;
+            case 5314:  return vk::ShaderStageFlagBits::eIntersectionKHR;
+            case 5315:  return vk::ShaderStageFlagBits::eAnyHitKHR;
+            case 5316:  return vk::ShaderStageFlagBits::eClosestHitKHR;
+            case 5317:  return vk::ShaderStageFlagBits::eMissKHR;
+            case 5318:  return vk::ShaderStageFlagBits::eCallableKHR;
+        }
+
+        throw std::runtime_error("Unknown execution model: " + std::to_string(executionModel));
+    }
+}
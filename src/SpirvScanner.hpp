@@ -0,0 +1,156 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "reflect/ShaderReflection.hpp"
+
+namespace nbl
+{
+    /**
+     * Single pass SPIR-V scanner used by ReflectionBackend::eFastScan.
+     * Only the module's global declarations are recorded (entry points, decorations, types, constants and variables),
+     * scanning stops at the first function body, which is where the bulk of large modules lives.
+     * @note Modules with several entry points before SPIR-V 1.4 are the exception, their bodies are scanned for the variables
+     * each entry point uses, later versions list them in the entry point interface.
+     */
+    class SpirvScanner
+    {
+    public:
+        explicit SpirvScanner(std::span<const uint32_t> words);
+
+        /**
+         * @note Produces the same data as the spirv-reflect backend for the entry point at the given index, in declaration order.
+         * With several entry points only the variables the entry point statically uses are reported.
+         */
+        void reflect(ShaderReflectionData& result, size_t entryPoint = 0) const;
+
+        auto getEntryPointCount() const -> size_t { return m_entryPoints.size(); }
+
+        /**
+         * @note The constant id is only set if the constant is decorated with SpecId.
+         * @return Type and default value of a scalar specialization constant, std::nullopt for other ids.
+         */
+        auto resolveSpecializationConstant(uint32_t id) const -> std::optional<ShaderSpecializationConstant>;
+
+        /**
+         * @note Execution modes and shared variables are taken from the entry point at the given index.
+         * @return Workgroup size and shared memory of a compute, task or mesh shader, std::nullopt for other stages.
+         */
+        auto resolveWorkgroup(size_t entryPoint = 0) const -> std::optional<ShaderReflectionWorkgroup>;
+
+    private:
+        static constexpr uint32_t kInvalid = ~0u;
+
+        struct IdInfo
+        {
+            // Instruction that defined the id, 0 if the id is unused
+            uint32_t opcode         = 0;
+            // Word offset of the defining instruction
+            uint32_t wordOffset     = 0;
+
+            // Decorations
+            uint32_t set            = kInvalid;
+            uint32_t binding        = kInvalid;
+            uint32_t location       = kInvalid;
+            uint32_t builtIn        = kInvalid;
+            uint32_t arrayStride    = 0;
+            uint32_t specId         = kInvalid;
+            bool     block          = false;
+            bool     bufferBlock    = false;
+
+            // Scalar constant value, used for array lengths and workgroup sizes
+            uint32_t constantValue  = 0;
+
+            // Debug name from OpName
+            std::string_view name   = {};
+        };
+
+        struct MemberDecoration
+        {
+            uint32_t structId;
+            uint32_t member;
+            uint32_t decoration;
+            uint32_t value;
+        };
+
+        struct MemberName
+        {
+            uint32_t            structId;
+            uint32_t            member;
+            std::string_view    name;
+        };
+
+        struct EntryPoint
+        {
+            uint32_t              executionModel = 0;
+            uint32_t              functionId     = 0;
+            std::string_view      name           = {};
+            std::span<const uint32_t> interface  = {};
+        };
+
+        struct ExecutionMode
+        {
+            uint32_t                  functionId;
+            uint32_t                  mode;
+            // Literals for OpExecutionMode, ids for OpExecutionModeId
+            std::span<const uint32_t> operands;
+        };
+
+        struct Variable
+        {
+            uint32_t id;
+            uint32_t pointerTypeId;
+            uint32_t storageClass;
+        };
+
+        // Variable or function referenced from a function body
+        struct FunctionReference
+        {
+            uint32_t functionId;
+            uint32_t id;
+        };
+
+        auto getId(uint32_t id) const -> const IdInfo&;
+        auto instruction(uint32_t id) const -> std::span<const uint32_t>;
+
+        /**
+         * @note Throws if the id is not defined by an instruction with the specified opcode, so its operands can be read unchecked.
+         */
+        auto instruction(uint32_t id, uint32_t opcode) const -> std::span<const uint32_t>;
+        void recordFunctionReferences(uint32_t functionId, std::span<const uint32_t> ins);
+        auto getEntryPoint(size_t entryPoint) const -> const EntryPoint&;
+
+        /**
+         * @return Flags indexed by id, empty if every variable of the module counts as used.
+         */
+        auto resolveUsedVariables(const EntryPoint& entryPoint) const -> std::vector<bool>;
+
+        auto resolveDescriptorType(uint32_t typeId, uint32_t storageClass, uint32_t& count) const -> vk::DescriptorType;
+        auto resolveFormat        (uint32_t typeId) const -> vk::Format;
+        auto resolveTypeSize      (uint32_t typeId, uint32_t matrixStride, bool rowMajor) const -> uint32_t;
+        auto resolveStructSize    (uint32_t structId) const -> uint32_t;
+        auto findMemberDecoration (uint32_t structId, uint32_t member, uint32_t decoration) const -> const MemberDecoration*;
+        auto findMemberName       (uint32_t structId, uint32_t member) const -> std::string_view;
+        auto resolveBlock         (ShaderBlockType type, uint32_t variableId, uint32_t structId) const -> ShaderReflectionBlock;
+        auto resolveBlockMembers  (uint32_t structId, uint32_t baseOffset) const -> std::vector<ShaderReflectionBlockMember>;
+        auto resolveWorkgroupTypeSize(uint32_t typeId, uint32_t& alignment) const -> uint32_t;
+
+        static auto readString(std::span<const uint32_t> words, size_t& length) -> std::string_view;
+        static auto convertExecutionModel(uint32_t executionModel) -> vk::ShaderStageFlagBits;
+
+        std::span<const uint32_t>      m_words;
+        std::vector<IdInfo>            m_ids;
+        std::vector<MemberDecoration>  m_memberDecorations;
+        std::vector<MemberName>        m_memberNames;
+        std::vector<EntryPoint>        m_entryPoints;
+        std::vector<Variable>          m_variables;
+        std::vector<uint32_t>          m_specConstants;
+        std::vector<ExecutionMode>     m_executionModes;
+        // Sorted by function, only recorded when the bodies are scanned
+        std::vector<FunctionReference> m_functionReferences;
+        // Constant decorated with the WorkgroupSize built-in
+        uint32_t                       m_workgroupSizeId = kInvalid;
+    };
+}
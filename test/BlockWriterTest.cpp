@@ -0,0 +1,108 @@
+#include <array>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <reflect/BlockWriter.hpp>
+#include <reflect/ShaderReflection.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+namespace
+{
+    auto blockLayouts() -> int
+    {
+        const auto vertex   = reflect(buildVertexModule());
+        const auto fragment = reflect(buildFragmentModule());
+
+        const nbl::ShaderReflectionBlock* camera = vertex.findBlock("Camera");
+        int failures = check(camera && camera->type == nbl::ShaderBlockType::eUniformBuffer && camera->name == "camera" && camera->size == 80, "vertex uniform block");
+        const nbl::ShaderReflectionBlockMember* viewProjection = camera ? camera->findMember("viewProjection") : nullptr;
+        failures += check(viewProjection && viewProjection->offset == 0 && viewProjection->size == 64 && viewProjection->matrixStride == 16, "uniform matrix member");
+
+        failures += check(fragment.blocks.size() == 2 && fragment.blocks[1].type == nbl::ShaderBlockType::ePushConstant, "push constant block follows buffers");
+        const nbl::ShaderReflectionBlock* lightBuffer = fragment.findBlock("lightBuffer");
+        const nbl::ShaderReflectionBlockMember* lights = lightBuffer ? lightBuffer->findMember("lights") : nullptr;
+        failures += check(lightBuffer && lightBuffer->type == nbl::ShaderBlockType::eStorageBuffer && lightBuffer->size == 16, "storage block without runtime array");
+        failures += check(lights && lights->arrayDims == std::vector<uint32_t> { 0 } && lights->arrayStride == 16 && lights->size == 0, "runtime array member");
+
+        return failures;
+    }
+
+    auto pushConstants() -> int
+    {
+        const auto fragment = reflect(buildFragmentModule());
+        if (fragment.blocks.size() != 2)
+        {
+            return check(false, "fragment push constant block");
+        }
+
+        // Push constants of the fragment stage start at 64, only the written member is uploaded
+        nbl::BlockWriter writer(fragment.blocks[1]);
+        const auto tint = writer.findMember("tint");
+        writer.set(tint, std::array { 1.0f, 0.5f, 0.25f, 1.0f });
+        const auto updates = writer.getPushConstantUpdates(fragment.pushConstants);
+        int failures = check(tint.offset == 128 && tint.size == 16 && writer.size() == 144, "push constant member handle");
+        failures += check(updates.size() == 1 && updates[0].offset == 128 && updates[0].size == 16
+                          && updates[0].stageFlags == vk::ShaderStageFlagBits::eFragment, "push constant update range");
+        failures += check(writer.get<std::array<float, 4>>(tint) == std::array { 1.0f, 0.5f, 0.25f, 1.0f }, "written value read back");
+
+        writer.clearDirty();
+        writer.set(tint, std::array { 1.0f, 0.5f, 0.25f, 1.0f });
+        writer.set("transform", 2.0f);
+        failures += check(writer.getDirtyRanges() == std::vector<nbl::BlockRange> { { 64, 4 } }, "unchanged values are not uploaded");
+
+        return failures;
+    }
+
+    auto runtimeArrays() -> int
+    {
+        const auto fragment = reflect(buildFragmentModule());
+        const nbl::ShaderReflectionBlock* lightBuffer = fragment.findBlock("lightBuffer");
+        if (lightBuffer == nullptr)
+        {
+            return check(false, "fragment storage block");
+        }
+
+        nbl::BlockWriter writer(*lightBuffer, 8);
+        const auto light = writer.findMember("lights[3]");
+        writer.set(writer.findMember("count"), 8u);
+        writer.set(light, std::array { 0.0f, 1.0f, 0.0f, 1.0f });
+        int failures = check(writer.size() == 144 && light.offset == 64 && light.size == 16, "runtime array element handle");
+        failures += check(writer.getDirtyRanges(4, 64) == std::vector<nbl::BlockRange> { { 0, 80 } }, "nearby dirty ranges merged");
+        failures += check(writer.getDirtyRanges() == std::vector<nbl::BlockRange> { { 0, 4 }, { 64, 16 } }, "distant dirty ranges kept apart");
+        failures += check(!writer.findMember("lights[3].x").isValid() && !writer.findMember("count[0]").isValid(), "invalid member paths");
+
+        // Elements past the runtime array length are rejected when written
+        bool threw = false;
+        try
+        {
+            writer.set(writer.findMember("lights[8]"), std::array { 0.0f, 0.0f, 0.0f, 0.0f });
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        failures += check(threw, "runtime array element out of bounds");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    try
+    {
+        failures = blockLayouts() + pushConstants() + runtimeArrays();
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::cout << "[Block Writer | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
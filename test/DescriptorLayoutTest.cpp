@@ -0,0 +1,135 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <reflect/DescriptorLayoutRegistry.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+using nbl::DescriptorLayoutRegistry;
+
+namespace
+{
+    // Hashes of the layouts below, they must never change between runs or builds
+    constexpr uint64_t kSceneSetLayoutHash      = 0x19B18E92B1255731ull;
+    constexpr uint64_t kScenePipelineLayoutHash = 0xA3FE80DDC6C2A990ull;
+
+    auto sceneSet() -> nbl::ShaderReflectionDescriptorSet
+    {
+        return { 0, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment),
+                      vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eCombinedImageSampler, 4, vk::ShaderStageFlagBits::eFragment) } };
+    }
+
+    auto materialSet() -> nbl::ShaderReflectionDescriptorSet
+    {
+        return { 1, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eFragment) } };
+    }
+
+    auto pipeline(std::vector<nbl::ShaderReflectionDescriptorSet> descriptorSets, std::vector<vk::PushConstantRange> pushConstants) -> nbl::PipelineReflectionData
+    {
+        return { .descriptorSets = std::move(descriptorSets), .pushConstants = std::move(pushConstants) };
+    }
+
+    auto setLayouts() -> int
+    {
+        DescriptorLayoutRegistry registry;
+        const auto scene = registry.internSetLayout(sceneSet());
+
+        auto reordered = sceneSet();
+        std::swap(reordered.bindings[0], reordered.bindings[1]);
+        reordered.set = 3;
+        int failures = check(registry.internSetLayout(reordered) == scene, "equal bindings in any order and set intern to the same handle");
+
+        auto stages = sceneSet();
+        stages.bindings[1].stageFlags |= vk::ShaderStageFlagBits::eVertex;
+        const auto withStages = registry.internSetLayout(stages);
+        failures += check(withStages != scene, "different stage flags intern to a different handle");
+
+        auto count = sceneSet();
+        count.bindings[1].descriptorCount = 8;
+        const auto withCount = registry.internSetLayout(count);
+        failures += check(withCount != scene && withCount != withStages, "different descriptor count interns to a different handle");
+
+        auto type = sceneSet();
+        type.bindings[0].descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+        failures += check(registry.internSetLayout(type) != scene, "different descriptor type interns to a different handle");
+
+        failures += check(registry.getSetLayoutCount() == 4, "set layout count");
+        failures += check(registry.getSetLayout(scene).bindings[0].binding == 0, "interned bindings sorted by number");
+        failures += check(registry.getSetLayout(scene).hash == kSceneSetLayoutHash, "set layout hash stable across runs");
+        failures += check(DescriptorLayoutRegistry::hashSetLayout(reordered.bindings) != kSceneSetLayoutHash, "hash depends on binding order");
+
+        bool threw = false;
+        try
+        {
+            registry.getSetLayout({ 42 });
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        failures += check(threw, "invalid handle rejected");
+
+        return failures;
+    }
+
+    auto pipelineLayouts() -> int
+    {
+        const vk::PushConstantRange vertexRange(vk::ShaderStageFlagBits::eVertex, 0, 64);
+        const vk::PushConstantRange fragmentRange(vk::ShaderStageFlagBits::eFragment, 64, 16);
+
+        DescriptorLayoutRegistry registry;
+        const auto scene = registry.internPipelineLayout(pipeline({ sceneSet(), materialSet() }, { vertexRange, fragmentRange }));
+        int failures = check(registry.internPipelineLayout(pipeline({ materialSet(), sceneSet() }, { fragmentRange, vertexRange })) == scene,
+                             "equal pipeline layouts intern to the same handle");
+        failures += check(registry.getPipelineLayout(scene).hash == kScenePipelineLayoutHash, "pipeline layout hash stable across runs");
+
+        // Sets not used by a pipeline refer to the empty layout
+        const auto gap = registry.internPipelineLayout(pipeline({ { 2, materialSet().bindings } }, { vertexRange, fragmentRange }));
+        const auto& gapLayout = registry.getPipelineLayout(gap);
+        failures += check(gapLayout.setLayouts.size() == 3 && gapLayout.setLayouts[0] == gapLayout.setLayouts[1]
+                          && registry.getSetLayout(gapLayout.setLayouts[0]).bindings.empty(), "unused sets refer to the empty layout");
+
+        // Same set 0, different set 1
+        auto otherMaterial = materialSet();
+        otherMaterial.bindings[0].descriptorCount = 2;
+        const auto material = registry.internPipelineLayout(pipeline({ sceneSet(), otherMaterial }, { vertexRange, fragmentRange }));
+        failures += check(registry.isCompatibleForSet(scene, material, 0), "matching lower sets are compatible");
+        failures += check(!registry.isCompatibleForSet(scene, material, 1), "mismatching set is incompatible");
+        failures += check(registry.isCompatibleForSet(scene, scene, 1), "a layout is compatible with itself");
+
+        // Different set 0, same set 1
+        auto otherScene = sceneSet();
+        otherScene.bindings[1].descriptorCount = 2;
+        const auto lower = registry.internPipelineLayout(pipeline({ otherScene, materialSet() }, { vertexRange, fragmentRange }));
+        failures += check(!registry.isCompatibleForSet(scene, lower, 1), "mismatching lower set is incompatible");
+
+        // Same sets, different push constants
+        const auto push = registry.internPipelineLayout(pipeline({ sceneSet(), materialSet() }, { vertexRange }));
+        failures += check(push != scene && !registry.isCompatibleForSet(scene, push, 0), "mismatching push constants are incompatible");
+
+        // Set beyond the layout of one pipeline
+        const auto shorter = registry.internPipelineLayout(pipeline({ sceneSet() }, { vertexRange, fragmentRange }));
+        failures += check(registry.isCompatibleForSet(scene, shorter, 0), "shorter layout compatible for its sets");
+        failures += check(!registry.isCompatibleForSet(scene, shorter, 1), "shorter layout incompatible beyond its sets");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    try
+    {
+        failures = setLayouts() + pipelineLayouts();
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::cout << "[Descriptor Layouts | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <reflect/DescriptorPoolPlanner.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+using nbl::DescriptorPoolPlanner;
+
+namespace
+{
+    constexpr auto kVertexFragment = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment;
+
+    /**
+     * @return Descriptor count of the type, 0 if the pool sizes do not contain it.
+     */
+    auto countOf(const std::vector<vk::DescriptorPoolSize>& poolSizes, const vk::DescriptorType type) -> uint32_t
+    {
+        const auto it = std::ranges::find(poolSizes, type, &vk::DescriptorPoolSize::type);
+        return it != std::end(poolSizes) ? it->descriptorCount : 0;
+    }
+
+    auto buildPipelines() -> std::vector<nbl::PipelineReflectionData>
+    {
+        const nbl::ShaderReflectionDescriptorSet frame { 0, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, kVertexFragment) } };
+
+        std::vector<nbl::PipelineReflectionData> pipelines(3);
+        pipelines[0].descriptorSets = {
+            frame,
+            { 1, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eCombinedImageSampler, 4, vk::ShaderStageFlagBits::eFragment),
+                   vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eFragment) } },
+        };
+        pipelines[1].descriptorSets = {
+            frame,
+            { 1, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eCombinedImageSampler, 2, vk::ShaderStageFlagBits::eFragment) } },
+        };
+        // Only set 2, sets 0 and 1 are empty; the runtime array can not be budgeted
+        pipelines[2].descriptorSets = {
+            { 2, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eCombinedImageSampler, 0, vk::ShaderStageFlagBits::eFragment) } },
+        };
+        return pipelines;
+    }
+
+    auto poolSizes() -> int
+    {
+        const auto pipelines = buildPipelines();
+        const uint32_t instancesPerSet[] = { 1, 8 };
+
+        nbl::DescriptorLayoutRegistry registry;
+        const auto plan = DescriptorPoolPlanner::plan(pipelines, instancesPerSet, registry);
+
+        int failures = check(plan.layouts.size() == 4, "shared and empty layouts budgeted once");
+        failures += check(plan.buckets.size() == 3, "one bucket per used set");
+        if (failures != 0)
+        {
+            return failures;
+        }
+
+        const auto& frame = plan.buckets[0];
+        failures += check(frame.set == 0 && frame.layouts.size() == 1 && frame.maxSets == 1, "set 0 shared by two pipelines");
+        failures += check(frame.poolSizes.size() == 1 && countOf(frame.poolSizes, vk::DescriptorType::eUniformBuffer) == 1, "set 0 pool sizes");
+
+        const auto& material = plan.buckets[1];
+        failures += check(material.set == 1 && material.layouts.size() == 2 && material.maxSets == 16, "set 1 max sets scaled by its instances");
+        failures += check(countOf(material.poolSizes, vk::DescriptorType::eCombinedImageSampler) == (4 + 2) * 8, "set 1 sampler count");
+        failures += check(countOf(material.poolSizes, vk::DescriptorType::eStorageBuffer) == 8, "set 1 storage buffer count");
+
+        const auto& bindless = plan.buckets[2];
+        failures += check(bindless.set == 2 && bindless.maxSets == 8, "sets past the list use the last instance count");
+        failures += check(bindless.poolSizes.empty(), "runtime arrays not budgeted");
+
+        failures += check(plan.maxSets == 1 + 16 + 8, "total max sets");
+        failures += check(plan.poolSizes.size() == 3
+                          && countOf(plan.poolSizes, vk::DescriptorType::eUniformBuffer) == 1
+                          && countOf(plan.poolSizes, vk::DescriptorType::eCombinedImageSampler) == 48
+                          && countOf(plan.poolSizes, vk::DescriptorType::eStorageBuffer) == 8, "total pool sizes");
+
+        const auto unbounded = std::ranges::count_if(plan.layouts, &nbl::DescriptorLayoutBudget::hasUnboundedArrays);
+        failures += check(unbounded == 1, "unbounded layout flagged");
+
+        // Without instance counts every layout is allocated once
+        const auto single = DescriptorPoolPlanner::plan(pipelines, {}, registry);
+        failures += check(single.maxSets == 4 && countOf(single.poolSizes, vk::DescriptorType::eCombinedImageSampler) == 6, "one instance per layout");
+
+        return failures;
+    }
+
+    auto byteOffsets() -> int
+    {
+        const nbl::InternedDescriptorSetLayout layout { .bindings = {
+            vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, kVertexFragment),
+            vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eCombinedImageSampler, 4, vk::ShaderStageFlagBits::eFragment),
+            vk::DescriptorSetLayoutBinding(2, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eFragment),
+            vk::DescriptorSetLayoutBinding(3, vk::DescriptorType::eSampler, 2, vk::ShaderStageFlagBits::eFragment),
+        } };
+
+        const auto budget = DescriptorPoolPlanner::budgetLayout(layout, { 0 });
+        int failures = check(budget.descriptorCount == 8, "descriptor count");
+        failures += check(budget.bindingOffsets == std::vector<uint32_t> { 0, 1, 5, 6 }, "descriptor indices");
+        failures += check(budget.descriptorsByType.size() == 4 && countOf(budget.descriptorsByType, vk::DescriptorType::eCombinedImageSampler) == 4, "descriptors by type");
+
+        // Buffers 16 bytes, combined image samplers 32 bytes, samplers 8 bytes
+        const auto descriptorSize = [](const vk::DescriptorType type) -> vk::DeviceSize {
+            switch (type)
+            {
+                case vk::DescriptorType::eCombinedImageSampler: return 32;
+                case vk::DescriptorType::eSampler:              return 8;
+                default:                                        return 16;
+            }
+        };
+        failures += check(DescriptorPoolPlanner::computeByteOffsets(layout, descriptorSize) == std::vector<vk::DeviceSize> { 0, 32, 160, 176, 192 },
+                          "byte offsets aligned to the descriptor size");
+
+        const nbl::InternedDescriptorSetLayout empty;
+        failures += check(DescriptorPoolPlanner::computeByteOffsets(empty, descriptorSize) == std::vector<vk::DeviceSize> { 0 }, "empty layout size");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    try
+    {
+        failures = poolSizes() + byteOffsets();
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::cout << "[Descriptor Pool Planner | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
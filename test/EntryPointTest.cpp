@@ -0,0 +1,145 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <reflect/ShaderReflection.hpp>
+#include <reflect/ShaderReflectionCache.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+namespace
+{
+    /**
+     * @note Every entry point of a module gets its own stage and resources, found through the interface or the call tree.
+     */
+    auto multipleEntryPoints() -> int
+    {
+        int failures = 0;
+        for (const uint32_t version : { 0x00010300u, 0x00010500u })
+        {
+            const TestModule module = buildMultiEntryModule(version);
+            const auto entryPoints = nbl::ShaderReflection::reflectModule(nbl::ShaderCode::fromWords(std::vector(module.words)), module.name, nbl::ReflectionBackend::eFastScan);
+            failures += check(entryPoints.size() == 2 && entryPoints[0].entryPoint == "vsMain" && entryPoints[1].entryPoint == "fsMain"
+                              && entryPoints[0].shaderStage == vk::ShaderStageFlagBits::eVertex && entryPoints[1].shaderStage == vk::ShaderStageFlagBits::eFragment,
+                              module.name + " entry points");
+            if (entryPoints.size() != 2)
+            {
+                continue;
+            }
+
+            const auto& vs = entryPoints[0];
+            const auto& fs = entryPoints[1];
+            failures += check(vs.descriptorSets.size() == 1 && vs.descriptorSets[0].bindings.size() == 1 && vs.descriptorSets[0].bindings[0].binding == 0
+                              && vs.pushConstants.empty() && vs.blocks.size() == 1 && vs.blocks[0].name == "globals", module.name + " vertex resources");
+            failures += check(fs.descriptorSets.size() == 1 && fs.descriptorSets[0].bindings.size() == 1 && fs.descriptorSets[0].bindings[0].binding == 1
+                              && fs.descriptorSets[0].bindings[0].stageFlags == vk::ShaderStageFlagBits::eFragment
+                              && fs.pushConstants.size() == 1 && fs.pushConstants[0].offset == 64 && fs.pushConstants[0].size == 80, module.name + " fragment resources");
+            failures += check(vs.vertexInput.has_value() && vs.vertexInput->attributeDescriptions.size() == 1 && !fs.vertexInput.has_value(), module.name + " vertex input");
+            failures += check(vs.shaderCode.data() == fs.shaderCode.data(), module.name + " entry points share the code");
+
+            const auto first = nbl::ShaderReflection::reflectShader(vs.shaderCode, module.name, nbl::ReflectionBackend::eFastScan);
+            failures += check(first.entryPoint == "vsMain" && first.descriptorSets.size() == 1 && first.descriptorSets[0].bindings == vs.descriptorSets[0].bindings,
+                              module.name + " first entry point");
+
+            const nbl::PipelineReflectionData pipeline = nbl::ShaderReflection::mergePipelineShaders({ vs, fs });
+            failures += check(pipeline.descriptorSets.size() == 1 && pipeline.descriptorSets[0].bindings.size() == 2 && pipeline.conflicts.empty(),
+                              module.name + " merged pipeline");
+        }
+        return failures;
+    }
+
+    /**
+     * @note Stages of one module are created as one vk::ShaderModule, identical code from another source is found by content.
+     */
+    auto moduleDeduplication() -> int
+    {
+        const auto vertex     = reflect(buildVertexModule());
+        const auto vertexCopy = reflect(buildVertexModule().words, "vertex_copy");
+        const auto fragment   = reflect(buildFragmentModule());
+        const auto compute    = reflect(buildComputeModule());
+
+        const std::vector<nbl::PipelineReflectionData> pipelines = {
+            nbl::ShaderReflection::mergePipelineShaders({ vertex, fragment }),
+            nbl::ShaderReflection::mergePipelineShaders({ vertexCopy, fragment }),
+            nbl::ShaderReflection::mergePipelineShaders({ compute }),
+        };
+        const nbl::ShaderModuleSet moduleSet = nbl::ShaderReflection::collectShaderModules(pipelines);
+        return check(moduleSet.modules.size() == 3 && moduleSet.stageModules == std::vector<std::vector<uint32_t>> { { 0, 1 }, { 0, 1 }, { 2 } },
+                     "shader module deduplication");
+    }
+
+    /**
+     * @note Pipelines referencing a file share one load and reflection of it, the cache stores every entry point.
+     */
+    auto pipelineBatch(const std::filesystem::path& directory) -> int
+    {
+        const std::string path = (directory / "multi_entry.spv").string();
+        {
+            const auto words = buildMultiEntryModule(0x00010300).words;
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+        }
+
+        const std::vector<std::vector<nbl::ShaderStageSource>> stages = {
+            { { .filePath = path, .entryPoint = "vsMain" }, { .filePath = path, .entryPoint = "fsMain" } },
+            { { .filePath = path, .entryPoint = "fsMain" } },
+            { { .filePath = path } },
+        };
+
+        int failures = 0;
+        nbl::ShaderReflectionCache cache;
+        for (nbl::ShaderReflectionCache* batchCache : { static_cast<nbl::ShaderReflectionCache*>(nullptr), &cache, &cache })
+        {
+            const auto batch = nbl::ShaderReflection::reflectPipelineBatch(stages, nbl::ReflectionExecutionMode::eParallel, batchCache, nbl::ReflectionBackend::eFastScan);
+            const nbl::ShaderModuleSet moduleSet = nbl::ShaderReflection::collectShaderModules(batch);
+            failures += check(batch.size() == 3 && batch[0].descriptorSets.size() == 1 && batch[0].descriptorSets[0].bindings.size() == 2
+                              && batch[1].shaderData[0].entryPoint == "fsMain" && batch[1].pushConstants.size() == 1
+                              && batch[2].shaderData[0].entryPoint == "vsMain" && batch[2].pushConstants.empty(), "multi entry point pipelines");
+            failures += check(moduleSet.modules.size() == 1 && batch[1].shaderData[0].shaderCode.data() == batch[0].shaderData[0].shaderCode.data(),
+                              "pipelines share one module");
+        }
+        failures += check(cache.getMissCount() == 1 && cache.getHitCount() == 3, "cached entry points");
+
+        const auto modules = nbl::ShaderReflection::reflectModuleBatch({ path, path }, nbl::ReflectionExecutionMode::eParallel, nbl::ReflectionBackend::eFastScan);
+        failures += check(modules.size() == 2 && modules[1].size() == 2 && modules[1][0].entryPoint == "vsMain" && modules[1][1].entryPoint == "fsMain",
+                          "module batch");
+
+        bool unknownEntryPoint = false;
+        try
+        {
+            nbl::ShaderReflection::reflectPipelineShaders({ { .filePath = path, .entryPoint = "csMain" } }, nbl::ReflectionExecutionMode::eSerial,
+                                                          nullptr, nbl::ReflectionBackend::eFastScan);
+        }
+        catch (const std::runtime_error&)
+        {
+            unknownEntryPoint = true;
+        }
+        failures += check(unknownEntryPoint, "unknown entry point");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "nbl_reflect_entry_point_test";
+    std::filesystem::create_directories(directory);
+
+    int failures = 0;
+    try
+    {
+        failures = multipleEntryPoints() + moduleDeduplication() + pipelineBatch(directory);
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+    std::filesystem::remove_all(directory);
+
+    std::cout << "[Entry Point | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <array>
+#include <reflect/ShaderReflection.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+namespace
+{
+    auto sortedAttributes(const nbl::ShaderReflectionData& data) -> std::vector<vk::VertexInputAttributeDescription>
+    {
+        if (!data.vertexInput.has_value())
+        {
+            return {};
+        }
+        auto attributes = data.vertexInput->attributeDescriptions;
+        std::ranges::sort(attributes, {}, &vk::VertexInputAttributeDescription::location);
+        return attributes;
+    }
+
+    /**
+     * @return Number of mismatches between the two reflection results.
+     */
+    auto compare(const std::string& name, const nbl::ShaderReflectionData& expected, const nbl::ShaderReflectionData& actual) -> int
+    {
+        int failures = 0;
+        const auto check = [&](const bool condition, const std::string& what) {
+            if (!condition)
+            {
+                std::cout << "\t-[" << name << " | Mismatch: " << what << "]" << std::endl;
+                ++failures;
+            }
+        };
+
+        check(expected.entryPoint == actual.entryPoint, "entry point");
+        check(expected.shaderStage == actual.shaderStage, "shader stage");
+
+        check(expected.descriptorSets.size() == actual.descriptorSets.size(), "descriptor set count");
+        for (size_t i = 0; i < std::min(expected.descriptorSets.size(), actual.descriptorSets.size()); ++i)
+        {
+            const auto& e = expected.descriptorSets[i];
+            const auto& a = actual.descriptorSets[i];
+            check(e.set == a.set, "set #" + std::to_string(e.set) + " index");
+            check(e.bindings == a.bindings, "set #" + std::to_string(e.set) + " bindings");
+        }
+
+        check(expected.pushConstants == actual.pushConstants, "push constants");
+        check(expected.vertexInput.has_value() == actual.vertexInput.has_value(), "vertex input presence");
+        check(sortedAttributes(expected) == sortedAttributes(actual), "vertex attributes");
+        if (expected.vertexInput.has_value() && actual.vertexInput.has_value())
+        {
+            check(expected.vertexInput->bindingDescriptions == actual.vertexInput->bindingDescriptions, "vertex bindings");
+        }
+
+        check(expected.blocks.size() == actual.blocks.size(), "block count");
+        for (size_t i = 0; i < std::min(expected.blocks.size(), actual.blocks.size()); ++i)
+        {
+            check(expected.blocks[i] == actual.blocks[i], "block " + expected.blocks[i].name + " layout");
+        }
+        check(expected.specConstants == actual.specConstants, "specialization constants");
+        check(expected.workgroup == actual.workgroup, "workgroup");
+
+        return failures;
+    }
+
+    /**
+     * @note Checks the fast path against hand-computed values, independent of spirv-reflect.
+     */
+    auto checkExpectations() -> int
+    {
+        int failures = 0;
+        const auto check = [&](const bool condition, const std::string& what) {
+            if (!condition)
+            {
+                std::cout << "\t-[Expectation failed: " << what << "]" << std::endl;
+                ++failures;
+            }
+        };
+
+        const auto vertex = reflect(buildVertexModule());
+        check(vertex.shaderStage == vk::ShaderStageFlagBits::eVertex, "vertex stage");
+        check(vertex.pushConstants.size() == 1 && vertex.pushConstants[0].offset == 0 && vertex.pushConstants[0].size == 80, "vertex push constant range");
+        check(vertex.descriptorSets.size() == 1 && vertex.descriptorSets[0].bindings[0].descriptorType == vk::DescriptorType::eUniformBuffer, "vertex uniform buffer");
+        check(vertex.vertexInput.has_value() && vertex.vertexInput->attributeDescriptions.size() == 3, "vertex input count without built-ins");
+        check(vertex.vertexInput.has_value() && vertex.vertexInput->attributeDescriptions.size() == 3
+              && vertex.vertexInput->attributeDescriptions[2].offset == 28
+              && vertex.vertexInput->bindingDescriptions.size() == 1 && vertex.vertexInput->bindingDescriptions[0].stride == 36, "interleaved vertex layout");
+
+        const auto fragment = reflect(buildFragmentModule());
+        check(fragment.entryPoint == "fragmentMain", "fragment entry point");
+        check(fragment.pushConstants.size() == 1 && fragment.pushConstants[0].offset == 64 && fragment.pushConstants[0].size == 144, "fragment push constant range");
+        check(fragment.descriptorSets.size() == 3 && fragment.descriptorSets[1].set == 1 && fragment.descriptorSets[1].bindings[0].descriptorCount == 4, "fragment texture array");
+        check(fragment.descriptorSets.size() == 3 && fragment.descriptorSets[2].bindings[0].descriptorType == vk::DescriptorType::eInputAttachment, "fragment input attachment");
+
+        const auto compute = reflect(buildComputeModule());
+        check(compute.descriptorSets.size() == 2 && compute.descriptorSets[0].bindings.size() == 4, "compute binding count");
+        check(compute.descriptorSets.size() == 2 && compute.descriptorSets[0].bindings[3].descriptorType == vk::DescriptorType::eStorageBuffer, "compute buffer block");
+        check(compute.descriptorSets.size() == 2 && compute.descriptorSets[1].bindings[0].descriptorCount == 0, "compute runtime array");
+
+        return failures;
+    }
+
+    /**
+     * @return Copy of the module with every instruction of the opcode cut down to the specified word count.
+     */
+    auto truncateInstructions(const std::vector<uint32_t>& words, const uint32_t opcode, const uint32_t wordCount) -> std::vector<uint32_t>
+    {
+        std::vector<uint32_t> result(words.begin(), words.begin() + 5);
+        for (size_t offset = 5; offset < words.size(); offset += words[offset] >> 16)
+        {
+            const uint32_t count = words[offset] >> 16;
+            if ((words[offset] & 0xFFFF) != opcode)
+            {
+                result.insert(result.end(), words.begin() + offset, words.begin() + offset + count);
+                continue;
+            }
+            result.push_back(wordCount << 16 | opcode);
+            result.insert(result.end(), words.begin() + offset + 1, words.begin() + offset + std::min(count, wordCount));
+        }
+        return result;
+    }
+
+    /**
+     * @note Malformed modules have to be rejected with an error, never read past an instruction.
+     */
+    auto checkMalformedModules(const std::vector<TestModule>& modules) -> int
+    {
+        int failures = 0;
+        const auto rejects = [](const std::vector<uint32_t>& words, const std::string_view message) {
+            try
+            {
+                nbl::ShaderReflection::reflectModule(nbl::ShaderCode::fromView(words), "malformed", nbl::ReflectionBackend::eFastScan);
+            }
+            catch (const std::runtime_error& err)
+            {
+                return std::string_view(err.what()).find(message) != std::string_view::npos;
+            }
+            return false;
+        };
+        const auto check = [&](const bool condition, const std::string& what) {
+            if (!condition)
+            {
+                std::cout << "\t-[Expectation failed: " << what << "]" << std::endl;
+                ++failures;
+            }
+        };
+
+        // Every operand read by the scanner is cut off, the opcode word and the result id are kept
+        constexpr std::pair<uint32_t, const char*> kTruncated[] = {
+            { SpirvBuilder::OpName,             "OpName"            },
+            { SpirvBuilder::OpMemberName,       "OpMemberName"      },
+            { SpirvBuilder::OpEntryPoint,       "OpEntryPoint"      },
+            { SpirvBuilder::OpExecutionMode,    "OpExecutionMode"   },
+            { SpirvBuilder::OpDecorate,         "OpDecorate"        },
+            { SpirvBuilder::OpMemberDecorate,   "OpMemberDecorate"  },
+            { SpirvBuilder::OpTypeInt,          "OpTypeInt"         },
+            { SpirvBuilder::OpTypeVector,       "OpTypeVector"      },
+            { SpirvBuilder::OpTypeImage,        "OpTypeImage"       },
+            { SpirvBuilder::OpTypeArray,        "OpTypeArray"       },
+            { SpirvBuilder::OpTypePointer,      "OpTypePointer"     },
+            { SpirvBuilder::OpConstant,         "OpConstant"        },
+            { SpirvBuilder::OpSpecConstant,     "OpSpecConstant"    },
+            { SpirvBuilder::OpVariable,         "OpVariable"        },
+        };
+        for (const auto& [opcode, name] : kTruncated)
+        {
+            bool found = false;
+            for (const auto& module : modules)
+            {
+                const auto truncated = truncateInstructions(module.words, opcode, 2);
+                if (truncated.size() != module.words.size())
+                {
+                    found = true;
+                    check(rejects(truncated, "malformed instruction"), module.name + " truncated " + name);
+                }
+            }
+            check(found, std::string("test modules contain ") + name);
+        }
+
+        const auto& vertex = modules.front().words;
+        size_t cut = 5;
+        while ((vertex[cut] >> 16) < 3)
+        {
+            cut += vertex[cut] >> 16;
+        }
+        check(rejects({ vertex.begin(), vertex.begin() + cut + 2 }, "malformed instruction"), "module ending inside an instruction");
+        check(rejects({ vertex.begin(), vertex.begin() + 4 }, "invalid SPIR-V header"), "truncated header");
+
+        // Ids referenced by a valid instruction have to name an instruction of the expected kind
+        {
+            SpirvBuilder b;
+            const CommonTypes t = declareCommonTypes(b);
+            const uint32_t buffer = b.variable(t.uintType, SpirvBuilder::Uniform);
+            b.decorate(buffer, SpirvBuilder::DescriptorSet, { 0 });
+            b.decorate(buffer, SpirvBuilder::Binding, { 0 });
+            const uint32_t main = b.id();
+            b.entryPoint(SpirvBuilder::GLCompute, main, "main", {});
+            b.emptyFunction(main, t.voidType, t.functionType);
+            check(rejects(b.build(), "expected instruction"), "variable type that is not a pointer");
+        }
+        {
+            SpirvBuilder b;
+            const CommonTypes t = declareCommonTypes(b);
+            const uint32_t array = b.typeArray(t.floatType, 1000);
+            const uint32_t block = b.typeStruct({ array });
+            b.decorate(block, SpirvBuilder::Block);
+            b.memberDecorate(block, 0, SpirvBuilder::Offset, { 0 });
+            const uint32_t buffer = b.variable(b.typePointer(SpirvBuilder::Uniform, block), SpirvBuilder::Uniform);
+            b.decorate(buffer, SpirvBuilder::DescriptorSet, { 0 });
+            b.decorate(buffer, SpirvBuilder::Binding, { 0 });
+            const uint32_t main = b.id();
+            b.entryPoint(SpirvBuilder::GLCompute, main, "main", {});
+            b.emptyFunction(main, t.voidType, t.functionType);
+            check(rejects(b.build(), "id out of bounds"), "array length id out of bounds");
+        }
+
+        return failures;
+    }
+}
+
+int main(const int argc, const char** argv)
+{
+    std::vector<TestModule> modules = {
+        buildVertexModule(),
+        buildFragmentModule(),
+        buildComputeModule(),
+        buildRayGenModule(),
+        buildMultiEntryModule(0x00010300),
+        buildMultiEntryModule(0x00010500),
+    };
+
+    int failures = checkExpectations() + checkMalformedModules(modules);
+
+    // Additional SPIR-V files can be passed on the command line
+    std::vector<std::string> files(argv + 1, argv + argc);
+
+    try
+    {
+        for (const auto& module : modules)
+        {
+            const auto code     = nbl::ShaderCode::fromView(module.words);
+            const auto expected = nbl::ShaderReflection::reflectModule(code, module.name, nbl::ReflectionBackend::eSpirvReflect);
+            const auto actual   = nbl::ShaderReflection::reflectModule(code, module.name, nbl::ReflectionBackend::eFastScan);
+            if (expected.size() != actual.size())
+            {
+                std::cout << "\t-[" << module.name << " | Mismatch: entry point count]" << std::endl;
+                ++failures;
+                continue;
+            }
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                failures += compare(module.name + ":" + expected[i].entryPoint, expected[i], actual[i]);
+            }
+        }
+
+        for (const auto& file : files)
+        {
+            const auto expected = nbl::ShaderReflection::reflectShader(file, nbl::ReflectionBackend::eSpirvReflect);
+            const auto actual   = nbl::ShaderReflection::reflectShader(file, nbl::ReflectionBackend::eFastScan);
+            failures += compare(file, expected, actual);
+        }
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cout << err.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "[Fast Scan | Modules: " << modules.size() + files.size() << " | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+#include <iostream>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <reflect/FlatReflectionDatabase.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+using nbl::FlatReflectionDatabase;
+
+namespace
+{
+    /**
+     * @note Tracks the bytes the database's arena holds from its upstream resource.
+     */
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        size_t allocated   = 0;
+        size_t allocations = 0;
+
+    private:
+        auto do_allocate(const size_t bytes, const size_t alignment) -> void* override
+        {
+            allocated += bytes;
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, const size_t bytes, const size_t alignment) override
+        {
+            allocated -= bytes;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override { return this == &other; }
+    };
+
+    auto buildVertexShader(const nbl::ShaderCode& shaderCode) -> nbl::ShaderReflectionData
+    {
+        nbl::ShaderReflectionData shaderData;
+        shaderData.shaderName     = "mesh";
+        shaderData.sourceFile     = "shaders/mesh.vert.spv";
+        shaderData.entryPoint     = "main";
+        shaderData.shaderStage    = vk::ShaderStageFlagBits::eVertex;
+        shaderData.shaderCode     = shaderCode;
+        shaderData.descriptorSets = { { 0, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eVertex) } } };
+        shaderData.pushConstants  = { vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0, 64) };
+
+        auto& vertexInput = shaderData.vertexInput.emplace();
+        vertexInput.attributeDescriptions = {
+            vk::VertexInputAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat),
+            vk::VertexInputAttributeDescription(1, 0, vk::Format::eR32G32Sfloat),
+        };
+        vertexInput.attributeNames = { "inPosition", "inUV" };
+        vertexInput.applyLayout(nbl::VertexInputLayout::eInterleaved);
+
+        // Array of structs holding an array of matrices, two levels of nesting and array dimensions
+        nbl::ShaderReflectionBlockMember bone { .name = "bones", .offset = 64, .size = 1024, .arrayStride = 256, .arrayDims = { 2, 2 } };
+        bone.members = {
+            { .name = "transforms", .offset = 64, .size = 192, .arrayStride = 64, .matrixStride = 16, .arrayDims = { 3 } },
+            { .name = "weight", .offset = 256, .size = 4 },
+        };
+        shaderData.blocks = { {
+            .type     = nbl::ShaderBlockType::eUniformBuffer,
+            .name     = "camera",
+            .typeName = "Camera",
+            .set      = 0,
+            .binding  = 0,
+            .size     = 1088,
+            .members  = { { .name = "viewProjection", .offset = 0, .size = 64, .matrixStride = 16, .rowMajor = true }, bone },
+        } };
+        shaderData.specConstants = { { .constantId = 3, .name = "kSkinned", .type = nbl::SpecializationConstantType::eBool, .width = 32, .defaultValue = 1 } };
+        return shaderData;
+    }
+
+    auto buildFragmentShader(const nbl::ShaderCode& shaderCode, const uint32_t textures) -> nbl::ShaderReflectionData
+    {
+        nbl::ShaderReflectionData shaderData;
+        shaderData.shaderName     = "mesh";
+        shaderData.sourceFile     = "shaders/mesh.frag.spv";
+        shaderData.entryPoint     = "main";
+        shaderData.shaderStage    = vk::ShaderStageFlagBits::eFragment;
+        shaderData.shaderCode     = shaderCode;
+        shaderData.descriptorSets = { { 1, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eCombinedImageSampler, textures, vk::ShaderStageFlagBits::eFragment) } } };
+        return shaderData;
+    }
+
+    auto buildComputeShader() -> nbl::ShaderReflectionData
+    {
+        nbl::ShaderReflectionData shaderData;
+        shaderData.shaderName  = "cull";
+        shaderData.entryPoint  = "main";
+        shaderData.shaderStage = vk::ShaderStageFlagBits::eCompute;
+        shaderData.workgroup   = nbl::ShaderReflectionWorkgroup {
+            .localSize            = { 64, 1, 1 },
+            .localSizeConstantIds = { 0, ~0u, ~0u },
+            .sharedVariables      = { { .name = "visible", .size = 256, .lengthConstantId = 0, .elementSize = 4 } },
+            .sharedMemorySize     = 256,
+        };
+        return shaderData;
+    }
+
+    auto equal(const nbl::ShaderReflectionData& a, const nbl::ShaderReflectionData& b) -> bool
+    {
+        const auto sets = [](const nbl::ShaderReflectionData& data) {
+            std::vector<std::pair<uint32_t, std::vector<vk::DescriptorSetLayoutBinding>>> result;
+            for (const auto& descriptorSet : data.descriptorSets)
+            {
+                result.emplace_back(descriptorSet.set, descriptorSet.bindings);
+            }
+            return result;
+        };
+        const auto vertexInput = [](const nbl::ShaderReflectionData& lhs, const nbl::ShaderReflectionData& rhs) {
+            return lhs.vertexInput.has_value() == rhs.vertexInput.has_value()
+                && (!lhs.vertexInput.has_value()
+                    || (lhs.vertexInput->attributeDescriptions == rhs.vertexInput->attributeDescriptions
+                        && lhs.vertexInput->bindingDescriptions == rhs.vertexInput->bindingDescriptions
+                        && lhs.vertexInput->attributeNames == rhs.vertexInput->attributeNames));
+        };
+        return a.shaderName == b.shaderName && a.sourceFile == b.sourceFile && a.entryPoint == b.entryPoint && a.shaderStage == b.shaderStage
+            && a.shaderCode.data() == b.shaderCode.data() && sets(a) == sets(b) && a.pushConstants == b.pushConstants && vertexInput(a, b)
+            && a.blocks == b.blocks && a.specConstants == b.specConstants && a.workgroup == b.workgroup;
+    }
+
+    template <typename Handle>
+    auto rejects(const FlatReflectionDatabase& database, const Handle handle) -> bool
+    {
+        try
+        {
+            if constexpr (std::is_same_v<Handle, nbl::FlatShaderHandle>)
+            {
+                database.getShader(handle);
+            }
+            else
+            {
+                database.getPipeline(handle);
+            }
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    auto roundTrip() -> int
+    {
+        const auto vertexCode   = nbl::ShaderCode::fromWords({ 0x07230203, 0x00010500, 0, 1, 0 });
+        const auto fragmentCode = nbl::ShaderCode::fromWords({ 0x07230203, 0x00010500, 0, 2, 0 });
+
+        nbl::PipelineReflectionData pipeline = nbl::ShaderReflection::mergePipelineShaders({ buildVertexShader(vertexCode), buildFragmentShader(fragmentCode, 4) });
+        pipeline.conflicts = { { .set = 1, .binding = 0, .message = "Binding #0 of set #1 is declared with different types" } };
+
+        FlatReflectionDatabase database;
+        const auto handle = database.addPipeline(pipeline);
+        const auto restored = database.toPipelineReflectionData(handle);
+
+        int failures = check(restored.shaderData.size() == 2, "shader count");
+        for (size_t i = 0; i < restored.shaderData.size() && i < pipeline.shaderData.size(); ++i)
+        {
+            failures += check(equal(restored.shaderData[i], pipeline.shaderData[i]), "shader #" + std::to_string(i) + " round trip");
+        }
+        failures += check(restored.descriptorSets.size() == 2 && restored.descriptorSets[1].set == 1
+                          && restored.descriptorSets[1].bindings == pipeline.descriptorSets[1].bindings, "merged descriptor sets");
+        failures += check(restored.pushConstants == pipeline.pushConstants, "merged push constants");
+        failures += check(restored.conflicts.size() == 1 && restored.conflicts[0].message == pipeline.conflicts[0].message, "conflicts");
+
+        // The flat views of the nested members
+        const auto shader = database.getShaders(handle)[0];
+        const auto blocks = database.getBlocks(shader);
+        const auto members = blocks.empty() ? std::span<const nbl::FlatBlockMember>() : database.getMembers(blocks[0]);
+        failures += check(members.size() == 2 && database.getString(members[1].name) == "bones", "block members");
+        if (members.size() == 2)
+        {
+            const auto dims = database.getArrayDims(members[1]);
+            const auto children = database.getMembers(members[1]);
+            failures += check(dims.size() == 2 && dims[0] == 2 && dims[1] == 2, "array dimensions");
+            failures += check(children.size() == 2 && database.getArrayDims(children[0]).size() == 1 && children[1].offset == 256, "nested members");
+        }
+
+        const auto compute = database.addShader(buildComputeShader());
+        failures += check(equal(database.toShaderReflectionData(compute), buildComputeShader()), "workgroup round trip");
+        failures += check(database.getWorkgroup(shader) == nullptr, "no workgroup for vertex shaders");
+
+        return failures;
+    }
+
+    auto sharedShaders() -> int
+    {
+        const auto vertexCode   = nbl::ShaderCode::fromWords({ 0x07230203, 0x00010500, 0, 1, 0 });
+        const auto fragmentCode = nbl::ShaderCode::fromWords({ 0x07230203, 0x00010500, 0, 2, 0 });
+        const auto vertex = buildVertexShader(vertexCode);
+
+        FlatReflectionDatabase database;
+        const auto opaque      = database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ vertex, buildFragmentShader(fragmentCode, 4) }));
+        const auto transparent = database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ vertex, buildFragmentShader(fragmentCode, 4) }));
+        int failures = check(database.getShaderCount() == 2, "identical stages added once");
+        failures += check(database.getShaders(opaque)[0] == database.getShaders(transparent)[0]
+                          && database.getShaders(opaque)[1] == database.getShaders(transparent)[1], "identical stages share their handles");
+
+        // Same code, different reflection data
+        const auto moreTextures = database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ vertex, buildFragmentShader(fragmentCode, 8) }));
+        failures += check(database.getShaderCount() == 3 && database.getShaders(moreTextures)[0] == database.getShaders(opaque)[0], "different descriptor count added");
+
+        auto perAttribute = vertex;
+        perAttribute.vertexInput->applyLayout(nbl::VertexInputLayout::eBindingPerAttribute);
+        const auto split = database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ perAttribute }));
+        failures += check(database.getShaderCount() == 4 && database.getShaders(split)[0] != database.getShaders(opaque)[0], "different vertex layout added");
+
+        auto nested = vertex;
+        nested.blocks[0].members[1].members[0].arrayDims = { 4 };
+        database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ nested }));
+        failures += check(database.getShaderCount() == 5, "different nested array dimensions added");
+
+        // Identical contents in separately loaded code
+        const auto reloaded = buildVertexShader(nbl::ShaderCode::fromWords({ 0x07230203, 0x00010500, 0, 1, 0 }));
+        database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ reloaded }));
+        failures += check(database.getShaderCount() == 6, "separately loaded code added");
+
+        // Shaders without code are never shared
+        database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ buildComputeShader() }));
+        database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ buildComputeShader() }));
+        failures += check(database.getShaderCount() == 8, "shaders without code added");
+
+        return failures;
+    }
+
+    auto memory() -> int
+    {
+        const auto vertexCode   = nbl::ShaderCode::fromWords({ 0x07230203, 0x00010500, 0, 1, 0 });
+        const auto fragmentCode = nbl::ShaderCode::fromWords({ 0x07230203, 0x00010500, 0, 2, 0 });
+
+        std::vector<nbl::PipelineReflectionData> pipelines;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            auto vertex = buildVertexShader(nbl::ShaderCode::fromWords({ 0x07230203, 0x00010500, 0, i, 0 }));
+            vertex.shaderName += std::to_string(i);
+            pipelines.push_back(nbl::ShaderReflection::mergePipelineShaders({ std::move(vertex), buildFragmentShader(fragmentCode, i + 1) }));
+        }
+
+        CountingResource upstream;
+        FlatReflectionDatabase database(&upstream);
+
+        // Reserved arrays keep their storage, views into them stay valid while records are added
+        database.reserve(pipelines);
+        const auto first = database.addPipeline(pipelines[0]);
+        const auto* bindings = database.getAllBindings().data();
+        const auto name = database.getShaderName(database.getShaders(first)[0]);
+        for (size_t i = 1; i < pipelines.size(); ++i)
+        {
+            database.addPipeline(pipelines[i]);
+        }
+        int failures = check(database.getAllBindings().data() == bindings, "reserved bindings not reallocated");
+        failures += check(database.getShaderName(database.getShaders(first)[0]).data() == name.data() && name == "mesh0", "reserved strings not reallocated");
+        failures += check(database.getPipelineCount() == pipelines.size() && database.getShaderCount() == 2 * pipelines.size(), "all records added");
+        failures += check(upstream.allocated > 0, "arena allocated from the upstream resource");
+
+        database.clear();
+        failures += check(upstream.allocated == 0, "clear returns all memory to the upstream resource");
+        failures += check(database.getPipelineCount() == 0 && database.getShaderCount() == 0, "clear removes all records");
+        failures += check(rejects(database, first) && rejects(database, nbl::FlatShaderHandle { 0 }), "clear invalidates handles");
+        failures += check(database.getAllBindings().empty(), "clear removes all bindings");
+
+        // Usable again after clearing, identical shaders added before are not found anymore
+        const auto again = database.addPipeline(nbl::ShaderReflection::mergePipelineShaders({ buildVertexShader(vertexCode) }));
+        failures += check(again.index == 0 && database.getShaderCount() == 1 && database.getShaderName(database.getShaders(again)[0]) == "mesh", "records added after clear");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    try
+    {
+        failures = roundTrip() + sharedShaders() + memory();
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::cout << "[Flat Reflection Database | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <MeshReflection.hpp>
+#include "TestCheck.hpp"
+
+using nbl::test::check;
+
+/**
+ * @note MeshReflection.hpp is generated by nbl_reflect_generate from the modules written by nblReflectWriteTestShaders,
+ * most of the checks happen at compile time.
+ */
+namespace
+{
+    constexpr const auto& kMesh = nbl::test::generated::Mesh::pipeline;
+    constexpr const auto& kFullscreen = nbl::test::generated::Fullscreen_Pass::pipeline;
+    constexpr const auto& kEntryPoints = nbl::test::generated::Mesh_Entry_Points::pipeline;
+
+    static_assert(kMesh.stages.size() == 2);
+    static_assert(kMesh.hasBinding(0, 0, vk::DescriptorType::eUniformBuffer));
+    static_assert(kMesh.hasBinding(1, 0, vk::DescriptorType::eCombinedImageSampler));
+    static_assert(!kMesh.hasBinding(1, 0, vk::DescriptorType::eSampledImage));
+    static_assert(!kMesh.hasBinding(0, 1, vk::DescriptorType::eUniformBuffer));
+    static_assert(kMesh.findBinding(0, 0)->stageFlags == vk::ShaderStageFlags(vk::ShaderStageFlagBits::eVertex));
+    static_assert(kMesh.hasVertexAttribute(0, vk::Format::eR32G32B32Sfloat));
+    static_assert(kMesh.hasVertexAttribute(1, vk::Format::eR32G32Sfloat));
+    static_assert(kMesh.vertexBindings.size() == 1 && kMesh.vertexBindings[0].stride == 20);
+    static_assert(kMesh.pushConstants.size() == 1 && kMesh.pushConstants[0].size == 16);
+
+    static_assert(kFullscreen.stages.size() == 1 && kFullscreen.descriptorSets.size() == 1);
+    static_assert(kFullscreen.pushConstants.empty() && kFullscreen.vertexAttributes.empty());
+
+    // Both stages from one module, selected by entry point
+    static_assert(kEntryPoints.stages.size() == 2);
+    static_assert(kEntryPoints.stages[0].stage == vk::ShaderStageFlagBits::eVertex && kEntryPoints.stages[1].stage == vk::ShaderStageFlagBits::eFragment);
+    static_assert(kEntryPoints.findBinding(0, 0)->stageFlags == vk::ShaderStageFlags(vk::ShaderStageFlagBits::eVertex));
+    static_assert(kEntryPoints.findBinding(1, 0)->stageFlags == vk::ShaderStageFlags(vk::ShaderStageFlagBits::eFragment));
+    static_assert(kEntryPoints.hasVertexAttribute(0, vk::Format::eR32G32B32Sfloat) && kEntryPoints.pushConstants.empty());
+}
+
+int main()
+{
+    // The code is embedded, the stage create infos are usable without the source files
+    int failures = 0;
+    for (const auto& stage : kMesh.stages)
+    {
+        failures += check(!stage.code.empty() && stage.code[0] == 0x07230203u, std::string("embedded code of ") + stage.sourceFile);
+        failures += check(stage.getShaderModuleCreateInfo().codeSize == stage.code.size_bytes(), "module create info");
+    }
+    failures += check(std::string_view(kEntryPoints.stages[0].entryPoint) == "vsMain" && std::string_view(kEntryPoints.stages[1].entryPoint) == "fsMain",
+                      "entry point names");
+    failures += check(kEntryPoints.stages[0].code.data() == kEntryPoints.stages[1].code.data(), "entry points share the embedded code");
+
+    std::cout << "[Generated Header | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
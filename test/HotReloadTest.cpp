@@ -0,0 +1,299 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <reflect/ShaderReflectionCache.hpp>
+#include <reflect/ShaderReflectionDatabase.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+using nbl::ReflectionChangeFlags;
+
+namespace
+{
+    struct ShaderVariant
+    {
+        uint32_t model              = SpirvBuilder::Vertex;
+        uint32_t vertexInputs       = 2;
+        uint32_t bindings           = 1;
+        uint32_t pushConstantSize   = 16;
+        // Unused constant, changes the code without changing the interface
+        uint32_t revision           = 0;
+    };
+
+    auto buildShader(const ShaderVariant& variant) -> std::vector<uint32_t>
+    {
+        SpirvBuilder b;
+        b.capability(1);
+        b.memoryModel(0, 1);
+
+        const uint32_t voidType     = b.typeVoid();
+        const uint32_t functionType = b.typeFunction(voidType);
+        const uint32_t uintType     = b.typeInt(32, 0);
+        const uint32_t floatType    = b.typeFloat(32);
+        const uint32_t vec4         = b.typeVector(floatType, 4);
+        b.constant(uintType, variant.revision);
+
+        std::vector<uint32_t> interface;
+        if (variant.model == SpirvBuilder::Vertex)
+        {
+            for (uint32_t location = 0; location < variant.vertexInputs; ++location)
+            {
+                const uint32_t input = b.variable(b.typePointer(SpirvBuilder::Input, vec4), SpirvBuilder::Input);
+                b.decorate(input, SpirvBuilder::Location, { location });
+                interface.push_back(input);
+            }
+        }
+
+        const uint32_t block = b.typeStruct({ vec4 });
+        b.decorate(block, SpirvBuilder::Block);
+        b.memberDecorate(block, 0, SpirvBuilder::Offset, { 0 });
+        for (uint32_t binding = 0; binding < variant.bindings; ++binding)
+        {
+            const uint32_t buffer = b.variable(b.typePointer(SpirvBuilder::Uniform, block), SpirvBuilder::Uniform);
+            b.decorate(buffer, SpirvBuilder::DescriptorSet, { 0 });
+            b.decorate(buffer, SpirvBuilder::Binding, { binding });
+        }
+
+        const uint32_t pushBlock = b.typeStruct(std::vector<uint32_t>(variant.pushConstantSize / 16, vec4));
+        b.decorate(pushBlock, SpirvBuilder::Block);
+        for (uint32_t member = 0; member < variant.pushConstantSize / 16; ++member)
+        {
+            b.memberDecorate(pushBlock, member, SpirvBuilder::Offset, { member * 16 });
+        }
+        b.variable(b.typePointer(SpirvBuilder::PushConstant, pushBlock), SpirvBuilder::PushConstant);
+
+        const uint32_t main = b.id();
+        b.entryPoint(variant.model, main, "main", interface);
+        b.emptyFunction(main, voidType, functionType);
+        return b.build();
+    }
+
+    /**
+     * @note Two entry points sharing a vertex and push constant layout, the fragment entry point additionally uses set 1.
+     */
+    auto buildMultiEntryShader(const uint32_t fragmentBindings) -> std::vector<uint32_t>
+    {
+        SpirvBuilder b;
+        b.capability(1);
+        b.memoryModel(0, 1);
+
+        const uint32_t voidType     = b.typeVoid();
+        const uint32_t functionType = b.typeFunction(voidType);
+        const uint32_t floatType    = b.typeFloat(32);
+        const uint32_t vec4         = b.typeVector(floatType, 4);
+
+        const uint32_t position = b.variable(b.typePointer(SpirvBuilder::Input, vec4), SpirvBuilder::Input);
+        b.decorate(position, SpirvBuilder::Location, { 0 });
+
+        const uint32_t block = b.typeStruct({ vec4 });
+        b.decorate(block, SpirvBuilder::Block);
+        b.memberDecorate(block, 0, SpirvBuilder::Offset, { 0 });
+        const uint32_t camera = b.variable(b.typePointer(SpirvBuilder::Uniform, block), SpirvBuilder::Uniform);
+        b.decorate(camera, SpirvBuilder::DescriptorSet, { 0 });
+        b.decorate(camera, SpirvBuilder::Binding, { 0 });
+
+        std::vector<uint32_t> fragmentInterface;
+        for (uint32_t binding = 0; binding < fragmentBindings; ++binding)
+        {
+            const uint32_t buffer = b.variable(b.typePointer(SpirvBuilder::Uniform, block), SpirvBuilder::Uniform);
+            b.decorate(buffer, SpirvBuilder::DescriptorSet, { 1 });
+            b.decorate(buffer, SpirvBuilder::Binding, { binding });
+            fragmentInterface.push_back(buffer);
+        }
+
+        const uint32_t vertexMain   = b.id();
+        const uint32_t fragmentMain = b.id();
+        b.entryPoint(SpirvBuilder::Vertex, vertexMain, "vsMain", { position, camera });
+        b.entryPoint(SpirvBuilder::Fragment, fragmentMain, "fsMain", fragmentInterface);
+        b.emptyFunction(vertexMain, voidType, functionType);
+        b.emptyFunction(fragmentMain, voidType, functionType);
+        return b.build();
+    }
+
+    /**
+     * @note The modification time is moved forward explicitly, so the polling fallback sees rewrites within the clock resolution.
+     */
+    void writeFile(const std::filesystem::path& path, const std::vector<uint32_t>& words)
+    {
+        static int s_revision = 0;
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+        }
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() + std::chrono::seconds(++s_revision));
+    }
+
+    auto shaderChanges(const nbl::ReflectionDatabaseUpdate& update, const std::string& entryPoint) -> ReflectionChangeFlags
+    {
+        for (const auto& change : update.shaders)
+        {
+            if (change.entryPoint == entryPoint)
+            {
+                return change.changes;
+            }
+        }
+        return ReflectionChangeFlags::eNone;
+    }
+
+    auto pipelineChanges(const nbl::ReflectionDatabaseUpdate& update, const nbl::PipelineId pipeline) -> ReflectionChangeFlags
+    {
+        for (const auto& change : update.pipelines)
+        {
+            if (change.pipeline == pipeline)
+            {
+                return change.changes;
+            }
+        }
+        return ReflectionChangeFlags::eNone;
+    }
+
+    auto hotReload(const std::filesystem::path& directory) -> int
+    {
+        const auto vertPath = directory / "mesh.vert.spv";
+        const auto fragPath = directory / "mesh.frag.spv";
+        const auto compPath = directory / "cull.comp.spv";
+
+        ShaderVariant vert { .model = SpirvBuilder::Vertex };
+        ShaderVariant frag { .model = SpirvBuilder::Fragment };
+        ShaderVariant comp { .model = SpirvBuilder::GLCompute };
+        writeFile(vertPath, buildShader(vert));
+        writeFile(fragPath, buildShader(frag));
+        writeFile(compPath, buildShader(comp));
+
+        nbl::ShaderReflectionDatabase database(nbl::ReflectionBackend::eFastScan);
+        const auto meshPipeline = database.addPipeline({ vertPath.string(), fragPath.string() });
+        const auto cullPipeline = database.addPipeline({ compPath.string() });
+        const auto fullscreen   = database.addPipeline({ vertPath.string() });
+
+        int failures = check(database.poll().empty(), "no changes after loading");
+
+        // Identical contents
+        writeFile(fragPath, buildShader(frag));
+        failures += check(database.poll().empty(), "identical rewrite ignored");
+
+        // Code only
+        frag.revision = 1;
+        writeFile(fragPath, buildShader(frag));
+        auto update = database.poll();
+        failures += check(update.shaders.size() == 1 && update.shaders[0].changes == ReflectionChangeFlags::eCode, "fragment code change");
+        failures += check(update.pipelines.size() == 1 && pipelineChanges(update, meshPipeline) == ReflectionChangeFlags::eCode, "only the mesh pipeline is merged again");
+
+        // Descriptor layout
+        frag.bindings = 2;
+        writeFile(fragPath, buildShader(frag));
+        update = database.poll();
+        failures += check(pipelineChanges(update, meshPipeline) == (ReflectionChangeFlags::eCode | ReflectionChangeFlags::eDescriptorLayout | ReflectionChangeFlags::eBlockLayout), "descriptor layout change");
+        failures += check(database.getPipeline(meshPipeline).descriptorSets.at(0).bindings.size() == 2, "merged layout updated");
+
+        // Vertex input, shared by two pipelines
+        vert.vertexInputs = 3;
+        writeFile(vertPath, buildShader(vert));
+        update = database.poll();
+        failures += check(update.pipelines.size() == 2, "both pipelines using the vertex shader are merged again");
+        failures += check(hasChange(pipelineChanges(update, meshPipeline), ReflectionChangeFlags::eVertexInput), "vertex input change");
+        failures += check(!hasChange(pipelineChanges(update, fullscreen), ReflectionChangeFlags::eDescriptorLayout), "unchanged merged layout not reported");
+
+        // Push constants
+        comp.pushConstantSize = 64;
+        writeFile(compPath, buildShader(comp));
+        update = database.poll();
+        failures += check(pipelineChanges(update, cullPipeline) == (ReflectionChangeFlags::eCode | ReflectionChangeFlags::ePushConstants | ReflectionChangeFlags::eBlockLayout), "push constant change");
+
+        // A broken file keeps the previous data and is retried
+        {
+            std::ofstream file(compPath, std::ios::binary | std::ios::trunc);
+            file << "not spir-v";
+        }
+        std::filesystem::last_write_time(compPath, std::filesystem::file_time_type::clock::now() + std::chrono::hours(1));
+        update = database.poll();
+        failures += check(update.errors.size() == 1 && update.pipelines.empty(), "broken file reported");
+        failures += check(database.getPipeline(cullPipeline).pushConstants.at(0).size == 64, "previous data kept");
+
+        comp.pushConstantSize = 32;
+        writeFile(compPath, buildShader(comp));
+        std::filesystem::last_write_time(compPath, std::filesystem::file_time_type::clock::now() + std::chrono::hours(2));
+        update = database.poll();
+        failures += check(update.errors.empty() && pipelineChanges(update, cullPipeline) != ReflectionChangeFlags::eNone, "fixed file reloaded");
+
+        std::cout << "[Hot Reload | inotify: " << (database.isUsingInotify() ? "yes" : "no")
+                  << " | Pipelines: " << database.getPipelineCount() << "]" << std::endl;
+        return failures;
+    }
+
+    auto entryPoints(const std::filesystem::path& directory) -> int
+    {
+        const std::string path = (directory / "material.spv").string();
+        writeFile(path, buildMultiEntryShader(1));
+
+        nbl::ShaderReflectionDatabase database(nbl::ReflectionBackend::eFastScan);
+        const auto material = database.addPipeline(std::vector<nbl::ShaderStageSource> { { .filePath = path, .entryPoint = "vsMain" }, { .filePath = path, .entryPoint = "fsMain" } });
+        const auto fragment = database.addPipeline(std::vector<nbl::ShaderStageSource> { { .filePath = path, .entryPoint = "fsMain" } });
+
+        int failures = check(database.getPipeline(material).shaderData.size() == 2 && database.getPipeline(material).descriptorSets.size() == 2, "both entry points merged");
+        failures += check(database.getShader(path, "fsMain").shaderStage == vk::ShaderStageFlagBits::eFragment, "fragment entry point");
+        failures += check(database.getPipeline(fragment).descriptorSets.size() == 1 && database.getPipeline(fragment).descriptorSets[0].set == 1, "fragment entry point alone");
+
+        bool threw = false;
+        try
+        {
+            database.getShader(path);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        failures += check(threw, "unused first entry point rejected");
+
+        // Only the fragment entry point's interface changes
+        writeFile(path, buildMultiEntryShader(2));
+        const auto update = database.poll();
+        failures += check(update.shaders.size() == 2, "one change per used entry point");
+        failures += check(shaderChanges(update, "vsMain") == ReflectionChangeFlags::eCode, "vertex entry point code only");
+        failures += check(hasChange(shaderChanges(update, "fsMain"), ReflectionChangeFlags::eDescriptorLayout), "fragment entry point descriptor layout");
+        failures += check(hasChange(pipelineChanges(update, fragment), ReflectionChangeFlags::eDescriptorLayout)
+                          && hasChange(pipelineChanges(update, material), ReflectionChangeFlags::eDescriptorLayout), "both pipelines merged again");
+        failures += check(database.getShader(path, "fsMain").descriptorSets.at(0).bindings.size() == 2, "fragment entry point updated");
+
+        // A later pipeline using the first entry point by its empty name
+        const auto vertex = database.addPipeline({ path });
+        failures += check(database.getPipeline(vertex).shaderData.at(0).entryPoint == "vsMain" && database.getShader(path).entryPoint == "vsMain", "first entry point added later");
+        failures += check(database.poll().empty(), "no changes after adding an entry point");
+
+        // Databases sharing a cache reflect the module once
+        nbl::ShaderReflectionCache cache;
+        for (int i = 0; i < 2; ++i)
+        {
+            nbl::ShaderReflectionDatabase cached(nbl::ReflectionBackend::eFastScan, &cache);
+            const auto pipeline = cached.addPipeline(std::vector<nbl::ShaderStageSource> { { .filePath = path, .entryPoint = "vsMain" }, { .filePath = path, .entryPoint = "fsMain" } });
+            failures += check(cached.getPipeline(pipeline).descriptorSets.size() == 2, "cached entry points merged");
+        }
+        failures += check(cache.getMissCount() == 1 && cache.getHitCount() == 2, "database entry points cached");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    const auto directory = std::filesystem::temp_directory_path() / "nblReflectHotReloadTest";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    int failures = 0;
+    try
+    {
+        failures = hotReload(directory) + entryPoints(directory);
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::filesystem::remove_all(directory);
+    std::cout << "[Hot Reload | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
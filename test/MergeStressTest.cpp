@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <reflect/ShaderReflection.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+namespace
+{
+    constexpr uint32_t kStages          = 64;
+    constexpr uint32_t kSets            = 4;
+    constexpr uint32_t kBindingsPerSet  = 4096;
+
+    constexpr vk::ShaderStageFlagBits kStageBits[] = {
+        vk::ShaderStageFlagBits::eVertex,
+        vk::ShaderStageFlagBits::eFragment,
+        vk::ShaderStageFlagBits::eCompute,
+        vk::ShaderStageFlagBits::eRaygenKHR,
+        vk::ShaderStageFlagBits::eClosestHitKHR,
+        vk::ShaderStageFlagBits::eMissKHR,
+    };
+
+    auto typeOf(const uint32_t set, const uint32_t binding) -> vk::DescriptorType
+    {
+        return (set + binding) % 3 == 0 ? vk::DescriptorType::eStorageBuffer : vk::DescriptorType::eCombinedImageSampler;
+    }
+
+    /**
+     * @note Every stage declares a random subset of a bindless-sized table in random order, the merged
+     * stage flags of each binding are compared against the expected union.
+     */
+    auto stressDescriptorMerge() -> int
+    {
+        std::mt19937 rng(1234);
+        std::bernoulli_distribution declares(0.3);
+
+        std::vector<vk::ShaderStageFlags> expected(kSets * kBindingsPerSet);
+        std::vector<nbl::ShaderReflectionData> stages(kStages);
+        for (uint32_t s = 0; s < kStages; ++s)
+        {
+            auto& stage = stages[s];
+            stage.shaderName  = "stage" + std::to_string(s);
+            stage.shaderStage = kStageBits[s % std::size(kStageBits)];
+
+            for (uint32_t set = 0; set < kSets; ++set)
+            {
+                nbl::ShaderReflectionDescriptorSet descriptorSet { .set = set };
+                for (uint32_t binding = 0; binding < kBindingsPerSet; ++binding)
+                {
+                    if (!declares(rng))
+                    {
+                        continue;
+                    }
+                    descriptorSet.bindings.push_back(vk::DescriptorSetLayoutBinding()
+                        .setBinding(binding)
+                        .setDescriptorType(typeOf(set, binding))
+                        .setDescriptorCount(1)
+                        .setStageFlags(stage.shaderStage));
+                    expected[set * kBindingsPerSet + binding] |= stage.shaderStage;
+                }
+                std::ranges::shuffle(descriptorSet.bindings, rng);
+                stage.descriptorSets.push_back(std::move(descriptorSet));
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto merged = nbl::ShaderReflection::mergePipelineShaders(std::move(stages));
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        int failures = check(merged.conflicts.empty(), "no conflicts");
+        failures += check(merged.descriptorSets.size() == kSets, "set count");
+
+        size_t nMerged = 0;
+        for (const auto& descriptorSet : merged.descriptorSets)
+        {
+            for (size_t i = 0; i < descriptorSet.bindings.size(); ++i)
+            {
+                const auto& binding = descriptorSet.bindings[i];
+                if (i > 0 && descriptorSet.bindings[i - 1].binding >= binding.binding)
+                {
+                    return failures + check(false, "bindings sorted by number");
+                }
+                if (binding.stageFlags != expected[descriptorSet.set * kBindingsPerSet + binding.binding])
+                {
+                    return failures + check(false, "stage flags of set #" + std::to_string(descriptorSet.set) + " binding #" + std::to_string(binding.binding));
+                }
+                ++nMerged;
+            }
+        }
+
+        std::cout << "[Merge Stress | Stages: " << kStages
+                  << " | Bindings: " << nMerged
+                  << " | Time: " << elapsed.count() << "ms]" << std::endl;
+        return failures;
+    }
+
+    auto conflictsAndPushConstants() -> int
+    {
+        std::vector<nbl::ShaderReflectionData> stages(3);
+        stages[0].shaderName = "vertex";
+        stages[0].descriptorSets = { { 0, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eVertex),
+                                            vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eCombinedImageSampler, 4, vk::ShaderStageFlagBits::eVertex) } } };
+        stages[0].pushConstants  = { vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex, 0, 64) };
+
+        stages[1].shaderName = "fragment";
+        stages[1].descriptorSets = { { 0, { vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eCombinedImageSampler, 8, vk::ShaderStageFlagBits::eFragment),
+                                            vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eFragment) } } };
+        stages[1].pushConstants  = { vk::PushConstantRange(vk::ShaderStageFlagBits::eFragment, 48, 32) };
+
+        stages[2].shaderName = "geometry";
+        stages[2].pushConstants  = { vk::PushConstantRange(vk::ShaderStageFlagBits::eGeometry, 128, 16) };
+
+        const auto merged = nbl::ShaderReflection::mergePipelineShaders(std::move(stages));
+
+        int failures = check(merged.conflicts.size() == 2, "type and count conflicts reported");
+        failures += check(merged.descriptorSets.size() == 1 && merged.descriptorSets[0].bindings.size() == 2, "merged bindings");
+        if (failures == 0)
+        {
+            const auto& bindings = merged.descriptorSets[0].bindings;
+            failures += check(bindings[0].descriptorType == vk::DescriptorType::eUniformBuffer, "first declaration kept");
+            failures += check(bindings[1].descriptorCount == 8, "largest count kept");
+            failures += check(bindings[1].stageFlags == (vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment), "stage flags by binding number");
+        }
+
+        failures += check(merged.pushConstants.size() == 2, "overlapping push constants coalesced");
+        if (merged.pushConstants.size() == 2)
+        {
+            failures += check(merged.pushConstants[0].offset == 0 && merged.pushConstants[0].size == 80, "coalesced range");
+            failures += check(merged.pushConstants[0].stageFlags == (vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment), "coalesced stages");
+            failures += check(merged.pushConstants[1].offset == 128 && merged.pushConstants[1].size == 16, "disjoint range kept");
+        }
+
+        return failures;
+    }
+}
+
+int main()
+{
+    const int failures = conflictsAndPushConstants() + stressDescriptorMerge();
+    std::cout << "[Merge | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
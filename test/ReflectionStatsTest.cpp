@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <reflect/ReflectionStats.hpp>
+#include <reflect/ShaderReflection.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+using nbl::ReflectionPhase;
+using nbl::ReflectionStats;
+
+namespace
+{
+    struct PipelineFiles
+    {
+        std::string vertexPath;
+        std::string fragmentPath;
+        uint64_t    vertexBytes   = 0;
+        uint64_t    fragmentBytes = 0;
+    };
+
+    auto writeModule(const std::string& path, const std::vector<uint32_t>& words) -> uint64_t
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+        return words.size() * sizeof(uint32_t);
+    }
+
+    auto writePipeline(const std::filesystem::path& directory) -> PipelineFiles
+    {
+        PipelineFiles files;
+        files.vertexPath    = (directory / "stats.vert.spv").string();
+        files.fragmentPath  = (directory / "stats.frag.spv").string();
+        files.vertexBytes   = writeModule(files.vertexPath, buildVertexModule().words);
+        files.fragmentBytes = writeModule(files.fragmentPath, buildFragmentModule().words);
+        return files;
+    }
+
+    auto reflectPipeline(const PipelineFiles& files) -> nbl::PipelineReflectionData
+    {
+        return nbl::ShaderReflection::reflectPipelineShaders({ files.vertexPath, files.fragmentPath }, nbl::ReflectionExecutionMode::eSerial,
+                                                             nullptr, nbl::ReflectionBackend::eFastScan);
+    }
+
+    auto countEvents(const std::vector<nbl::ReflectionEvent>& events, const ReflectionPhase phase, const std::string& source) -> size_t
+    {
+        return static_cast<size_t>(std::ranges::count_if(events, [&](const nbl::ReflectionEvent& event) {
+            return event.phase == phase && (source.empty() || event.source == source);
+        }));
+    }
+
+    auto contains(const std::string& text, const std::string& value) -> bool
+    {
+        return text.find(value) != std::string::npos;
+    }
+
+    uint64_t g_allocationCount = 0;
+
+#ifdef NBL_REFLECT_ENABLE_STATS
+    /**
+     * @note A fast-scan reflection of a small pipeline records every phase, the byte counts and one pipeline.
+     */
+    auto recorded(const PipelineFiles& files) -> int
+    {
+        size_t callbackEvents = 0;
+        ReflectionStats::reset();
+        ReflectionStats::setCallback([&](const nbl::ReflectionEvent&) { ++callbackEvents; });
+        // Every query counts as an allocation, so each event sees at least one
+        ReflectionStats::setAllocationCounter([] { return ++g_allocationCount; });
+        ReflectionStats::setEnabled(true);
+        const auto pipeline = reflectPipeline(files);
+        ReflectionStats::setEnabled(false);
+        ReflectionStats::setCallback(nullptr);
+        ReflectionStats::setAllocationCounter(nullptr);
+
+        const auto events = ReflectionStats::getEvents();
+        int failures = check(!events.empty() && callbackEvents == events.size() && ReflectionStats::getDroppedEvents() == 0, "events recorded");
+        for (const auto& [path, bytes] : { std::pair { files.vertexPath, files.vertexBytes }, std::pair { files.fragmentPath, files.fragmentBytes } })
+        {
+            const auto io = std::ranges::find_if(events, [&](const nbl::ReflectionEvent& event) { return event.phase == ReflectionPhase::eFileIO && event.source == path; });
+            failures += check(io != std::end(events) && io->bytes == bytes, path + " file I/O bytes");
+            failures += check(countEvents(events, ReflectionPhase::eReflectShader, path) == 1 && countEvents(events, ReflectionPhase::eModuleCreate, path) == 1
+                              && countEvents(events, ReflectionPhase::eFastScanResolve, path) == 1, path + " reflection phases");
+        }
+        failures += check(countEvents(events, ReflectionPhase::eMerge, {}) == 1, "merge phase");
+        failures += check(std::ranges::all_of(events, [](const nbl::ReflectionEvent& event) { return event.allocations > 0; }), "allocation counts");
+
+        const auto shaders = ReflectionStats::getShaderStats();
+        failures += check(shaders.size() == 2, "shader summaries");
+        for (const auto& shader : shaders)
+        {
+            const uint64_t bytes = shader.sourceFile == files.vertexPath ? files.vertexBytes : files.fragmentBytes;
+            failures += check(shader.reflections == 1 && shader.bytes == bytes && shader.totalNs > 0
+                              && shader.phaseNs[static_cast<size_t>(ReflectionPhase::eReflectShader)] > 0
+                              && shader.totalNs >= shader.phaseNs[static_cast<size_t>(ReflectionPhase::eReflectShader)], shader.sourceFile + " summary");
+        }
+
+        const auto pipelines = ReflectionStats::getPipelineStats();
+        failures += check(pipelines.size() == 1, "pipeline record");
+        if (pipelines.size() == 1)
+        {
+            const auto& stats = pipelines[0];
+            failures += check(stats.shaderFiles == std::vector { files.vertexPath, files.fragmentPath } && stats.bytes == files.vertexBytes + files.fragmentBytes,
+                              "pipeline shaders");
+            failures += check(stats.descriptorSets == pipeline.descriptorSets.size() && stats.pushConstantRanges == pipeline.pushConstants.size()
+                              && stats.conflicts == pipeline.conflicts.size() && stats.descriptorBindings > 0, "pipeline layout counts");
+            failures += check(stats.reflectNs >= shaders[0].totalNs && stats.reflectNs > 0, "pipeline reflection time");
+        }
+
+        std::ostringstream trace;
+        ReflectionStats::writeChromeTrace(trace);
+        failures += check(contains(trace.str(), "\"traceEvents\":[") && contains(trace.str(), "\"name\":\"fastScanResolve\"")
+                          && contains(trace.str(), "\"source\":\"" + files.vertexPath + "\""), "chrome trace");
+
+        std::ostringstream summary;
+        ReflectionStats::writeSummary(summary);
+        failures += check(contains(summary.str(), "\"shaders\": [") && contains(summary.str(), "\"reflections\": 1")
+                          && contains(summary.str(), "\"shaderFiles\": [\"" + files.vertexPath + "\", \"" + files.fragmentPath + "\"]"), "JSON summary");
+
+        ReflectionStats::reset();
+        failures += check(ReflectionStats::getEvents().empty() && ReflectionStats::getPipelineStats().empty(), "reset");
+        return failures;
+    }
+#endif
+
+    /**
+     * @note Switched off at runtime, or not compiled in at all.
+     */
+    auto notRecorded(const PipelineFiles& files) -> int
+    {
+        ReflectionStats::reset();
+#ifndef NBL_REFLECT_ENABLE_STATS
+        ReflectionStats::setEnabled(true);
+#endif
+        int failures = check(!ReflectionStats::isEnabled(), "stats disabled");
+        reflectPipeline(files);
+        ReflectionStats::setEnabled(false);
+
+        failures += check(ReflectionStats::getEvents().empty() && ReflectionStats::getShaderStats().empty(), "no events recorded");
+        failures += check(ReflectionStats::getPipelineStats().empty(), "no pipelines recorded");
+        return failures;
+    }
+}
+
+int main()
+{
+    const auto directory = std::filesystem::temp_directory_path() / "nbl_reflect_stats_test";
+    std::filesystem::create_directories(directory);
+
+    int failures = 0;
+    try
+    {
+        const PipelineFiles files = writePipeline(directory);
+#ifdef NBL_REFLECT_ENABLE_STATS
+        failures = recorded(files) + notRecorded(files);
+#else
+        failures = notRecorded(files);
+#endif
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::filesystem::remove_all(directory);
+#ifdef NBL_REFLECT_ENABLE_STATS
+    std::cout << "[Reflection Stats | Failures: " << failures << "]" << std::endl;
+#else
+    std::cout << "[Reflection Stats (disabled) | Failures: " << failures << "]" << std::endl;
+#endif
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <reflect/ReflectionHash.hpp>
+#include <reflect/ShaderReflectionCache.hpp>
+#include <reflect/ShaderReflectionSerializer.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+using nbl::ShaderReflectionSerializer;
+
+namespace
+{
+    // magic, version, payload size and payload hash
+    constexpr size_t kHeaderSize        = 24;
+    constexpr size_t kPayloadSizeOffset = 8;
+    constexpr size_t kPayloadHashOffset = 16;
+
+    auto buildShaderData() -> nbl::ShaderReflectionData
+    {
+        nbl::ShaderReflectionData shaderData;
+        shaderData.entryPoint  = "main";
+        shaderData.shaderStage = vk::ShaderStageFlagBits::eCompute;
+        shaderData.descriptorSets = { { 1, { vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+                                             vk::DescriptorSetLayoutBinding(3, vk::DescriptorType::eCombinedImageSampler, 8, vk::ShaderStageFlagBits::eCompute) } } };
+        shaderData.pushConstants  = { vk::PushConstantRange(vk::ShaderStageFlagBits::eCompute, 16, 48) };
+
+        nbl::ShaderReflectionBlockMember light { .name = "lights", .offset = 16, .size = 64, .arrayStride = 32, .arrayDims = { 2 } };
+        light.members = {
+            { .name = "position", .offset = 16, .size = 12 },
+            { .name = "transform", .offset = 32, .size = 16, .matrixStride = 8, .rowMajor = true },
+        };
+        shaderData.blocks = { {
+            .type     = nbl::ShaderBlockType::eStorageBuffer,
+            .name     = "scene",
+            .typeName = "Scene",
+            .set      = 1,
+            .binding  = 0,
+            .size     = 80,
+            .members  = { { .name = "count", .offset = 0, .size = 4 }, light, { .name = "indices", .offset = 80, .arrayStride = 4, .arrayDims = { 0 } } },
+        } };
+
+        shaderData.specConstants = { { .constantId = 7, .name = "kSamples", .type = nbl::SpecializationConstantType::eInt, .width = 32, .defaultValue = 4 } };
+        shaderData.workgroup = nbl::ShaderReflectionWorkgroup {
+            .localSize            = { 64, 1, 1 },
+            .localSizeConstantIds = { 7, ~0u, ~0u },
+            .sharedVariables      = { { .name = "tile", .size = 1024, .lengthConstantId = 7, .elementSize = 256 } },
+            .sharedMemorySize     = 1024,
+        };
+        return shaderData;
+    }
+
+    auto equal(const nbl::ShaderReflectionData& a, const nbl::ShaderReflectionData& b) -> bool
+    {
+        const auto sets = [](const nbl::ShaderReflectionData& data) {
+            std::vector<std::pair<uint32_t, std::vector<vk::DescriptorSetLayoutBinding>>> result;
+            for (const auto& descriptorSet : data.descriptorSets)
+            {
+                result.emplace_back(descriptorSet.set, descriptorSet.bindings);
+            }
+            return result;
+        };
+        return a.entryPoint == b.entryPoint && a.shaderStage == b.shaderStage && sets(a) == sets(b) && a.pushConstants == b.pushConstants
+            && a.vertexInput.has_value() == b.vertexInput.has_value() && a.blocks == b.blocks && a.specConstants == b.specConstants
+            && a.workgroup == b.workgroup;
+    }
+
+    /**
+     * @note Rewrites the header's payload size and hash, so the payload itself has to be rejected.
+     */
+    void reseal(std::vector<char>& record)
+    {
+        const uint64_t payloadSize = record.size() - kHeaderSize;
+        const uint64_t payloadHash = nbl::ReflectionHash::hashBytes(record.data() + kHeaderSize, payloadSize);
+        std::memcpy(record.data() + kPayloadSizeOffset, &payloadSize, sizeof(payloadSize));
+        std::memcpy(record.data() + kPayloadHashOffset, &payloadHash, sizeof(payloadHash));
+    }
+
+    auto rejects(const std::vector<char>& record) -> bool
+    {
+        nbl::ShaderReflectionData shaderData;
+        return !ShaderReflectionSerializer::deserialize(record, shaderData);
+    }
+
+    auto serializer() -> int
+    {
+        const auto shaderData = buildShaderData();
+        const auto record = ShaderReflectionSerializer::serialize(shaderData);
+
+        nbl::ShaderReflectionData restored;
+        int failures = check(ShaderReflectionSerializer::deserialize(record, restored), "record accepted");
+        failures += check(equal(shaderData, restored), "round trip");
+
+        auto wrongMagic = record;
+        wrongMagic[0] ^= 1;
+        failures += check(rejects(wrongMagic), "wrong magic rejected");
+
+        auto wrongVersion = record;
+        const uint32_t version = ShaderReflectionSerializer::kFormatVersion + 1;
+        std::memcpy(wrongVersion.data() + sizeof(uint32_t), &version, sizeof(version));
+        failures += check(rejects(wrongVersion), "wrong version rejected");
+
+        auto wrongHash = record;
+        wrongHash.back() ^= 1;
+        failures += check(rejects(wrongHash), "payload hash mismatch rejected");
+
+        failures += check(rejects({ record.begin(), record.begin() + kHeaderSize - 1 }), "truncated header rejected");
+        failures += check(rejects({ record.begin(), record.end() - 1 }), "truncated payload rejected");
+
+        // Consistent header, the payload ends in the middle of the records
+        bool truncatedAccepted = false;
+        for (size_t size = kHeaderSize; size < record.size(); ++size)
+        {
+            std::vector<char> truncated(record.begin(), record.begin() + size);
+            reseal(truncated);
+            truncatedAccepted |= !rejects(truncated);
+        }
+        failures += check(!truncatedAccepted, "truncated records rejected");
+
+        // The descriptor set count follows the entry point name and the stage
+        auto oversized = record;
+        const size_t countOffset = kHeaderSize + sizeof(uint32_t) + shaderData.entryPoint.size() + sizeof(uint32_t);
+        const uint32_t count = ~0u;
+        std::memcpy(oversized.data() + countOffset, &count, sizeof(count));
+        reseal(oversized);
+        failures += check(rejects(oversized), "oversized count rejected");
+
+        auto trailing = record;
+        trailing.push_back(0);
+        reseal(trailing);
+        failures += check(rejects(trailing), "trailing bytes rejected");
+
+        return failures;
+    }
+
+    auto persistedCache(const std::filesystem::path& directory) -> int
+    {
+        const auto shaderData = buildShaderData();
+        const uint64_t codeHash = 0x0123456789ABCDEFull;
+        const size_t codeSize = 4096;
+        {
+            nbl::ShaderReflectionCache cache(directory);
+            cache.store(codeHash, codeSize, shaderData);
+            cache.store(codeHash, codeSize, shaderData, shaderData.entryPoint);
+        }
+
+        nbl::ShaderReflectionCache reloaded(directory);
+        const auto first = reloaded.find(codeHash, codeSize);
+        int failures = check(first.has_value() && equal(shaderData, *first), "first entry point reloaded");
+        const auto named = reloaded.find(codeHash, codeSize, shaderData.entryPoint);
+        failures += check(named.has_value() && equal(shaderData, *named), "named entry point reloaded");
+        failures += check(!reloaded.find(codeHash, codeSize, "other").has_value(), "unknown entry point missed");
+        failures += check(!reloaded.find(codeHash, codeSize + 4).has_value(), "different code size missed");
+        failures += check(!reloaded.find(codeHash, codeSize, {}, nbl::ReflectionBackend::eFastScan).has_value(), "other backend missed");
+        failures += check(reloaded.getHitCount() == 2 && reloaded.getMissCount() == 3, "hit and miss counts");
+
+        // Both backends are kept side by side
+        {
+            auto fastScanData = shaderData;
+            fastScanData.pushConstants.clear();
+            reloaded.store(codeHash, codeSize, fastScanData, {}, nbl::ReflectionBackend::eFastScan);
+        }
+        nbl::ShaderReflectionCache backends(directory);
+        const auto fastScan = backends.find(codeHash, codeSize, {}, nbl::ReflectionBackend::eFastScan);
+        const auto spirvReflect = backends.find(codeHash, codeSize);
+        failures += check(fastScan.has_value() && fastScan->pushConstants.empty() && spirvReflect.has_value() && equal(shaderData, *spirvReflect),
+                          "entries kept per backend");
+
+        // A corrupt record is a miss, not an error
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            std::fstream file(entry.path(), std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(-1, std::ios::end);
+            file.put('\x7F');
+        }
+        nbl::ShaderReflectionCache corrupted(directory);
+        failures += check(!corrupted.find(codeHash, codeSize).has_value(), "corrupt record missed");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    const auto directory = std::filesystem::temp_directory_path() / "nblReflectSerializerTest";
+    std::filesystem::remove_all(directory);
+
+    int failures = 0;
+    try
+    {
+        failures = serializer() + persistedCache(directory);
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::filesystem::remove_all(directory);
+    std::cout << "[Serializer | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
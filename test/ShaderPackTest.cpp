@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <reflect/ShaderPack.hpp>
+#include <reflect/ShaderReflection.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+namespace
+{
+    template <typename Function>
+    auto throws(const Function& function) -> bool
+    {
+        try
+        {
+            function();
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    auto roundTrip() -> int
+    {
+        const auto vertex   = reflect(buildVertexModule());
+        const auto fragment = reflect(buildFragmentModule());
+        const auto compute  = reflect(buildComputeModule());
+
+        // Identical modules share a blob
+        nbl::ShaderPackWriter writer;
+        writer.add("shaders/vertex.spv", vertex);
+        writer.add("shaders/compute.spv", compute);
+        writer.add("shaders/fragment.spv", fragment);
+        writer.add("shaders/compute_copy.spv", compute);
+        const nbl::ShaderCode packCode = nbl::ShaderCode::fromBytes(writer.build());
+        const nbl::ShaderPack pack(packCode);
+        int failures = check(pack.getEntryCount() == 4 && pack.getBlobCount() == 3 && pack.getEntryName(0) == "shaders/compute.spv", "shader pack index");
+
+        const nbl::ShaderReflectionData packed = pack.reflectShader("shaders/compute_copy.spv");
+        const auto codeOffset = reinterpret_cast<uintptr_t>(packed.shaderCode.data()) - reinterpret_cast<uintptr_t>(packCode.data());
+        failures += check(packed.sourceFile == "shaders/compute_copy.spv" && packed.workgroup == compute.workgroup && packed.specConstants == compute.specConstants
+                          && std::ranges::equal(packed.shaderCode.words(), compute.shaderCode.words()) && codeOffset % nbl::ShaderPack::kBlobAlignment == 0,
+                          "shader pack entry");
+        failures += check(pack.getShaderCode("shaders/compute.spv").data() == packed.shaderCode.data() && !pack.contains("shaders/missing.spv"), "shader pack deduplication");
+        failures += check(pack.getCodeHash("shaders/compute.spv") == pack.getCodeHash("shaders/compute_copy.spv")
+                          && pack.getCodeHash("shaders/compute.spv") != pack.getCodeHash("shaders/vertex.spv"), "shader pack code hash");
+
+        const nbl::PipelineReflectionData packedPipeline = pack.reflectPipeline({ "shaders/vertex.spv", "shaders/fragment.spv" });
+        failures += check(packedPipeline.shaderData.size() == 2 && packedPipeline.descriptorSets.size() == 3, "shader pack pipeline");
+
+        return failures;
+    }
+
+    /**
+     * @note Entry points of one module share the code, each of them keeps its own reflection record.
+     */
+    auto entryPoints() -> int
+    {
+        const TestModule module = buildMultiEntryModule(0x00010300);
+        const auto reflected = nbl::ShaderReflection::reflectModule(nbl::ShaderCode::fromWords(std::vector(module.words)), module.name, nbl::ReflectionBackend::eFastScan);
+        if (reflected.size() != 2)
+        {
+            return check(false, "multi entry point module");
+        }
+
+        // Laid out like nblReflectPack, the plain name selects the first entry point
+        nbl::ShaderPackWriter writer;
+        writer.add("multi_entry.spv", reflected[0]);
+        for (const auto& entryPoint : reflected)
+        {
+            writer.add(nbl::ShaderPack::makeEntryName("multi_entry.spv", entryPoint.entryPoint), entryPoint);
+        }
+        writer.add("multi_entry_copy.spv#fsMain", reflected[1]);
+        int failures = check(writer.getEntryCount() == 4 && writer.getBlobCount() == 2 && writer.getCodeCount() == 1, "writer shares the code of entry points");
+
+        const nbl::ShaderPack pack(nbl::ShaderCode::fromBytes(writer.build()));
+        const auto vs = pack.reflectShader("multi_entry.spv#vsMain");
+        const auto fs = pack.reflectShader("multi_entry.spv#fsMain");
+        failures += check(pack.getBlobCount() == 2 && vs.shaderCode.data() == fs.shaderCode.data()
+                          && pack.getShaderCode("multi_entry_copy.spv#fsMain").data() == fs.shaderCode.data(), "entry points share one code blob");
+        failures += check(vs.entryPoint == "vsMain" && vs.shaderStage == vk::ShaderStageFlagBits::eVertex && vs.pushConstants.empty()
+                          && fs.entryPoint == "fsMain" && fs.shaderStage == vk::ShaderStageFlagBits::eFragment
+                          && fs.pushConstants == reflected[1].pushConstants, "entry points keep their own record");
+        failures += check(pack.reflectShader("multi_entry.spv").entryPoint == "vsMain", "plain name selects the first entry point");
+
+        const nbl::PipelineReflectionData pipeline = pack.reflectPipelineStages({
+            { .filePath = "multi_entry.spv" },
+            { .filePath = "multi_entry.spv", .entryPoint = "fsMain" },
+        });
+        failures += check(pipeline.shaderData.size() == 2 && pipeline.shaderData[1].entryPoint == "fsMain"
+                          && pipeline.descriptorSets.size() == 1 && pipeline.descriptorSets[0].bindings.size() == 2, "multi entry point pipeline");
+        failures += check(throws([&] { pack.reflectPipelineStages({ { .filePath = "multi_entry.spv", .entryPoint = "csMain" } }); }),
+                          "unknown packed entry point");
+
+        return failures;
+    }
+
+    auto invalidPacks() -> int
+    {
+        const auto vertex = reflect(buildVertexModule());
+
+        nbl::ShaderPackWriter writer;
+        writer.add("vertex.spv", vertex);
+        int failures = check(throws([&] { writer.add("vertex.spv", vertex); }), "duplicate entry name");
+
+        const std::vector<char> bytes = writer.build();
+        const nbl::ShaderPack pack(nbl::ShaderCode::fromBytes(bytes));
+        failures += check(throws([&] { pack.reflectShader("missing.spv"); }) && throws([&] { pack.getEntryName(1); }), "missing entry");
+
+        failures += check(throws([&] { nbl::ShaderPack(nbl::ShaderCode::fromBytes(std::span(bytes).first(16))); }), "truncated header");
+
+        std::vector<char> badMagic = bytes;
+        badMagic[0] = 0;
+        failures += check(throws([&] { nbl::ShaderPack(nbl::ShaderCode::fromBytes(badMagic)); }), "unknown magic");
+
+        // The header records the file size, a truncated pack is rejected when opened
+        failures += check(throws([&] { nbl::ShaderPack(nbl::ShaderCode::fromBytes(std::span(bytes).first(bytes.size() - 16))); }), "truncated pack");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    try
+    {
+        failures = roundTrip() + entryPoints() + invalidPacks();
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::cout << "[Shader Pack | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <reflect/ShaderReflection.hpp>
+#include <reflect/ShaderSpecialization.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+namespace
+{
+    template <typename Function>
+    auto throws(const Function& function) -> bool
+    {
+        try
+        {
+            function();
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    auto constants() -> int
+    {
+        const auto compute = reflect(buildComputeModule());
+        const auto& constants = compute.specConstants;
+        if (constants.size() != 5)
+        {
+            return check(false, "specialization constant count");
+        }
+
+        int failures = check(constants[0].constantId == 0 && constants[0].name == "exposure"
+                             && constants[0].type == nbl::SpecializationConstantType::eFloat && constants[0].defaultValue == 0x3fc00000, "float specialization constant");
+        failures += check(constants[1].type == nbl::SpecializationConstantType::eBool && constants[1].defaultValue == 1, "bool specialization constant");
+        failures += check(constants[2].type == nbl::SpecializationConstantType::eInt && constants[2].defaultValue == 0xfffffffe, "signed specialization constant");
+        failures += check(constants[3].constantId == 4 && constants[3].type == nbl::SpecializationConstantType::eUint
+                          && constants[3].width == 32 && constants[3].defaultValue == 8, "unsigned specialization constant");
+        failures += check(constants[4].constantId == 5 && constants[4].name.empty() && constants[4].defaultValue == 16, "unnamed workgroup size constant");
+
+        return failures;
+    }
+
+    auto specialization() -> int
+    {
+        const auto compute = reflect(buildComputeModule());
+
+        nbl::ShaderSpecialization specialization(compute);
+        const nbl::SpecializationKey defaultKey = specialization.getKey();
+        specialization.set("tileSize", 8).set("exposure", 1.5f);
+        int failures = check(specialization.getKey() == defaultKey && specialization.getSpecializationInfo().mapEntryCount == 0, "default values are not specialized");
+
+        specialization.set("useShadows", false).set("tileSize", 16u);
+        const vk::SpecializationInfo info = specialization.getSpecializationInfo();
+        failures += check(info.mapEntryCount == 2 && info.dataSize == 8 && info.pMapEntries[0].constantID == 2 && info.pMapEntries[0].size == 4
+                          && info.pMapEntries[1].constantID == 4 && info.pMapEntries[1].offset == 4, "specialization map entries");
+        failures += check(!(specialization.getKey() == defaultKey) && specialization.getValue("tileSize") == 16, "specialized key");
+        failures += check(specialization.getKey(0) != specialization.getKey(1), "stage index part of the key");
+
+        failures += check(throws([&] { specialization.set("tileSize", -1); }), "specialization value range check");
+        failures += check(throws([&] { specialization.set("bias", 1u << 31); }), "signed specialization value range check");
+        failures += check(throws([&] { specialization.set("missing", 1); }), "unknown constant name");
+
+        specialization.set(3u, -8);
+        failures += check(specialization.getValue(3u) == 0xfffffff8, "constant set by id");
+
+        specialization.reset();
+        failures += check(specialization.getKey() == defaultKey && specialization.getSpecializationInfo().mapEntryCount == 0, "reset restores the defaults");
+
+        return failures;
+    }
+
+    auto pipelineSpecialization() -> int
+    {
+        const auto pipeline = nbl::ShaderReflection::mergePipelineShaders({ reflect(buildComputeModule()) });
+
+        nbl::PipelineSpecialization specialization(pipeline);
+        const nbl::SpecializationKey defaultKey = specialization.getKey();
+        specialization.set("tileSize", 32u);
+        int failures = check(specialization.getStageCount() == 1 && specialization.getStage(0).getValue("tileSize") == 32, "named value applied to the stage");
+        failures += check(specialization.getSpecializationInfo(0).mapEntryCount == 1 && !(specialization.getKey() == defaultKey), "pipeline key");
+        failures += check(throws([&] { specialization.set("missing", 1); }), "constant declared by no stage");
+
+        specialization.reset();
+        failures += check(specialization.getKey() == defaultKey, "pipeline reset");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    try
+    {
+        failures = constants() + specialization() + pipelineSpecialization();
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::cout << "[Specialization | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
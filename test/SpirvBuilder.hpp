@@ -0,0 +1,268 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+namespace nbl::test
+{
+    /**
+     * Minimal SPIR-V assembler for generating test modules without an offline shader compiler.
+     * Instructions are collected per logical layout section and concatenated on build().
+     */
+    class SpirvBuilder
+    {
+    public:
+        enum Op : uint32_t
+        {
+            OpName                          = 5,
+            OpMemberName                    = 6,
+            OpMemoryModel                   = 14,
+            OpEntryPoint                    = 15,
+            OpExecutionMode                 = 16,
+            OpCapability                    = 17,
+            OpTypeVoid                      = 19,
+            OpTypeBool                      = 20,
+            OpTypeInt                       = 21,
+            OpTypeFloat                     = 22,
+            OpTypeVector                    = 23,
+            OpTypeMatrix                    = 24,
+            OpTypeImage                     = 25,
+            OpTypeSampler                   = 26,
+            OpTypeSampledImage              = 27,
+            OpTypeArray                     = 28,
+            OpTypeRuntimeArray              = 29,
+            OpTypeStruct                    = 30,
+            OpTypePointer                   = 32,
+            OpTypeFunction                  = 33,
+            OpConstantTrue                  = 41,
+            OpConstant                      = 43,
+            OpConstantComposite             = 44,
+            OpSpecConstantTrue              = 48,
+            OpSpecConstantFalse             = 49,
+            OpSpecConstant                  = 50,
+            OpSpecConstantComposite         = 51,
+            OpFunction                      = 54,
+            OpFunctionEnd                   = 56,
+            OpFunctionCall                  = 57,
+            OpVariable                      = 59,
+            OpLoad                          = 61,
+            OpAccessChain                   = 65,
+            OpDecorate                      = 71,
+            OpMemberDecorate                = 72,
+            OpLabel                         = 248,
+            OpReturn                        = 253,
+            OpExecutionModeId               = 331,
+            OpTypeAccelerationStructureKHR  = 5341,
+        };
+
+        enum ExecutionModel : uint32_t
+        {
+            Vertex                  = 0,
+            TessellationControl     = 1,
+            TessellationEvaluation  = 2,
+            Geometry                = 3,
+            Fragment                = 4,
+            GLCompute               = 5,
+            RayGenerationKHR        = 5313,
+            IntersectionKHR         = 5314,
+            AnyHitKHR               = 5315,
+            ClosestHitKHR           = 5316,
+            MissKHR                 = 5317,
+            CallableKHR             = 5318,
+            TaskEXT                 = 5364,
+            MeshEXT                 = 5365,
+        };
+
+        enum StorageClass : uint32_t
+        {
+            UniformConstant = 0,
+            Input           = 1,
+            Uniform         = 2,
+            Output          = 3,
+            Workgroup       = 4,
+            Private         = 6,
+            Function        = 7,
+            PushConstant    = 9,
+            StorageBuffer   = 12,
+        };
+
+        enum Decoration : uint32_t
+        {
+            SpecId          = 1,
+            Block           = 2,
+            BufferBlock     = 3,
+            RowMajor        = 4,
+            ColMajor        = 5,
+            ArrayStride     = 6,
+            MatrixStride    = 7,
+            BuiltIn         = 11,
+            Location        = 30,
+            Binding         = 33,
+            DescriptorSet   = 34,
+            Offset          = 35,
+        };
+
+        enum Dim : uint32_t
+        {
+            Dim1D           = 0,
+            Dim2D           = 1,
+            Dim3D           = 2,
+            DimCube         = 3,
+            DimBuffer       = 5,
+            DimSubpassData  = 6,
+        };
+
+        auto id() -> uint32_t { return m_bound++; }
+
+        void version(const uint32_t version)                        { m_version = version; }
+        void capability(const uint32_t capability)                  { emit(m_capabilities, OpCapability, { capability }); }
+        void memoryModel(const uint32_t addressing, const uint32_t memory) { emit(m_memoryModel, OpMemoryModel, { addressing, memory }); }
+
+        void entryPoint(const uint32_t model, const uint32_t function, const std::string_view name, const std::vector<uint32_t>& interface)
+        {
+            std::vector<uint32_t> operands = { model, function };
+            appendString(operands, name);
+            operands.insert(std::end(operands), std::begin(interface), std::end(interface));
+            emit(m_entryPoints, OpEntryPoint, operands);
+        }
+
+        void executionMode(const uint32_t function, const uint32_t mode, const std::vector<uint32_t>& literals = {})
+        {
+            std::vector<uint32_t> operands = { function, mode };
+            operands.insert(std::end(operands), std::begin(literals), std::end(literals));
+            emit(m_executionModes, OpExecutionMode, operands);
+        }
+
+        void executionModeId(const uint32_t function, const uint32_t mode, const std::vector<uint32_t>& ids)
+        {
+            std::vector<uint32_t> operands = { function, mode };
+            operands.insert(std::end(operands), std::begin(ids), std::end(ids));
+            emit(m_executionModes, OpExecutionModeId, operands);
+        }
+
+        void name(const uint32_t target, const std::string_view name)
+        {
+            std::vector<uint32_t> operands = { target };
+            appendString(operands, name);
+            emit(m_debug, OpName, operands);
+        }
+
+        void memberName(const uint32_t target, const uint32_t member, const std::string_view name)
+        {
+            std::vector<uint32_t> operands = { target, member };
+            appendString(operands, name);
+            emit(m_debug, OpMemberName, operands);
+        }
+
+        void decorate(const uint32_t target, const uint32_t decoration, const std::vector<uint32_t>& literals = {})
+        {
+            std::vector<uint32_t> operands = { target, decoration };
+            operands.insert(std::end(operands), std::begin(literals), std::end(literals));
+            emit(m_annotations, OpDecorate, operands);
+        }
+
+        void memberDecorate(const uint32_t target, const uint32_t member, const uint32_t decoration, const std::vector<uint32_t>& literals = {})
+        {
+            std::vector<uint32_t> operands = { target, member, decoration };
+            operands.insert(std::end(operands), std::begin(literals), std::end(literals));
+            emit(m_annotations, OpMemberDecorate, operands);
+        }
+
+        /**
+         * @note Emits a type, constant or variable declaration, the result id is allocated and returned.
+         */
+        auto declare(const uint32_t opcode, std::vector<uint32_t> operands = {}, const bool hasResultType = false) -> uint32_t
+        {
+            const uint32_t result = id();
+            operands.insert(std::begin(operands) + (hasResultType ? 1 : 0), result);
+            emit(m_declarations, opcode, operands);
+            return result;
+        }
+
+        auto typeVoid()                                                 -> uint32_t { return declare(OpTypeVoid); }
+        auto typeBool()                                                 -> uint32_t { return declare(OpTypeBool); }
+        auto typeInt(const uint32_t width, const uint32_t signedness)   -> uint32_t { return declare(OpTypeInt, { width, signedness }); }
+        auto typeFloat(const uint32_t width)                            -> uint32_t { return declare(OpTypeFloat, { width }); }
+        auto typeVector(const uint32_t component, const uint32_t count) -> uint32_t { return declare(OpTypeVector, { component, count }); }
+        auto typeMatrix(const uint32_t column, const uint32_t count)    -> uint32_t { return declare(OpTypeMatrix, { column, count }); }
+        auto typeArray(const uint32_t element, const uint32_t length)   -> uint32_t { return declare(OpTypeArray, { element, length }); }
+        auto typeRuntimeArray(const uint32_t element)                   -> uint32_t { return declare(OpTypeRuntimeArray, { element }); }
+        auto typeStruct(const std::vector<uint32_t>& members)           -> uint32_t { return declare(OpTypeStruct, members); }
+        auto typePointer(const uint32_t storageClass, const uint32_t type) -> uint32_t { return declare(OpTypePointer, { storageClass, type }); }
+        auto typeFunction(const uint32_t returnType)                    -> uint32_t { return declare(OpTypeFunction, { returnType }); }
+        auto typeSampler()                                              -> uint32_t { return declare(OpTypeSampler); }
+        auto typeSampledImage(const uint32_t image)                     -> uint32_t { return declare(OpTypeSampledImage, { image }); }
+        auto typeAccelerationStructure()                                -> uint32_t { return declare(OpTypeAccelerationStructureKHR); }
+
+        /**
+         * @param sampled 1 for images used with a sampler, 2 for storage images.
+         */
+        auto typeImage(const uint32_t sampledType, const uint32_t dim, const uint32_t sampled, const uint32_t format = 0) -> uint32_t
+        {
+            return declare(OpTypeImage, { sampledType, dim, 0, 0, 0, sampled, format });
+        }
+
+        auto constant(const uint32_t type, const uint32_t value)         -> uint32_t { return declare(OpConstant, { type, value }, true); }
+        auto specConstant(const uint32_t type, const uint32_t value)     -> uint32_t { return declare(OpSpecConstant, { type, value }, true); }
+        auto specConstantBool(const uint32_t type, const bool value)     -> uint32_t { return declare(value ? OpSpecConstantTrue : OpSpecConstantFalse, { type }, true); }
+
+        auto specConstantComposite(const uint32_t type, const std::vector<uint32_t>& constituents) -> uint32_t
+        {
+            std::vector<uint32_t> operands = { type };
+            operands.insert(std::end(operands), std::begin(constituents), std::end(constituents));
+            return declare(OpSpecConstantComposite, operands, true);
+        }
+
+        auto variable(const uint32_t pointerType, const uint32_t storageClass) -> uint32_t { return declare(OpVariable, { pointerType, storageClass }, true); }
+
+        /**
+         * @note Emits an empty function body: OpFunction, OpLabel, OpReturn, OpFunctionEnd.
+         */
+        void emptyFunction(const uint32_t function, const uint32_t voidType, const uint32_t functionType, const std::vector<uint32_t>& body = {})
+        {
+            emit(m_functions, OpFunction, { voidType, function, 0, functionType });
+            emit(m_functions, OpLabel, { id() });
+            m_functions.insert(std::end(m_functions), std::begin(body), std::end(body));
+            emit(m_functions, OpReturn, {});
+            emit(m_functions, OpFunctionEnd, {});
+        }
+
+        auto build() const -> std::vector<uint32_t>
+        {
+            std::vector<uint32_t> words = { 0x07230203, m_version, 0, m_bound, 0 };
+            for (const auto* section : { &m_capabilities, &m_memoryModel, &m_entryPoints, &m_executionModes, &m_debug, &m_annotations, &m_declarations, &m_functions })
+            {
+                words.insert(std::end(words), std::begin(*section), std::end(*section));
+            }
+            return words;
+        }
+
+        static void emit(std::vector<uint32_t>& section, const uint32_t opcode, const std::vector<uint32_t>& operands)
+        {
+            section.push_back(static_cast<uint32_t>(operands.size() + 1) << 16 | opcode);
+            section.insert(std::end(section), std::begin(operands), std::end(operands));
+        }
+
+    private:
+        static void appendString(std::vector<uint32_t>& operands, const std::string_view string)
+        {
+            std::vector<uint32_t> words(string.size() / 4 + 1, 0);
+            std::memcpy(words.data(), string.data(), string.size());
+            operands.insert(std::end(operands), std::begin(words), std::end(words));
+        }
+
+        uint32_t              m_bound   = 1;
+        uint32_t              m_version = 0x00010500;
+        std::vector<uint32_t> m_capabilities;
+        std::vector<uint32_t> m_memoryModel;
+        std::vector<uint32_t> m_entryPoints;
+        std::vector<uint32_t> m_executionModes;
+        std::vector<uint32_t> m_debug;
+        std::vector<uint32_t> m_annotations;
+        std::vector<uint32_t> m_declarations;
+        std::vector<uint32_t> m_functions;
+    };
+}
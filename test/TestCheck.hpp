@@ -0,0 +1,20 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+namespace nbl::test
+{
+    /**
+     * @return 1 and prints the check if the condition does not hold, 0 otherwise.
+     * @note Has no dependencies, so tests of the generated headers can use it without the reflection library.
+     */
+    inline auto check(const bool condition, const std::string& what) -> int
+    {
+        if (!condition)
+        {
+            std::cout << "\t-[Check failed: " << what << "]" << std::endl;
+        }
+        return condition ? 0 : 1;
+    }
+}
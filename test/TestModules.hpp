@@ -0,0 +1,282 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <reflect/ShaderReflection.hpp>
+#include "SpirvBuilder.hpp"
+#include "TestCheck.hpp"
+
+/**
+ * SPIR-V modules shared by the reflection tests, each exercises a different part of the scanner.
+ */
+namespace nbl::test
+{
+    struct TestModule
+    {
+        std::string           name;
+        std::vector<uint32_t> words;
+    };
+
+    struct CommonTypes
+    {
+        uint32_t voidType, functionType, intType, uintType, floatType, vec2, vec3, vec4, mat4, uvec4;
+    };
+
+    inline auto declareCommonTypes(SpirvBuilder& b) -> CommonTypes
+    {
+        CommonTypes t {};
+        b.capability(1);
+        b.memoryModel(0, 1);
+        t.voidType     = b.typeVoid();
+        t.functionType = b.typeFunction(t.voidType);
+        t.intType      = b.typeInt(32, 1);
+        t.uintType     = b.typeInt(32, 0);
+        t.floatType    = b.typeFloat(32);
+        t.vec2         = b.typeVector(t.floatType, 2);
+        t.vec3         = b.typeVector(t.floatType, 3);
+        t.vec4         = b.typeVector(t.floatType, 4);
+        t.mat4         = b.typeMatrix(t.vec4, 4);
+        t.uvec4        = b.typeVector(t.uintType, 4);
+        return t;
+    }
+
+    inline auto pushConstantBlock(SpirvBuilder& b, const CommonTypes& t, const uint32_t baseOffset) -> uint32_t
+    {
+        const uint32_t block = b.typeStruct({ t.mat4, t.vec4 });
+        b.decorate(block, SpirvBuilder::Block);
+        b.memberDecorate(block, 0, SpirvBuilder::Offset, { baseOffset });
+        b.memberDecorate(block, 0, SpirvBuilder::ColMajor);
+        b.memberDecorate(block, 0, SpirvBuilder::MatrixStride, { 16 });
+        b.memberDecorate(block, 1, SpirvBuilder::Offset, { baseOffset + 64 });
+        b.memberName(block, 0, "transform");
+        b.memberName(block, 1, "tint");
+        return b.variable(b.typePointer(SpirvBuilder::PushConstant, block), SpirvBuilder::PushConstant);
+    }
+
+    inline void bind(SpirvBuilder& b, const uint32_t variable, const uint32_t set, const uint32_t binding)
+    {
+        b.decorate(variable, SpirvBuilder::DescriptorSet, { set });
+        b.decorate(variable, SpirvBuilder::Binding, { binding });
+    }
+
+    inline auto buildVertexModule() -> TestModule
+    {
+        SpirvBuilder b;
+        const CommonTypes t = declareCommonTypes(b);
+
+        const uint32_t position = b.variable(b.typePointer(SpirvBuilder::Input, t.vec3), SpirvBuilder::Input);
+        const uint32_t uv       = b.variable(b.typePointer(SpirvBuilder::Input, t.vec2), SpirvBuilder::Input);
+        const uint32_t bones    = b.variable(b.typePointer(SpirvBuilder::Input, t.uvec4), SpirvBuilder::Input);
+        const uint32_t index    = b.variable(b.typePointer(SpirvBuilder::Input, t.intType), SpirvBuilder::Input);
+        b.decorate(position, SpirvBuilder::Location, { 0 });
+        b.decorate(uv, SpirvBuilder::Location, { 2 });
+        b.decorate(bones, SpirvBuilder::Location, { 1 });
+        b.decorate(index, SpirvBuilder::BuiltIn, { 42 });
+
+        const uint32_t camera = b.typeStruct({ t.mat4, t.vec4 });
+        b.decorate(camera, SpirvBuilder::Block);
+        b.memberDecorate(camera, 0, SpirvBuilder::Offset, { 0 });
+        b.memberDecorate(camera, 0, SpirvBuilder::ColMajor);
+        b.memberDecorate(camera, 0, SpirvBuilder::MatrixStride, { 16 });
+        b.memberDecorate(camera, 1, SpirvBuilder::Offset, { 64 });
+        b.name(camera, "Camera");
+        b.memberName(camera, 0, "viewProjection");
+        b.memberName(camera, 1, "position");
+        const uint32_t cameraVar = b.variable(b.typePointer(SpirvBuilder::Uniform, camera), SpirvBuilder::Uniform);
+        b.name(cameraVar, "camera");
+        bind(b, cameraVar, 0, 0);
+
+        const uint32_t pushConstants = pushConstantBlock(b, t, 0);
+
+        const uint32_t main = b.id();
+        b.entryPoint(SpirvBuilder::Vertex, main, "main", { position, uv, bones, index });
+        b.emptyFunction(main, t.voidType, t.functionType);
+        (void) pushConstants;
+
+        return { "vertex", b.build() };
+    }
+
+    inline auto buildFragmentModule() -> TestModule
+    {
+        SpirvBuilder b;
+        const CommonTypes t = declareCommonTypes(b);
+
+        const uint32_t image2D       = b.typeImage(t.floatType, SpirvBuilder::Dim2D, 1);
+        const uint32_t sampledImage  = b.typeSampledImage(image2D);
+        const uint32_t four          = b.constant(t.uintType, 4);
+        const uint32_t textures      = b.variable(b.typePointer(SpirvBuilder::UniformConstant, b.typeArray(sampledImage, four)), SpirvBuilder::UniformConstant);
+        const uint32_t sampler       = b.variable(b.typePointer(SpirvBuilder::UniformConstant, b.typeSampler()), SpirvBuilder::UniformConstant);
+        const uint32_t separate      = b.variable(b.typePointer(SpirvBuilder::UniformConstant, image2D), SpirvBuilder::UniformConstant);
+        const uint32_t subpassImage  = b.typeImage(t.floatType, SpirvBuilder::DimSubpassData, 2);
+        const uint32_t subpassInput  = b.variable(b.typePointer(SpirvBuilder::UniformConstant, subpassImage), SpirvBuilder::UniformConstant);
+
+        const uint32_t lights = b.typeRuntimeArray(t.vec4);
+        b.decorate(lights, SpirvBuilder::ArrayStride, { 16 });
+        const uint32_t lightBuffer = b.typeStruct({ t.uintType, lights });
+        b.decorate(lightBuffer, SpirvBuilder::Block);
+        b.memberDecorate(lightBuffer, 0, SpirvBuilder::Offset, { 0 });
+        b.memberDecorate(lightBuffer, 1, SpirvBuilder::Offset, { 16 });
+        b.memberName(lightBuffer, 0, "count");
+        b.memberName(lightBuffer, 1, "lights");
+        const uint32_t lightVar = b.variable(b.typePointer(SpirvBuilder::StorageBuffer, lightBuffer), SpirvBuilder::StorageBuffer);
+        b.name(lightVar, "lightBuffer");
+
+        bind(b, subpassInput, 2, 0);
+        bind(b, textures, 1, 0);
+        bind(b, sampler, 1, 1);
+        bind(b, separate, 1, 2);
+        bind(b, lightVar, 0, 3);
+
+        pushConstantBlock(b, t, 64);
+
+        const uint32_t color = b.variable(b.typePointer(SpirvBuilder::Output, t.vec4), SpirvBuilder::Output);
+        b.decorate(color, SpirvBuilder::Location, { 0 });
+
+        const uint32_t main = b.id();
+        b.entryPoint(SpirvBuilder::Fragment, main, "fragmentMain", { color });
+        b.executionMode(main, 7);
+        b.emptyFunction(main, t.voidType, t.functionType);
+
+        return { "fragment", b.build() };
+    }
+
+    inline auto buildComputeModule() -> TestModule
+    {
+        SpirvBuilder b;
+        const CommonTypes t = declareCommonTypes(b);
+
+        const uint32_t storageImage = b.variable(b.typePointer(SpirvBuilder::UniformConstant, b.typeImage(t.floatType, SpirvBuilder::Dim2D, 2, 1)), SpirvBuilder::UniformConstant);
+        const uint32_t storageTexel = b.variable(b.typePointer(SpirvBuilder::UniformConstant, b.typeImage(t.floatType, SpirvBuilder::DimBuffer, 2, 1)), SpirvBuilder::UniformConstant);
+        const uint32_t uniformTexel = b.variable(b.typePointer(SpirvBuilder::UniformConstant, b.typeImage(t.floatType, SpirvBuilder::DimBuffer, 1)), SpirvBuilder::UniformConstant);
+        const uint32_t bindless     = b.variable(b.typePointer(SpirvBuilder::UniformConstant, b.typeRuntimeArray(b.typeImage(t.floatType, SpirvBuilder::Dim2D, 1))), SpirvBuilder::UniformConstant);
+
+        const uint32_t data = b.typeRuntimeArray(t.uintType);
+        b.decorate(data, SpirvBuilder::ArrayStride, { 4 });
+        const uint32_t legacyBuffer = b.typeStruct({ data });
+        b.decorate(legacyBuffer, SpirvBuilder::BufferBlock);
+        b.memberDecorate(legacyBuffer, 0, SpirvBuilder::Offset, { 0 });
+        const uint32_t legacyVar = b.variable(b.typePointer(SpirvBuilder::Uniform, legacyBuffer), SpirvBuilder::Uniform);
+
+        bind(b, storageImage, 0, 0);
+        bind(b, storageTexel, 0, 1);
+        bind(b, uniformTexel, 0, 2);
+        bind(b, legacyVar, 0, 3);
+        bind(b, bindless, 3, 0);
+
+        const uint32_t tileSize = b.specConstant(t.uintType, 8);
+        b.decorate(tileSize, SpirvBuilder::SpecId, { 4 });
+        b.name(tileSize, "tileSize");
+        const uint32_t exposure = b.specConstant(t.floatType, 0x3fc00000);
+        b.decorate(exposure, SpirvBuilder::SpecId, { 0 });
+        b.name(exposure, "exposure");
+        const uint32_t useShadows = b.specConstantBool(b.typeBool(), true);
+        b.decorate(useShadows, SpirvBuilder::SpecId, { 2 });
+        b.name(useShadows, "useShadows");
+        const uint32_t bias = b.specConstant(t.intType, static_cast<uint32_t>(-2));
+        b.decorate(bias, SpirvBuilder::SpecId, { 3 });
+        b.name(bias, "bias");
+
+        // Workgroup size x from a specialization constant through the WorkgroupSize built-in, overriding LocalSize
+        const uint32_t groupSizeX = b.specConstant(t.uintType, 16);
+        b.decorate(groupSizeX, SpirvBuilder::SpecId, { 5 });
+        const uint32_t workgroupSize = b.specConstantComposite(b.typeVector(t.uintType, 3), { groupSizeX, b.constant(t.uintType, 4), b.constant(t.uintType, 1) });
+        b.decorate(workgroupSize, SpirvBuilder::BuiltIn, { 25 });
+
+        const uint32_t tile = b.variable(b.typePointer(SpirvBuilder::Workgroup, b.typeArray(t.floatType, tileSize)), SpirvBuilder::Workgroup);
+        b.name(tile, "tile");
+        const uint32_t points = b.variable(b.typePointer(SpirvBuilder::Workgroup, b.typeArray(t.vec3, b.constant(t.uintType, 4))), SpirvBuilder::Workgroup);
+        b.name(points, "points");
+
+        const uint32_t main = b.id();
+        b.entryPoint(SpirvBuilder::GLCompute, main, "main", { tile, points });
+        b.executionMode(main, 17, { 8, 8, 1 });
+        b.emptyFunction(main, t.voidType, t.functionType);
+
+        return { "compute", b.build() };
+    }
+
+    inline auto buildRayGenModule() -> TestModule
+    {
+        SpirvBuilder b;
+        b.capability(4479);
+        const CommonTypes t = declareCommonTypes(b);
+
+        const uint32_t tlas   = b.variable(b.typePointer(SpirvBuilder::UniformConstant, b.typeAccelerationStructure()), SpirvBuilder::UniformConstant);
+        const uint32_t output = b.variable(b.typePointer(SpirvBuilder::UniformConstant, b.typeImage(t.floatType, SpirvBuilder::Dim2D, 2, 2)), SpirvBuilder::UniformConstant);
+        bind(b, tlas, 0, 0);
+        bind(b, output, 0, 1);
+
+        const uint32_t main = b.id();
+        b.entryPoint(SpirvBuilder::RayGenerationKHR, main, "main", { tlas, output });
+        b.emptyFunction(main, t.voidType, t.functionType);
+
+        return { "raygen", b.build() };
+    }
+
+    /**
+     * @note Vertex and fragment entry points in one module, the vertex stage only reaches its uniform buffer through a call.
+     * Before SPIR-V 1.4 the interfaces only list inputs and outputs, usage is then found in the function bodies.
+     */
+    inline auto buildMultiEntryModule(const uint32_t version) -> TestModule
+    {
+        SpirvBuilder b;
+        b.version(version);
+        const CommonTypes t = declareCommonTypes(b);
+        const bool listsAllVariables = version >= 0x00010400;
+
+        const uint32_t position = b.variable(b.typePointer(SpirvBuilder::Input, t.vec3), SpirvBuilder::Input);
+        b.decorate(position, SpirvBuilder::Location, { 0 });
+
+        const uint32_t globalsType = b.typeStruct({ t.mat4 });
+        b.decorate(globalsType, SpirvBuilder::Block);
+        b.memberDecorate(globalsType, 0, SpirvBuilder::Offset, { 0 });
+        b.memberDecorate(globalsType, 0, SpirvBuilder::ColMajor);
+        b.memberDecorate(globalsType, 0, SpirvBuilder::MatrixStride, { 16 });
+        b.memberName(globalsType, 0, "viewProjection");
+        const uint32_t globals = b.variable(b.typePointer(SpirvBuilder::Uniform, globalsType), SpirvBuilder::Uniform);
+        b.name(globals, "globals");
+        bind(b, globals, 0, 0);
+
+        const uint32_t sampledImage = b.typeSampledImage(b.typeImage(t.floatType, SpirvBuilder::Dim2D, 1));
+        const uint32_t albedo = b.variable(b.typePointer(SpirvBuilder::UniformConstant, sampledImage), SpirvBuilder::UniformConstant);
+        b.name(albedo, "albedo");
+        bind(b, albedo, 0, 1);
+
+        const uint32_t materialType = b.typeStruct({ t.vec4 });
+        b.decorate(materialType, SpirvBuilder::Block);
+        b.memberDecorate(materialType, 0, SpirvBuilder::Offset, { 64 });
+        b.memberName(materialType, 0, "baseColor");
+        const uint32_t material = b.variable(b.typePointer(SpirvBuilder::PushConstant, materialType), SpirvBuilder::PushConstant);
+
+        const uint32_t vertexMain   = b.id();
+        const uint32_t fragmentMain = b.id();
+        const uint32_t transform    = b.id();
+        b.entryPoint(SpirvBuilder::Vertex, vertexMain, "vsMain", listsAllVariables ? std::vector { position, globals } : std::vector { position });
+        b.entryPoint(SpirvBuilder::Fragment, fragmentMain, "fsMain", listsAllVariables ? std::vector { albedo, material } : std::vector<uint32_t> {});
+
+        std::vector<uint32_t> vertexBody, fragmentBody, transformBody;
+        SpirvBuilder::emit(vertexBody, SpirvBuilder::OpFunctionCall, { t.voidType, b.id(), transform });
+        SpirvBuilder::emit(transformBody, SpirvBuilder::OpLoad, { globalsType, b.id(), globals });
+        SpirvBuilder::emit(fragmentBody, SpirvBuilder::OpLoad, { sampledImage, b.id(), albedo });
+        SpirvBuilder::emit(fragmentBody, SpirvBuilder::OpLoad, { materialType, b.id(), material });
+        b.emptyFunction(vertexMain, t.voidType, t.functionType, vertexBody);
+        b.emptyFunction(fragmentMain, t.voidType, t.functionType, fragmentBody);
+        b.emptyFunction(transform, t.voidType, t.functionType, transformBody);
+
+        return { listsAllVariables ? "multi_entry" : "multi_entry_1_3", b.build() };
+    }
+
+    /**
+     * @note Fast-scan reflection of test module code, independent of spirv-reflect.
+     */
+    inline auto reflect(std::vector<uint32_t> words, const std::string& name) -> ShaderReflectionData
+    {
+        return ShaderReflection::reflectShader(ShaderCode::fromWords(std::move(words)), name, ReflectionBackend::eFastScan);
+    }
+
+    inline auto reflect(const TestModule& module) -> ShaderReflectionData
+    {
+        return reflect(module.words, module.name);
+    }
+}
@@ -0,0 +1,180 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <reflect/ShaderReflection.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+using nbl::VertexInputLayout;
+using nbl::VertexInputStream;
+
+namespace
+{
+    /**
+     * @note Attributes as reflected from a typical mesh shader, 32-bit floats in location order.
+     */
+    auto buildVertexInput() -> nbl::ShaderReflectionVertexInput
+    {
+        nbl::ShaderReflectionVertexInput vertexInput;
+        vertexInput.attributeDescriptions = {
+            vk::VertexInputAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat),
+            vk::VertexInputAttributeDescription(1, 0, vk::Format::eR32G32B32A32Sfloat),
+            vk::VertexInputAttributeDescription(2, 0, vk::Format::eR32G32Sfloat),
+            vk::VertexInputAttributeDescription(3, 0, vk::Format::eR32G32B32Sfloat),
+        };
+        vertexInput.attributeNames = { "inPosition", "inColor", "inUV", "inNormal" };
+        return vertexInput;
+    }
+
+    auto offsets(const nbl::ShaderReflectionVertexInput& vertexInput) -> std::vector<uint32_t>
+    {
+        std::vector<uint32_t> result;
+        for (const auto& attribute : vertexInput.attributeDescriptions)
+        {
+            result.push_back(attribute.offset);
+        }
+        return result;
+    }
+
+    auto layouts() -> int
+    {
+        auto vertexInput = buildVertexInput();
+        vertexInput.applyLayout(VertexInputLayout::eInterleaved);
+        int failures = check(offsets(vertexInput) == std::vector<uint32_t> { 0, 12, 28, 36 }, "interleaved offsets");
+        failures += check(vertexInput.bindingDescriptions.size() == 1 && vertexInput.bindingDescriptions[0].stride == 48, "interleaved stride");
+
+        vertexInput.applyLayout(VertexInputLayout::eBindingPerAttribute);
+        failures += check(vertexInput.bindingDescriptions.size() == 4, "one binding per attribute");
+        for (uint32_t i = 0; i < vertexInput.attributeDescriptions.size() && vertexInput.bindingDescriptions.size() == 4; ++i)
+        {
+            const auto& attribute = vertexInput.attributeDescriptions[i];
+            const auto& binding   = vertexInput.bindingDescriptions[i];
+            failures += check(attribute.binding == i && attribute.offset == 0, "attribute #" + std::to_string(i) + " alone in its binding");
+            failures += check(binding.binding == i && binding.stride == nbl::ShaderReflectionVertexInput::getFormatSize(attribute.format)
+                              && binding.inputRate == vk::VertexInputRate::eVertex, "binding #" + std::to_string(i) + " stride");
+        }
+
+        // Position alone, normal and texture coordinates interleaved, per-instance color
+        const VertexInputStream streams[] = {
+            { .location = 0, .binding = 0 },
+            { .location = 3, .binding = 1 },
+            { .location = 2, .binding = 1 },
+            { .location = 1, .binding = 2, .inputRate = vk::VertexInputRate::eInstance },
+        };
+        vertexInput.applyLayout(VertexInputLayout::eCustom, streams);
+        failures += check(offsets(vertexInput) == std::vector<uint32_t> { 0, 0, 0, 8 }, "custom offsets in location order within a binding");
+        const auto& bindings = vertexInput.bindingDescriptions;
+        failures += check(bindings.size() == 3
+                          && bindings[0].stride == 12 && bindings[0].inputRate == vk::VertexInputRate::eVertex
+                          && bindings[1].stride == 20 && bindings[1].inputRate == vk::VertexInputRate::eVertex
+                          && bindings[2].stride == 16 && bindings[2].inputRate == vk::VertexInputRate::eInstance, "custom strides and input rates");
+
+        // 16-bit and 32-bit components, attributes aligned to their component size
+        nbl::ShaderReflectionVertexInput mixed;
+        mixed.attributeDescriptions = {
+            vk::VertexInputAttributeDescription(0, 0, vk::Format::eR16Sfloat),
+            vk::VertexInputAttributeDescription(1, 0, vk::Format::eR32Sfloat),
+            vk::VertexInputAttributeDescription(2, 0, vk::Format::eR16G16B16Sfloat),
+        };
+        const VertexInputStream mixedStreams[] = { { .location = 0, .binding = 4 }, { .location = 1, .binding = 4 }, { .location = 2, .binding = 4 } };
+        mixed.applyLayout(VertexInputLayout::eCustom, mixedStreams);
+        failures += check(offsets(mixed) == std::vector<uint32_t> { 0, 4, 8 }, "custom offsets aligned to the component size");
+        failures += check(mixed.bindingDescriptions.size() == 1 && mixed.bindingDescriptions[0].binding == 4
+                          && mixed.bindingDescriptions[0].stride == 16, "custom stride padded to the largest component");
+
+        return failures;
+    }
+
+    auto invalidLayouts() -> int
+    {
+        const auto rejects = [](const std::vector<VertexInputStream>& streams) {
+            auto vertexInput = buildVertexInput();
+            vertexInput.applyLayout(VertexInputLayout::eInterleaved);
+            const auto before = vertexInput.attributeDescriptions;
+            try
+            {
+                vertexInput.applyLayout(VertexInputLayout::eCustom, streams);
+            }
+            catch (const std::runtime_error&)
+            {
+                return vertexInput.attributeDescriptions == before && vertexInput.bindingDescriptions.size() == 1;
+            }
+            return false;
+        };
+
+        int failures = check(rejects({ { .location = 0 }, { .location = 1 }, { .location = 2 } }), "unmapped location rejected");
+        failures += check(rejects({}), "empty stream list rejected");
+        failures += check(rejects({ { .location = 0 }, { .location = 1 }, { .location = 2 }, { .location = 3 }, { .location = 3, .binding = 1 } }),
+                          "location mapped twice rejected");
+        failures += check(rejects({ { .location = 0 }, { .location = 1 }, { .location = 2 }, { .location = 3, .inputRate = vk::VertexInputRate::eInstance } }),
+                          "different input rates within a binding rejected");
+
+        // Streams for locations the shader does not declare are ignored
+        auto vertexInput = buildVertexInput();
+        const VertexInputStream extra[] = { { .location = 0 }, { .location = 1 }, { .location = 2 }, { .location = 3 }, { .location = 7, .binding = 5 } };
+        vertexInput.applyLayout(VertexInputLayout::eCustom, extra);
+        failures += check(vertexInput.bindingDescriptions.size() == 1, "unused stream ignored");
+
+        return failures;
+    }
+
+    auto packing() -> int
+    {
+        auto vertexInput = buildVertexInput();
+        vertexInput.applyLayout(VertexInputLayout::eInterleaved);
+        const auto report = vertexInput.suggestPacking();
+
+        const auto suggested = [&](const uint32_t location) {
+            for (const auto& suggestion : report.suggestions)
+            {
+                if (suggestion.location == location)
+                {
+                    return suggestion.suggestedFormat;
+                }
+            }
+            return vk::Format::eUndefined;
+        };
+
+        int failures = check(report.suggestions.size() == 3, "position keeps full precision");
+        failures += check(suggested(1) == vk::Format::eR8G8B8A8Unorm, "color packed to 8-bit unorm");
+        failures += check(suggested(2) == vk::Format::eR16G16Sfloat, "uv packed to half precision");
+        failures += check(suggested(3) == vk::Format::eR16G16B16A16Snorm, "normal packed to 16-bit snorm");
+        failures += check(report.suggestedOrder == std::vector<uint32_t> { 0, 2, 3, 1 }, "position first, then by decreasing alignment");
+        failures += check(report.currentStride == 48 && report.suggestedStride == 28, "strides before and after packing");
+
+        // Names are matched case insensitively, unknown names only get half precision
+        nbl::ShaderReflectionVertexInput named;
+        named.attributeDescriptions = {
+            vk::VertexInputAttributeDescription(0, 0, vk::Format::eR32G32Sfloat),
+            vk::VertexInputAttributeDescription(1, 0, vk::Format::eR32G32B32A32Sfloat),
+            vk::VertexInputAttributeDescription(2, 0, vk::Format::eR32G32B32A32Sfloat),
+        };
+        named.attributeNames = { "TEXCOORD0", "VertexColour", "" };
+        const auto namedReport = named.suggestPacking();
+        failures += check(namedReport.suggestions.size() == 3
+                          && namedReport.suggestions[0].suggestedFormat == vk::Format::eR16G16Sfloat
+                          && namedReport.suggestions[1].suggestedFormat == vk::Format::eR8G8B8A8Unorm
+                          && namedReport.suggestions[2].suggestedFormat == vk::Format::eR16G16B16A16Sfloat, "name matching");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    try
+    {
+        failures = layouts() + invalidLayouts() + packing();
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::cout << "[Vertex Input | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <reflect/ShaderReflection.hpp>
+#include <reflect/ShaderSpecialization.hpp>
+#include "TestModules.hpp"
+
+using namespace nbl::test;
+
+namespace
+{
+    /**
+     * @note Compute module whose size is only set by an execution mode, LocalSizeId if useConstants is set and LocalSize otherwise.
+     */
+    auto buildExecutionModeModule(const bool useConstants) -> std::vector<uint32_t>
+    {
+        SpirvBuilder b;
+        const CommonTypes t = declareCommonTypes(b);
+
+        const uint32_t main = b.id();
+        b.entryPoint(SpirvBuilder::GLCompute, main, "main", {});
+        if (useConstants)
+        {
+            const uint32_t sizeX = b.specConstant(t.uintType, 32);
+            b.decorate(sizeX, SpirvBuilder::SpecId, { 1 });
+            const uint32_t two = b.constant(t.uintType, 2);
+            const uint32_t one = b.constant(t.uintType, 1);
+            b.executionModeId(main, 38, { sizeX, two, one });
+        }
+        else
+        {
+            b.executionMode(main, 17, { 32, 2, 1 });
+        }
+        b.emptyFunction(main, t.voidType, t.functionType);
+        return b.build();
+    }
+
+    auto workgroupSize() -> int
+    {
+        const auto compute = reflect(buildComputeModule().words, "compute");
+        const auto& workgroup = compute.workgroup;
+        int failures = check(workgroup.has_value() && workgroup->localSize == std::array<uint32_t, 3> { 16, 4, 1 }
+                             && workgroup->localSizeConstantIds == std::array<uint32_t, 3> { 5, ~0u, ~0u }, "workgroup size built-in overrides LocalSize");
+
+        const auto fixed = reflect(buildExecutionModeModule(false), "local_size");
+        failures += check(fixed.workgroup.has_value() && fixed.workgroup->localSize == std::array<uint32_t, 3> { 32, 2, 1 }
+                          && fixed.workgroup->localSizeConstantIds == std::array<uint32_t, 3> { ~0u, ~0u, ~0u }, "LocalSize execution mode");
+
+        const auto constant = reflect(buildExecutionModeModule(true), "local_size_id");
+        failures += check(constant.workgroup.has_value() && constant.workgroup->localSize == std::array<uint32_t, 3> { 32, 2, 1 }
+                          && constant.workgroup->localSizeConstantIds == std::array<uint32_t, 3> { 1, ~0u, ~0u }, "LocalSizeId execution mode");
+
+        const auto vertex = reflect(buildVertexModule().words, "vertex");
+        failures += check(!vertex.workgroup.has_value(), "no workgroup for graphics stages");
+
+        return failures;
+    }
+
+    auto sharedMemory() -> int
+    {
+        const auto compute = reflect(buildComputeModule().words, "compute");
+        const auto& workgroup = compute.workgroup;
+        if (!workgroup.has_value())
+        {
+            return check(false, "compute workgroup");
+        }
+
+        int failures = check(workgroup->sharedVariables.size() == 2 && workgroup->sharedVariables[0].name == "tile"
+                             && workgroup->sharedVariables[0].lengthConstantId == 4 && workgroup->sharedVariables[0].elementSize == 4
+                             && workgroup->sharedVariables[0].size == 32, "shared array sized by a specialization constant");
+        failures += check(workgroup->sharedVariables.size() == 2 && workgroup->sharedVariables[1].size == 64
+                          && workgroup->sharedVariables[1].lengthConstantId == ~0u, "fixed size shared array");
+        failures += check(workgroup->sharedMemorySize == 96, "shared memory footprint");
+
+        return failures;
+    }
+
+    auto dispatchAndLimits() -> int
+    {
+        const auto compute = reflect(buildComputeModule().words, "compute");
+        const auto& workgroup = compute.workgroup;
+        if (!workgroup.has_value())
+        {
+            return check(false, "compute workgroup");
+        }
+
+        int failures = check(workgroup->getDispatchSize({ 1920, 1080, 1 }) == std::array<uint32_t, 3> { 120, 270, 1 }, "dispatch size");
+        failures += check(workgroup->getDispatchSize({ 17, 5, 1 }) == std::array<uint32_t, 3> { 2, 2, 1 }, "dispatch size rounded up");
+
+        nbl::ShaderSpecialization tuned(compute);
+        tuned.set(5u, 64u).set("tileSize", 4096u);
+        const nbl::ShaderReflectionWorkgroup specialized = workgroup->specialize(tuned);
+        failures += check(specialized.localSize[0] == 64 && specialized.getInvocationCount() == 256 && specialized.sharedMemorySize == 16448, "specialized workgroup");
+        failures += check(workgroup->checkLimits({}).empty(), "workgroup within the guaranteed limits");
+        failures += check(specialized.checkLimits({}).size() == 2 && specialized.checkLimits({}, std::array<uint32_t, 3> { 1u << 23, 1, 1 }).size() == 3,
+                          "workgroup limit violations");
+
+        const nbl::WorkgroupLimits large { .maxWorkgroupSize = { 1024, 1024, 64 }, .maxInvocations = 1024, .maxSharedMemorySize = 32768 };
+        failures += check(specialized.checkLimits(large).empty(), "specialized workgroup within larger limits");
+
+        return failures;
+    }
+}
+
+int main()
+{
+    int failures = 0;
+    try
+    {
+        failures = workgroupSize() + sharedMemory() + dispatchAndLimits();
+    }
+    catch (std::exception const& err)
+    {
+        std::cout << err.what() << std::endl;
+        failures = 1;
+    }
+
+    std::cout << "[Workgroup | Failures: " << failures << "]" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "SpirvBuilder.hpp"
+
+using nbl::test::SpirvBuilder;
+
+/**
+ * nblReflectWriteTestShaders <directory>
+ * Writes the SPIR-V modules nblReflectGeneratedHeaderTest is generated from, so the test does not need an offline shader compiler.
+ */
+namespace
+{
+    auto buildVertexShader() -> std::vector<uint32_t>
+    {
+        SpirvBuilder b;
+        b.capability(1);
+        b.memoryModel(0, 1);
+
+        const uint32_t voidType     = b.typeVoid();
+        const uint32_t functionType = b.typeFunction(voidType);
+        const uint32_t floatType    = b.typeFloat(32);
+        const uint32_t vec2         = b.typeVector(floatType, 2);
+        const uint32_t vec3         = b.typeVector(floatType, 3);
+        const uint32_t vec4         = b.typeVector(floatType, 4);
+        const uint32_t mat4         = b.typeMatrix(vec4, 4);
+
+        const uint32_t position = b.variable(b.typePointer(SpirvBuilder::Input, vec3), SpirvBuilder::Input);
+        b.name(position, "inPosition");
+        b.decorate(position, SpirvBuilder::Location, { 0 });
+        const uint32_t uv = b.variable(b.typePointer(SpirvBuilder::Input, vec2), SpirvBuilder::Input);
+        b.name(uv, "inUV");
+        b.decorate(uv, SpirvBuilder::Location, { 1 });
+
+        const uint32_t camera = b.typeStruct({ mat4 });
+        b.decorate(camera, SpirvBuilder::Block);
+        b.memberDecorate(camera, 0, SpirvBuilder::Offset, { 0 });
+        b.memberDecorate(camera, 0, SpirvBuilder::ColMajor);
+        b.memberDecorate(camera, 0, SpirvBuilder::MatrixStride, { 16 });
+        const uint32_t cameraBuffer = b.variable(b.typePointer(SpirvBuilder::Uniform, camera), SpirvBuilder::Uniform);
+        b.decorate(cameraBuffer, SpirvBuilder::DescriptorSet, { 0 });
+        b.decorate(cameraBuffer, SpirvBuilder::Binding, { 0 });
+
+        const uint32_t push = b.typeStruct({ vec4 });
+        b.decorate(push, SpirvBuilder::Block);
+        b.memberDecorate(push, 0, SpirvBuilder::Offset, { 0 });
+        b.variable(b.typePointer(SpirvBuilder::PushConstant, push), SpirvBuilder::PushConstant);
+
+        const uint32_t main = b.id();
+        b.entryPoint(SpirvBuilder::Vertex, main, "main", { position, uv });
+        b.emptyFunction(main, voidType, functionType);
+        return b.build();
+    }
+
+    auto buildFragmentShader() -> std::vector<uint32_t>
+    {
+        SpirvBuilder b;
+        b.capability(1);
+        b.memoryModel(0, 1);
+
+        const uint32_t voidType     = b.typeVoid();
+        const uint32_t functionType = b.typeFunction(voidType);
+        const uint32_t floatType    = b.typeFloat(32);
+
+        const uint32_t image   = b.typeSampledImage(b.typeImage(floatType, SpirvBuilder::Dim2D, 1));
+        const uint32_t texture = b.variable(b.typePointer(SpirvBuilder::UniformConstant, image), SpirvBuilder::UniformConstant);
+        b.decorate(texture, SpirvBuilder::DescriptorSet, { 1 });
+        b.decorate(texture, SpirvBuilder::Binding, { 0 });
+
+        const uint32_t main = b.id();
+        b.entryPoint(SpirvBuilder::Fragment, main, "main", {});
+        b.emptyFunction(main, voidType, functionType);
+        return b.build();
+    }
+
+    /**
+     * @note Both stages of the mesh pipeline as entry points of one SPIR-V 1.4 module.
+     */
+    auto buildMultiEntryShader() -> std::vector<uint32_t>
+    {
+        SpirvBuilder b;
+        b.version(0x00010400);
+        b.capability(1);
+        b.memoryModel(0, 1);
+
+        const uint32_t voidType     = b.typeVoid();
+        const uint32_t functionType = b.typeFunction(voidType);
+        const uint32_t floatType    = b.typeFloat(32);
+        const uint32_t vec3         = b.typeVector(floatType, 3);
+        const uint32_t vec4         = b.typeVector(floatType, 4);
+        const uint32_t mat4         = b.typeMatrix(vec4, 4);
+
+        const uint32_t position = b.variable(b.typePointer(SpirvBuilder::Input, vec3), SpirvBuilder::Input);
+        b.name(position, "inPosition");
+        b.decorate(position, SpirvBuilder::Location, { 0 });
+
+        const uint32_t camera = b.typeStruct({ mat4 });
+        b.decorate(camera, SpirvBuilder::Block);
+        b.memberDecorate(camera, 0, SpirvBuilder::Offset, { 0 });
+        b.memberDecorate(camera, 0, SpirvBuilder::ColMajor);
+        b.memberDecorate(camera, 0, SpirvBuilder::MatrixStride, { 16 });
+        const uint32_t cameraBuffer = b.variable(b.typePointer(SpirvBuilder::Uniform, camera), SpirvBuilder::Uniform);
+        b.decorate(cameraBuffer, SpirvBuilder::DescriptorSet, { 0 });
+        b.decorate(cameraBuffer, SpirvBuilder::Binding, { 0 });
+
+        const uint32_t image   = b.typeSampledImage(b.typeImage(floatType, SpirvBuilder::Dim2D, 1));
+        const uint32_t texture = b.variable(b.typePointer(SpirvBuilder::UniformConstant, image), SpirvBuilder::UniformConstant);
+        b.decorate(texture, SpirvBuilder::DescriptorSet, { 1 });
+        b.decorate(texture, SpirvBuilder::Binding, { 0 });
+
+        const uint32_t vertexMain   = b.id();
+        const uint32_t fragmentMain = b.id();
+        b.entryPoint(SpirvBuilder::Vertex, vertexMain, "vsMain", { position, cameraBuffer });
+        b.entryPoint(SpirvBuilder::Fragment, fragmentMain, "fsMain", { texture });
+        b.emptyFunction(vertexMain, voidType, functionType);
+        b.emptyFunction(fragmentMain, voidType, functionType);
+        return b.build();
+    }
+
+    void writeFile(const std::filesystem::path& path, const std::vector<uint32_t>& words)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file: " + path.string());
+        }
+        file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+    }
+}
+
+int main(const int argc, const char** argv)
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: nblReflectWriteTestShaders <directory>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        const std::filesystem::path directory = argv[1];
+        std::filesystem::create_directories(directory);
+        writeFile(directory / "mesh.vert.spv", buildVertexShader());
+        writeFile(directory / "mesh.frag.spv", buildFragmentShader());
+        writeFile(directory / "mesh.spv", buildMultiEntryShader());
+    }
+    catch (std::exception const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
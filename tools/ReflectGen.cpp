@@ -0,0 +1,307 @@
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <reflect/ShaderReflection.hpp>
+
+/**
+ * nblReflectGen --output <header> [--namespace <ns>] [--embed] [--fast-scan] --pipeline <Name>=<a.spv>[#entry],<b.spv>[#entry] [--pipeline ...]
+ * Reflects pipelines at build time and emits a header with constexpr tables, see nbl_reflect_generate in CMakeLists.txt.
+ * A stage without #entry uses the first entry point of its module.
+ */
+namespace
+{
+    struct PipelineSpec
+    {
+        std::string                         name;
+        std::vector<nbl::ShaderStageSource> stages;
+    };
+
+    struct Options
+    {
+        std::string                 output;
+        std::string                 nameSpace = "nbl::generated";
+        bool                        embed     = false;
+        nbl::ReflectionBackend      backend   = nbl::ReflectionBackend::eSpirvReflect;
+        std::vector<PipelineSpec>   pipelines;
+    };
+
+    auto toIdentifier(const std::string& name) -> std::string
+    {
+        std::string result;
+        for (const char c : name)
+        {
+            result += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+        }
+        if (result.empty() || std::isdigit(static_cast<unsigned char>(result.front())))
+        {
+            result.insert(std::begin(result), '_');
+        }
+        return result;
+    }
+
+    auto escape(const std::string& value) -> std::string
+    {
+        std::string result;
+        for (const char c : value)
+        {
+            if (c == '\\' || c == '"')
+            {
+                result += '\\';
+            }
+            result += c;
+        }
+        return result;
+    }
+
+    auto parseOptions(const int argc, const char** argv) -> Options
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const auto next = [&]() -> std::string {
+                if (i + 1 >= argc)
+                {
+                    throw std::runtime_error("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--output")          options.output    = next();
+            else if (arg == "--namespace")  options.nameSpace = next();
+            else if (arg == "--embed")      options.embed     = true;
+            else if (arg == "--fast-scan")  options.backend   = nbl::ReflectionBackend::eFastScan;
+            else if (arg == "--pipeline")
+            {
+                const std::string spec = next();
+                const size_t separator = spec.find('=');
+                if (separator == std::string::npos)
+                {
+                    throw std::runtime_error("Pipeline must be specified as <Name>=<a.spv>[#entry],<b.spv>[#entry]: " + spec);
+                }
+
+                PipelineSpec pipeline { spec.substr(0, separator), {} };
+                std::stringstream files(spec.substr(separator + 1));
+                for (std::string file; std::getline(files, file, ',');)
+                {
+                    const size_t entrySeparator = file.rfind('#');
+                    if (entrySeparator == std::string::npos)
+                    {
+                        pipeline.stages.push_back({ .filePath = file });
+                    }
+                    else
+                    {
+                        pipeline.stages.push_back({ .filePath = file.substr(0, entrySeparator), .entryPoint = file.substr(entrySeparator + 1) });
+                    }
+                }
+                options.pipelines.push_back(std::move(pipeline));
+            }
+            else
+            {
+                throw std::runtime_error("Unknown argument: " + arg);
+            }
+        }
+
+        if (options.output.empty() || options.pipelines.empty())
+        {
+            throw std::runtime_error("Usage: nblReflectGen --output <header> [--namespace <ns>] [--embed] [--fast-scan] --pipeline <Name>=<a.spv>[#entry],<b.spv>[#entry]");
+        }
+
+        // Every pipeline is emitted as a namespace, names mapping to the same identifier would redefine each other's tables
+        std::unordered_map<std::string, const std::string*> identifiers;
+        for (const auto& pipeline : options.pipelines)
+        {
+            const auto [it, inserted] = identifiers.try_emplace(toIdentifier(pipeline.name), &pipeline.name);
+            if (!inserted)
+            {
+                throw std::runtime_error("Pipelines \"" + *it->second + "\" and \"" + pipeline.name + "\" both map to namespace " + it->first);
+            }
+        }
+        return options;
+    }
+
+    void emitPipeline(std::ostream& out, const PipelineSpec& spec, const nbl::PipelineReflectionData& data, const bool embed)
+    {
+        out << "    namespace " << toIdentifier(spec.name) << "\n    {\n";
+
+        // Stages, entry points of one module share its embedded code
+        std::vector<size_t> codeStages(data.shaderData.size());
+        for (size_t s = 0; s < data.shaderData.size(); ++s)
+        {
+            const auto& shader = data.shaderData[s];
+            codeStages[s] = s;
+            for (size_t previous = 0; previous < s; ++previous)
+            {
+                if (data.shaderData[previous].shaderCode.data() == shader.shaderCode.data())
+                {
+                    codeStages[s] = codeStages[previous];
+                    break;
+                }
+            }
+            if (!embed || codeStages[s] != s)
+            {
+                continue;
+            }
+
+            const auto words = shader.shaderCode.words();
+            out << "        alignas(4) inline constexpr uint32_t stage" << s << "Code[] = {";
+            for (size_t w = 0; w < words.size(); ++w)
+            {
+                out << (w % 8 == 0 ? "\n            " : " ") << "0x" << std::hex << words[w] << std::dec << "u,";
+            }
+            out << "\n        };\n\n";
+        }
+
+        out << "        inline constexpr nbl::gen::ShaderStage stages[] = {\n";
+        for (size_t s = 0; s < data.shaderData.size(); ++s)
+        {
+            const auto& shader = data.shaderData[s];
+            out << "            { static_cast<vk::ShaderStageFlagBits>(0x" << std::hex << static_cast<uint32_t>(shader.shaderStage) << std::dec << "u), "
+                << "\"" << escape(shader.entryPoint) << "\", "
+                << (embed ? "stage" + std::to_string(codeStages[s]) + "Code" : std::string("{}")) << ", "
+                << "\"" << escape(shader.sourceFile) << "\" }, // " << vk::to_string(shader.shaderStage) << "\n";
+        }
+        out << "        };\n\n";
+
+        // Descriptor sets
+        for (const auto& descriptorSet : data.descriptorSets)
+        {
+            out << "        inline constexpr vk::DescriptorSetLayoutBinding set" << descriptorSet.set << "Bindings[] = {\n";
+            for (const auto& binding : descriptorSet.bindings)
+            {
+                out << "            vk::DescriptorSetLayoutBinding(" << binding.binding
+                    << ", static_cast<vk::DescriptorType>(" << static_cast<int32_t>(binding.descriptorType) << ")"
+                    << ", " << binding.descriptorCount
+                    << ", vk::ShaderStageFlags(0x" << std::hex << static_cast<uint32_t>(binding.stageFlags) << std::dec << "u)),"
+                    << " // " << vk::to_string(binding.descriptorType) << " " << vk::to_string(binding.stageFlags) << "\n";
+            }
+            out << "        };\n\n";
+        }
+
+        if (!data.descriptorSets.empty())
+        {
+            out << "        inline constexpr nbl::gen::DescriptorSet descriptorSets[] = {\n";
+            for (const auto& descriptorSet : data.descriptorSets)
+            {
+                out << "            { " << descriptorSet.set << ", set" << descriptorSet.set << "Bindings },\n";
+            }
+            out << "        };\n\n";
+        }
+
+        // Push constants
+        if (!data.pushConstants.empty())
+        {
+            out << "        inline constexpr vk::PushConstantRange pushConstants[] = {\n";
+            for (const auto& pushConstant : data.pushConstants)
+            {
+                out << "            vk::PushConstantRange(vk::ShaderStageFlags(0x" << std::hex << static_cast<uint32_t>(pushConstant.stageFlags) << std::dec << "u)"
+                    << ", " << pushConstant.offset << ", " << pushConstant.size << "), // " << vk::to_string(pushConstant.stageFlags) << "\n";
+            }
+            out << "        };\n\n";
+        }
+
+        // Vertex input
+        const nbl::ShaderReflectionVertexInput* vertexInput = nullptr;
+        for (const auto& shader : data.shaderData)
+        {
+            if (shader.vertexInput.has_value() && !shader.vertexInput->attributeDescriptions.empty())
+            {
+                vertexInput = &*shader.vertexInput;
+            }
+        }
+
+        if (vertexInput)
+        {
+            out << "        inline constexpr vk::VertexInputAttributeDescription vertexAttributes[] = {\n";
+            for (size_t i = 0; i < vertexInput->attributeDescriptions.size(); ++i)
+            {
+                const auto& attribute = vertexInput->attributeDescriptions[i];
+                out << "            vk::VertexInputAttributeDescription(" << attribute.location << ", " << attribute.binding
+                    << ", static_cast<vk::Format>(" << static_cast<int32_t>(attribute.format) << "), " << attribute.offset << "),"
+                    << " // " << vk::to_string(attribute.format);
+                if (i < vertexInput->attributeNames.size() && !vertexInput->attributeNames[i].empty())
+                {
+                    out << " " << vertexInput->attributeNames[i];
+                }
+                out << "\n";
+            }
+            out << "        };\n\n";
+
+            out << "        inline constexpr vk::VertexInputBindingDescription vertexBindings[] = {\n";
+            for (const auto& binding : vertexInput->bindingDescriptions)
+            {
+                out << "            vk::VertexInputBindingDescription(" << binding.binding << ", " << binding.stride
+                    << ", static_cast<vk::VertexInputRate>(" << static_cast<int32_t>(binding.inputRate) << ")),\n";
+            }
+            out << "        };\n\n";
+        }
+
+        out << "        inline constexpr nbl::gen::Pipeline pipeline {\n"
+            << "            .stages           = stages,\n"
+            << "            .descriptorSets   = " << (data.descriptorSets.empty() ? "{}" : "descriptorSets") << ",\n"
+            << "            .pushConstants    = " << (data.pushConstants.empty() ? "{}" : "pushConstants") << ",\n"
+            << "            .vertexAttributes = " << (vertexInput ? "vertexAttributes" : "{}") << ",\n"
+            << "            .vertexBindings   = " << (vertexInput ? "vertexBindings" : "{}") << ",\n"
+            << "        };\n";
+
+        out << "    }\n";
+    }
+}
+
+int main(const int argc, const char** argv)
+{
+    try
+    {
+        const Options options = parseOptions(argc, argv);
+
+        std::vector<std::vector<nbl::ShaderStageSource>> stages;
+        for (const auto& pipeline : options.pipelines)
+        {
+            stages.push_back(pipeline.stages);
+        }
+        const auto pipelines = nbl::ShaderReflection::reflectPipelineBatch(stages, nbl::ReflectionExecutionMode::eParallel, nullptr, options.backend);
+
+        std::ostringstream out;
+        out << "// Generated by nblReflectGen, do not edit.\n"
+            << "#pragma once\n\n"
+            << "#include <cstdint>\n"
+            << "#include <reflect/GeneratedReflection.hpp>\n\n"
+            << "namespace " << options.nameSpace << "\n{\n";
+
+        for (size_t p = 0; p < pipelines.size(); ++p)
+        {
+            for (const auto& conflict : pipelines[p].conflicts)
+            {
+                std::cerr << "warning: " << options.pipelines[p].name << ": set #" << conflict.set << " binding #" << conflict.binding
+                          << ": " << conflict.message << std::endl;
+            }
+
+            emitPipeline(out, options.pipelines[p], pipelines[p], options.embed);
+            if (p + 1 < pipelines.size())
+            {
+                out << "\n";
+            }
+        }
+        out << "}\n";
+
+        const std::string header = out.str();
+        std::ofstream file(options.output, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file: " + options.output);
+        }
+        file << header;
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <reflect/ShaderPack.hpp>
+#include <reflect/ShaderReflection.hpp>
+
+/**
+ * nblReflectPack --output <pack> [--root <dir>] [--fast-scan] <a.spv> [<b.spv> ...]
+ * nblReflectPack --list <pack>
+ * Reflects the shaders and writes them into a single ShaderPack. Entries are named by their path relative to the root
+ * (the working directory by default) with forward slashes, e.g. "post/bloom.comp.spv". Every entry point of a module gets
+ * its own entry, e.g. "post/bloom.spv#downsample", the plain name selects the module's first entry point.
+ */
+namespace
+{
+    struct Options
+    {
+        std::string                 output;
+        std::string                 list;
+        std::filesystem::path       root;
+        nbl::ReflectionBackend      backend = nbl::ReflectionBackend::eSpirvReflect;
+        std::vector<std::string>    files;
+    };
+
+    auto parseOptions(const int argc, const char** argv) -> Options
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const auto next = [&]() -> std::string {
+                if (i + 1 >= argc)
+                {
+                    throw std::runtime_error("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--output")          options.output  = next();
+            else if (arg == "--list")       options.list    = next();
+            else if (arg == "--root")       options.root    = next();
+            else if (arg == "--fast-scan")  options.backend = nbl::ReflectionBackend::eFastScan;
+            else if (arg.starts_with("--")) throw std::runtime_error("Unknown argument: " + arg);
+            else                            options.files.push_back(arg);
+        }
+
+        if (options.list.empty() && (options.output.empty() || options.files.empty()))
+        {
+            throw std::runtime_error("Usage: nblReflectPack --output <pack> [--root <dir>] [--fast-scan] <a.spv> [<b.spv> ...] | --list <pack>");
+        }
+        return options;
+    }
+
+    auto getEntryName(const std::filesystem::path& root, const std::string& file) -> std::string
+    {
+        const std::filesystem::path base = root.empty() ? std::filesystem::current_path() : std::filesystem::absolute(root);
+        const std::filesystem::path relative = std::filesystem::absolute(file).lexically_normal().lexically_relative(base.lexically_normal());
+        if (relative.empty() || *std::begin(relative) == "..")
+        {
+            throw std::runtime_error("Shader is not located below the pack root: " + file);
+        }
+        return relative.generic_string();
+    }
+
+    void listPack(const std::string& filePath)
+    {
+        const nbl::ShaderPack pack = nbl::ShaderPack::open(filePath);
+        for (size_t i = 0; i < pack.getEntryCount(); ++i)
+        {
+            const std::string_view name = pack.getEntryName(i);
+            std::cout << name << " (" << pack.getShaderCode(name).sizeInBytes() << " bytes)" << std::endl;
+        }
+        std::cout << pack.getEntryCount() << " entries, " << pack.getBlobCount() << " unique entry points" << std::endl;
+    }
+}
+
+int main(const int argc, const char** argv)
+{
+    try
+    {
+        const Options options = parseOptions(argc, argv);
+        if (!options.list.empty())
+        {
+            listPack(options.list);
+            return 0;
+        }
+
+        // Files are reflected in parallel, modules are packed once with a record per entry point
+        const auto modules = nbl::ShaderReflection::reflectModuleBatch(options.files, nbl::ReflectionExecutionMode::eParallel, options.backend);
+
+        nbl::ShaderPackWriter writer;
+        for (size_t i = 0; i < options.files.size(); ++i)
+        {
+            const std::string name = getEntryName(options.root, options.files[i]);
+            writer.add(name, modules[i].front());
+            for (const auto& entryPoint : modules[i])
+            {
+                writer.add(nbl::ShaderPack::makeEntryName(name, entryPoint.entryPoint), entryPoint);
+            }
+        }
+        writer.write(options.output);
+
+        std::cout << "Packed " << writer.getEntryCount() << " entries (" << writer.getBlobCount() << " entry points, "
+                  << writer.getCodeCount() << " unique modules) into " << options.output << std::endl;
+    }
+    catch (std::runtime_error const& err)
+    {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}